@@ -0,0 +1,422 @@
+/*! \file AppListModel.cpp
+    \brief A flat GtkTreeModel over a compact array of application records, loading icons on demand.
+
+    \date 2026-10-17
+    \version 1.0
+
+    \b Change_History:
+    \n (1) 2026-10-17 initial version.
+*/
+
+#include <string.h>
+
+#include "AppListModel.h"
+
+/*! \struct APP_LIST_ICON
+    \brief A cached icon and its place in the least recently used queue.
+*/
+typedef struct {
+  GdkPixbuf *icon;   /*!< NULL if the loader has no icon for the row. */
+  GList *link;       /*!< The link of icon_lru holding the row number. */
+} APP_LIST_ICON;
+
+static void app_list_model_tree_model_init(GtkTreeModelIface *iface);
+
+G_DEFINE_TYPE_WITH_CODE(AppListModel, app_list_model, G_TYPE_OBJECT,
+                        G_IMPLEMENT_INTERFACE(GTK_TYPE_TREE_MODEL, app_list_model_tree_model_init))
+
+//------------------------ Helper Functions
+/*! \fn static void free_list_icon(gpointer data)
+    \brief To release a cached icon.
+
+    \param[in] data. The APP_LIST_ICON object.
+*/
+static void free_list_icon(gpointer data)
+{
+  APP_LIST_ICON *entry = (APP_LIST_ICON*)data;
+
+  if(entry->icon)
+    g_object_unref(entry->icon);
+
+  g_free(entry);
+}
+
+/*! \fn static gboolean is_valid_iter(AppListModel *model, GtkTreeIter *iter)
+    \brief To check if an iterator points to a row of the model.
+
+    \param[in] model.
+    \param[in] iter.
+    \return TRUE or FALSE
+*/
+static gboolean is_valid_iter(AppListModel *model, GtkTreeIter *iter)
+{
+  return iter && iter->stamp == model->stamp && GPOINTER_TO_UINT(iter->user_data) < model->records->len;
+}
+
+/*! \fn static GdkPixbuf* get_row_icon(AppListModel *model, guint row)
+    \brief To get the icon of a row from the cache, loading it and evicting the least recently used icon on a miss.
+
+    \param[in] model.
+    \param[in] row.
+    \return PixelBuffer object owned by the cache, or NULL.
+*/
+static GdkPixbuf* get_row_icon(AppListModel *model, guint row)
+{
+  APP_LIST_ICON *entry = (APP_LIST_ICON*)g_hash_table_lookup(model->icons, GUINT_TO_POINTER(row));
+
+  if(entry)
+  {
+     /* Move it to the front. */
+     g_queue_unlink(model->icon_lru, entry->link);
+     g_queue_push_head_link(model->icon_lru, entry->link);
+
+     return entry->icon;
+  }
+
+  while( model->icon_lru->length >= model->icon_cache_size && model->icon_lru->length > 0 )
+    g_hash_table_remove( model->icons, g_queue_pop_tail(model->icon_lru) );
+
+  entry = g_new0(APP_LIST_ICON, 1);
+  entry->icon = model->loader ? model->loader( g_array_index(model->records, APP_LIST_RECORD, row).icon_name, model->loader_data ) : NULL;
+
+  g_queue_push_head(model->icon_lru, GUINT_TO_POINTER(row));
+  entry->link = model->icon_lru->head;
+  g_hash_table_insert(model->icons, GUINT_TO_POINTER(row), entry);
+
+  return entry->icon;
+}
+
+//------------------------ GtkTreeModel Interface
+static GtkTreeModelFlags app_list_model_get_flags(GtkTreeModel *tree_model)
+{
+  tree_model = tree_model;
+
+  return GTK_TREE_MODEL_LIST_ONLY;
+}
+
+static gint app_list_model_get_n_columns(GtkTreeModel *tree_model)
+{
+  tree_model = tree_model;
+
+  return APP_LIST_N_COLUMNS;
+}
+
+static GType app_list_model_get_column_type(GtkTreeModel *tree_model, gint index)
+{
+  tree_model = tree_model;
+
+  switch(index)
+  {
+    case APP_LIST_COLUMN_ICON:
+      return GDK_TYPE_PIXBUF;
+
+    case APP_LIST_COLUMN_TEXT:
+      return G_TYPE_STRING;
+
+    case APP_LIST_COLUMN_NODEDATA:
+    case APP_LIST_COLUMN_DIRDATA:
+      return G_TYPE_POINTER;
+  }
+
+  return G_TYPE_INVALID;
+}
+
+static gboolean app_list_model_get_iter(GtkTreeModel *tree_model, GtkTreeIter *iter, GtkTreePath *path)
+{
+  AppListModel *model = APP_LIST_MODEL(tree_model);
+  gint row = 0;
+
+  if( gtk_tree_path_get_depth(path) != 1 )
+    return FALSE;
+
+  row = gtk_tree_path_get_indices(path)[0];
+
+  if( row < 0 || (guint)row >= model->records->len )
+    return FALSE;
+
+  iter->stamp = model->stamp;
+  iter->user_data = GINT_TO_POINTER(row);
+
+  return TRUE;
+}
+
+static GtkTreePath* app_list_model_get_path(GtkTreeModel *tree_model, GtkTreeIter *iter)
+{
+  AppListModel *model = APP_LIST_MODEL(tree_model);
+
+  g_return_val_if_fail( is_valid_iter(model, iter), NULL );
+
+  return gtk_tree_path_new_from_indices( GPOINTER_TO_INT(iter->user_data), -1 );
+}
+
+static void app_list_model_get_value(GtkTreeModel *tree_model, GtkTreeIter *iter, gint column, GValue *value)
+{
+  AppListModel *model = APP_LIST_MODEL(tree_model);
+  APP_LIST_RECORD *record = NULL;
+
+  g_return_if_fail( is_valid_iter(model, iter) );
+
+  g_value_init( value, app_list_model_get_column_type(tree_model, column) );
+  record = &g_array_index(model->records, APP_LIST_RECORD, GPOINTER_TO_UINT(iter->user_data));
+
+  switch(column)
+  {
+    case APP_LIST_COLUMN_ICON:
+      g_value_set_object( value, get_row_icon(model, GPOINTER_TO_UINT(iter->user_data)) );
+      break;
+
+    case APP_LIST_COLUMN_TEXT:
+      g_value_set_string(value, record->text);
+      break;
+
+    case APP_LIST_COLUMN_NODEDATA:
+      g_value_set_pointer(value, record->node_data);
+      break;
+
+    case APP_LIST_COLUMN_DIRDATA:
+      g_value_set_pointer(value, NULL);
+      break;
+  }
+}
+
+static gboolean app_list_model_iter_next(GtkTreeModel *tree_model, GtkTreeIter *iter)
+{
+  AppListModel *model = APP_LIST_MODEL(tree_model);
+  guint row = GPOINTER_TO_UINT(iter->user_data) + 1;
+
+  if( iter->stamp != model->stamp || row >= model->records->len )
+  {
+     iter->stamp = 0;
+     return FALSE;
+  }
+
+  iter->user_data = GUINT_TO_POINTER(row);
+
+  return TRUE;
+}
+
+static gboolean app_list_model_iter_nth_child(GtkTreeModel *tree_model, GtkTreeIter *iter, GtkTreeIter *parent, gint n)
+{
+  AppListModel *model = APP_LIST_MODEL(tree_model);
+
+  /* Only the invisible root has children. */
+  if( parent || n < 0 || (guint)n >= model->records->len )
+    return FALSE;
+
+  iter->stamp = model->stamp;
+  iter->user_data = GINT_TO_POINTER(n);
+
+  return TRUE;
+}
+
+static gboolean app_list_model_iter_children(GtkTreeModel *tree_model, GtkTreeIter *iter, GtkTreeIter *parent)
+{
+  return app_list_model_iter_nth_child(tree_model, iter, parent, 0);
+}
+
+static gboolean app_list_model_iter_has_child(GtkTreeModel *tree_model, GtkTreeIter *iter)
+{
+  tree_model = tree_model;
+  iter = iter;
+
+  return FALSE;
+}
+
+static gint app_list_model_iter_n_children(GtkTreeModel *tree_model, GtkTreeIter *iter)
+{
+  AppListModel *model = APP_LIST_MODEL(tree_model);
+
+  return iter ? 0 : (gint)model->records->len;
+}
+
+static gboolean app_list_model_iter_parent(GtkTreeModel *tree_model, GtkTreeIter *iter, GtkTreeIter *child)
+{
+  tree_model = tree_model;
+  iter = iter;
+  child = child;
+
+  return FALSE;
+}
+
+static void app_list_model_tree_model_init(GtkTreeModelIface *iface)
+{
+  iface->get_flags = app_list_model_get_flags;
+  iface->get_n_columns = app_list_model_get_n_columns;
+  iface->get_column_type = app_list_model_get_column_type;
+  iface->get_iter = app_list_model_get_iter;
+  iface->get_path = app_list_model_get_path;
+  iface->get_value = app_list_model_get_value;
+  iface->iter_next = app_list_model_iter_next;
+  iface->iter_children = app_list_model_iter_children;
+  iface->iter_has_child = app_list_model_iter_has_child;
+  iface->iter_n_children = app_list_model_iter_n_children;
+  iface->iter_nth_child = app_list_model_iter_nth_child;
+  iface->iter_parent = app_list_model_iter_parent;
+}
+
+//------------------------ GObject
+static void app_list_model_init(AppListModel *model)
+{
+  model->records = g_array_new(FALSE, FALSE, sizeof(APP_LIST_RECORD));
+  model->stamp = g_random_int();
+  model->loader = NULL;
+  model->loader_data = NULL;
+  model->icon_cache_size = APP_LIST_ICON_CACHE_SIZE;
+  model->icon_lru = g_queue_new();
+  model->icons = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, free_list_icon);
+}
+
+static void app_list_model_finalize(GObject *object)
+{
+  AppListModel *model = APP_LIST_MODEL(object);
+
+  g_hash_table_destroy(model->icons);
+  g_queue_free(model->icon_lru);
+  g_array_free(model->records, TRUE);
+
+  G_OBJECT_CLASS(app_list_model_parent_class)->finalize(object);
+}
+
+static void app_list_model_class_init(AppListModelClass *klass)
+{
+  G_OBJECT_CLASS(klass)->finalize = app_list_model_finalize;
+}
+
+//------------------------ Public Functions
+/*! \fn AppListModel* app_list_model_new(AppListIconLoader loader, gpointer loader_data)
+    \brief To create an empty model.
+
+    \param[in] loader. The function loading the icon of a row.
+    \param[in] loader_data. The user data of loader.
+    \return The model. The caller owns the reference.
+*/
+AppListModel* app_list_model_new(AppListIconLoader loader, gpointer loader_data)
+{
+  AppListModel *model = APP_LIST_MODEL( g_object_new(APP_TYPE_LIST_MODEL, NULL) );
+
+  model->loader = loader;
+  model->loader_data = loader_data;
+
+  return model;
+}
+
+/*! \fn void app_list_model_append(AppListModel *model, const gchar *text, const gchar *icon_name, gpointer node_data)
+    \brief To append a row. Nothing is loaded until the row's icon is asked for.
+
+    \param[in] model.
+    \param[in] text. It must stay valid until the model is cleared.
+    \param[in] icon_name. It must stay valid until the model is cleared.
+    \param[in] node_data.
+*/
+void app_list_model_append(AppListModel *model, const gchar *text, const gchar *icon_name, gpointer node_data)
+{
+  APP_LIST_RECORD record;
+  GtkTreePath *path = NULL;
+  GtkTreeIter iter;
+
+  record.text = text;
+  record.icon_name = icon_name;
+  record.node_data = node_data;
+  g_array_append_val(model->records, record);
+
+  iter.stamp = model->stamp;
+  iter.user_data = GUINT_TO_POINTER(model->records->len - 1);
+
+  path = gtk_tree_path_new_from_indices(model->records->len - 1, -1);
+  gtk_tree_model_row_inserted(GTK_TREE_MODEL(model), path, &iter);
+  gtk_tree_path_free(path);
+}
+
+/*! \fn void app_list_model_clear(AppListModel *model)
+    \brief To remove all rows and drop the cached icons.
+
+    \param[in] model.
+*/
+void app_list_model_clear(AppListModel *model)
+{
+  GtkTreePath *path = NULL;
+
+  g_hash_table_remove_all(model->icons);
+  g_queue_clear(model->icon_lru);
+
+  /* Rows are removed from the end, so no other row changes its path. */
+  while(model->records->len > 0)
+  {
+     g_array_set_size(model->records, model->records->len - 1);
+
+     path = gtk_tree_path_new_from_indices(model->records->len, -1);
+     gtk_tree_model_row_deleted(GTK_TREE_MODEL(model), path);
+     gtk_tree_path_free(path);
+  }
+
+  /* Iterators of the old rows are invalid now. */
+  model->stamp++;
+}
+
+/*! \fn gint app_list_model_get_n_rows(AppListModel *model)
+    \brief To get the number of rows.
+
+    \param[in] model.
+    \return The number of rows.
+*/
+gint app_list_model_get_n_rows(AppListModel *model)
+{
+  return (gint)model->records->len;
+}
+
+/*! \fn gpointer app_list_model_get_node_data(AppListModel *model, gint row)
+    \brief To get the data pointer of a row.
+
+    \param[in] model.
+    \param[in] row.
+    \return The data pointer, or NULL if there has no such row.
+*/
+gpointer app_list_model_get_node_data(AppListModel *model, gint row)
+{
+  if( row < 0 || (guint)row >= model->records->len )
+    return NULL;
+
+  return g_array_index(model->records, APP_LIST_RECORD, row).node_data;
+}
+
+/*! \fn void app_list_model_set_icon_cache_size(AppListModel *model, guint size)
+    \brief To set how many icons the model keeps. It should be more than the rows of one screen.
+
+    \param[in] model.
+    \param[in] size.
+*/
+void app_list_model_set_icon_cache_size(AppListModel *model, guint size)
+{
+  model->icon_cache_size = MAX(size, 1);
+
+  while(model->icon_lru->length > model->icon_cache_size)
+    g_hash_table_remove( model->icons, g_queue_pop_tail(model->icon_lru) );
+}
+
+/*! \fn void app_list_model_get_icon_cache_stats(AppListModel *model, guint *n_icons, guint *capacity, gsize *pixel_bytes)
+    \brief To get the occupancy of the icon cache.
+
+    \param[in] model.
+    \param[out] n_icons. The cached rows, including the ones without icon.
+    \param[out] capacity. The icon cache size.
+    \param[out] pixel_bytes. The pixel data of the cached icons. An icon shared by several rows is counted once per row.
+*/
+void app_list_model_get_icon_cache_stats(AppListModel *model, guint *n_icons, guint *capacity, gsize *pixel_bytes)
+{
+  GHashTableIter iter;
+  gpointer value = NULL;
+
+  *n_icons = g_hash_table_size(model->icons);
+  *capacity = model->icon_cache_size;
+  *pixel_bytes = 0;
+
+  g_hash_table_iter_init(&iter, model->icons);
+
+  while( g_hash_table_iter_next(&iter, NULL, &value) )
+  {
+     GdkPixbuf *icon = ((APP_LIST_ICON*)value)->icon;
+
+     if(icon)
+       *pixel_bytes += (gsize)gdk_pixbuf_get_rowstride(icon) * gdk_pixbuf_get_height(icon);
+  }
+}
@@ -0,0 +1,87 @@
+/*! \file    AppListModel.h
+    \brief   A flat GtkTreeModel over a compact array of application records, loading icons on demand.
+
+    \date    2026-10-17
+    \version 1.0
+
+    \b Change_History:
+    \n 1) 2026-10-17 initialized.
+*/
+
+#ifndef __APPLISTMODEL_H
+#define __APPLISTMODEL_H
+
+#include <glib.h>
+#include <glib-object.h>
+#include <gtk/gtk.h>
+
+/*! \def APP_LIST_ICON_CACHE_SIZE
+    \brief The default number of icons kept by the model, a few screens of rows.
+*/
+#define APP_LIST_ICON_CACHE_SIZE  128
+
+/*! \enum  APP_LIST_COLUMN
+    \brief The columns of the model. They have the same order and types as the columns of the chooser's tree store,
+           so the same tree view column, filter and selection code work on both.
+*/
+enum APP_LIST_COLUMN {
+  APP_LIST_COLUMN_ICON = 0,   /*!< GdkPixbuf, loaded when it is asked for. */
+  APP_LIST_COLUMN_TEXT,       /*!< The application name. */
+  APP_LIST_COLUMN_NODEDATA,   /*!< The record's data pointer(APP_ITEM_INFO). */
+  APP_LIST_COLUMN_DIRDATA,    /*!< Always NULL, there has no category row. */
+  APP_LIST_N_COLUMNS
+};
+
+/*! \typedef AppListIconLoader
+    \brief Load the icon of a record. It is called by the GTK main thread.
+
+    \param[in] icon_name. The record's icon name.
+    \param[in] data. The user data given to app_list_model_new().
+    \return PixelBuffer object owned by the caller, or NULL.
+*/
+typedef GdkPixbuf* (*AppListIconLoader)(const gchar *icon_name, gpointer data);
+
+#define APP_TYPE_LIST_MODEL     (app_list_model_get_type())
+#define APP_LIST_MODEL(obj)     (G_TYPE_CHECK_INSTANCE_CAST((obj), APP_TYPE_LIST_MODEL, AppListModel))
+#define APP_IS_LIST_MODEL(obj)  (G_TYPE_CHECK_INSTANCE_TYPE((obj), APP_TYPE_LIST_MODEL))
+
+/*! \struct APP_LIST_RECORD
+    \brief One row. The strings are owned by the caller and must stay valid until the model is cleared.
+*/
+typedef struct {
+  const gchar *text;
+  const gchar *icon_name;
+  gpointer node_data;
+} APP_LIST_RECORD;
+
+/*! \struct AppListModel
+    \brief A list-only GtkTreeModel. A row holds no icon: get_value() loads it through the icon loader
+           and keeps it in a least recently used cache, so the number of live icons follows what the
+           tree view draws, not the number of rows.
+*/
+typedef struct _AppListModel {
+  GObject parent;
+
+  GArray *records;            /*!< APP_LIST_RECORD objects. */
+  gint stamp;                 /*!< Changes when the rows are cleared, so old iterators are invalid. */
+
+  AppListIconLoader loader;
+  gpointer loader_data;
+  guint icon_cache_size;
+  GQueue *icon_lru;           /*!< Row numbers of the cached icons, the most recently used first. */
+  GHashTable *icons;          /*!< Row number -> APP_LIST_ICON. */
+} AppListModel;
+
+typedef struct _AppListModelClass {
+  GObjectClass parent_class;
+} AppListModelClass;
+
+GType app_list_model_get_type(void);
+AppListModel* app_list_model_new(AppListIconLoader loader, gpointer loader_data);
+void app_list_model_append(AppListModel *model, const gchar *text, const gchar *icon_name, gpointer node_data);
+void app_list_model_clear(AppListModel *model);
+gint app_list_model_get_n_rows(AppListModel *model);
+gpointer app_list_model_get_node_data(AppListModel *model, gint row);
+void app_list_model_set_icon_cache_size(AppListModel *model, guint size);
+void app_list_model_get_icon_cache_stats(AppListModel *model, guint *n_icons, guint *capacity, gsize *pixel_bytes);
+#endif /* __APPLISTMODEL_H */
@@ -0,0 +1,4247 @@
+/*! \file CAppCatalog.cpp
+    \brief The applications catalog: the rows of the menu, their icons and everything loaded to build them.
+
+    \date 2026-10-17
+    \version 1.0
+
+    \b Change_History:
+    \n (1) 2026-10-17 initial version.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <glib/gi18n.h>  // For multi-language.
+
+#include "CAppCatalog.h"
+
+/*! \def DEFAULT_ICON_PATH
+    \brief The path to the default icon used when there has no icon for a chosen application.
+*/
+#define DEFAULT_ICON_PATH "./img/"
+
+/*! \def DEFAULT_ICON
+    \brief The full name of the default icon used when there has no icon for a chosen application.
+*/
+#define DEFAULT_ICON DEFAULT_ICON_PATH"none.png"
+
+/* The X desktop main application menu. */
+#define  APPLICATIONS_MENU       "applications.menu"
+#define  DEFAULT_APP_ICON        "application-x-executable"
+#define  DEFAULT_APP__MIME_ICON  "gnome-mime-application-x-executable"
+
+/*! \def IMG_SIZE
+    \brief The size of the icon shown in the tree-view. The unit is "pixel"
+*/
+#define IMG_SIZE 48
+
+/*! \def IMG_SIZE_SHOW
+    \brief The size of the icon chosen to be shown as the appearance of a menu item.
+    
+    It could be one of the values 16 / 22 / 24 / 32 pixels.
+*/
+#define IMG_SIZE_SHOW 32
+
+/*! \def ICON_RESULT_BATCH
+    \brief The maximum number of decoded icons applied to the tree store in one idle handler run.
+*/
+#define ICON_RESULT_BATCH 32
+
+/*! \def FREQUENT_CATEGORY_SIZE
+    \brief The most applications shown in the "Frequently used" category.
+*/
+#define FREQUENT_CATEGORY_SIZE 8
+#define FREQUENT_CATEGORY_ICON "document-open-recent"
+
+/* GNOME Menus keeps one tree per .menu file in a process-wide cache which it does not lock. The lookup of a loader
+   thread is serialized with the others, and no thread is started while another instance holds a tree. */
+static GMutex menuParseMutex;
+static guint nMenuTreeHolders = 0;
+
+/* The COLUMN_DIRDATA of the "Frequently used" category, which has no menu directory. */
+static gchar szFrequentCategory[] = "frequent";
+#define FREQUENT_CATEGORY_DATA  ((gpointer)szFrequentCategory)
+
+//------------------------ Callback Functions
+/*! \fn static gboolean replace_string(CAppItemArena &arena, gchar **field, const gchar *value)
+    \brief To replace a string member of a node-data item if the value has changed.
+           The caller releases the old string, see m_ReleaseAppString().
+
+    \param[in] arena. The arena holding the node-data strings.
+    \param[in,out] field.
+    \param[in] value.
+    \return TRUE if the member is replaced, FALSE if the value is the same.
+*/
+static gboolean replace_string(CAppItemArena &arena, gchar **field, const gchar *value)
+{
+  if( g_strcmp0(*field, value) == 0 )
+    return false;
+
+  *field = arena.m_InternString(value);
+
+  return true;
+}
+
+/*! \fn static gint cb_compare_rows(GtkTreeModel *model, GtkTreeIter *a, GtkTreeIter *b, gpointer data)
+    \brief The sort function of the tree store: categories before applications, then by name.
+           The "Frequently used" category comes first and keeps its applications in frecency order.
+
+    \param[in] model. The tree store.
+    \param[in] a. A row of the model.
+    \param[in] b. Another row of the model, with the same parent.
+    \param[in] data. The instance of class CAppCatalog owning the tree store.
+    \return Less than, equal to or greater than zero as a sorts before, with or after b.
+*/
+static gint cb_compare_rows(GtkTreeModel *model, GtkTreeIter *a, GtkTreeIter *b, gpointer data)
+{
+  gchar *nameA = NULL, *nameB = NULL;
+  gpointer nodeDataA = NULL, nodeDataB = NULL, dirDataA = NULL, dirDataB = NULL;
+  GtkTreeIter parent;
+  gint result = 0;
+
+  gtk_tree_model_get(model, a, COLUMN_TEXT, &nameA, COLUMN_NODEDATA, &nodeDataA, COLUMN_DIRDATA, &dirDataA, -1);
+  gtk_tree_model_get(model, b, COLUMN_TEXT, &nameB, COLUMN_NODEDATA, &nodeDataB, COLUMN_DIRDATA, &dirDataB, -1);
+
+  /* Applications are ordered by their category. */
+  if(nodeDataA && nodeDataB && gtk_tree_model_iter_parent(model, &parent, a))
+  {
+     gtk_tree_model_get(model, &parent, COLUMN_DIRDATA, &dirDataA, -1);
+     dirDataB = dirDataA;
+  }
+
+  /* A category has no node-data. */
+  if( (nodeDataA == NULL) != (nodeDataB == NULL) )
+    result = nodeDataA ? 1 : -1;
+  else if( (dirDataA == FREQUENT_CATEGORY_DATA) != (dirDataB == FREQUENT_CATEGORY_DATA) )
+    result = (dirDataA == FREQUENT_CATEGORY_DATA) ? -1 : 1;
+  else if(nodeDataA && dirDataA == FREQUENT_CATEGORY_DATA)
+  {
+     CAppCatalog *thisObject = (CAppCatalog*)data;
+     gdouble scoreA = thisObject->m_GetUsageScore( ((APP_ITEM_INFO*)nodeDataA)->desktopfile );
+     gdouble scoreB = thisObject->m_GetUsageScore( ((APP_ITEM_INFO*)nodeDataB)->desktopfile );
+
+     result = (scoreA > scoreB) ? -1 : (scoreA < scoreB) ? 1 : 0;
+  }
+  else if(!nameA || !nameB)
+    result = (nameA ? 1 : 0) - (nameB ? 1 : 0);
+  else
+    result = g_utf8_collate(nameA, nameB);
+
+  g_free(nameA);
+  g_free(nameB);
+
+  return result;
+}
+
+/*! \fn static GdkPixbuf* cb_load_list_icon(const gchar *icon_name, gpointer data)
+    \brief The icon loader of the flat list model, called for the rows the tree view draws.
+
+    \param[in] icon_name.
+    \param[in] data. The instance of class CAppCatalog.
+    \return PixelBuffer object owned by the caller.
+*/
+static GdkPixbuf* cb_load_list_icon(const gchar *icon_name, gpointer data)
+{
+  return ((CAppCatalog*)data)->m_LoadListIcon(icon_name);
+}
+
+/*! \fn static void cb_menu_tree_changed(GMenuTree *tree, gpointer user_data)
+    \brief The callback function called by GNOME Menus when the applications menu has changed.
+
+    \param[in] tree. The menu tree object.
+    \param[in] user_data. The instance of class CAppCatalog.
+*/
+static void cb_menu_tree_changed(GMenuTree *tree, gpointer user_data)
+{
+  tree = tree;
+
+  ((CAppCatalog*)user_data)->m_ReloadAppsMenuTree();
+}
+
+/*! \fn static gpointer cb_load_menu(gpointer data)
+    \brief The thread function parsing the applications menu.
+
+    \param[in] data. The instance of class CAppCatalog.
+    \return NULL
+*/
+static gpointer cb_load_menu(gpointer data)
+{
+  ((CAppCatalog*)data)->m_LoadMenuInThread();
+
+  return NULL;
+}
+
+/*! \fn static gboolean cb_add_loaded_menu_categories(gpointer data)
+    \brief The idle callback function adding the categories of the menu parsed by the menu loading thread.
+
+    \param[in] data. The instance of class CAppCatalog.
+    \return TRUE to be called again, FALSE to remove the idle handler.
+*/
+static gboolean cb_add_loaded_menu_categories(gpointer data)
+{
+  return ((CAppCatalog*)data)->m_AddLoadedMenuCategories();
+}
+
+/*! \fn static void free_icon_request(ICON_REQUEST *request)
+    \brief To release an icon decoding request.
+
+    \param[in] request.
+*/
+static void free_icon_request(ICON_REQUEST *request)
+{
+  g_free(request->name);
+  g_free(request->theme_file);
+  g_free(request->preview_file);
+  g_array_free(request->iters, TRUE);
+
+  if(request->icon)
+    g_object_unref(request->icon);
+
+  if(request->preview)
+    g_object_unref(request->preview);
+
+  g_slice_free(ICON_REQUEST, request);
+}
+
+/*! \fn static void free_icon_files(ICON_FILES *files)
+    \brief To release the resolved files of an icon name.
+
+    \param[in] files.
+*/
+static void free_icon_files(ICON_FILES *files)
+{
+  g_free(files->theme_file);
+  g_free(files->show_file);
+  g_slice_free(ICON_FILES, files);
+}
+
+/*! \fn static gchar* make_icon_key(const gchar *name, gint size)
+    \brief To build the key of an icon in the interning table. The same name at two sizes is two icons.
+
+    \param[in] name. The icon name.
+    \param[in] size.
+    \return Newly allocated string.
+*/
+static gchar* make_icon_key(const gchar *name, gint size)
+{
+  return g_strdup_printf("%d\n%s", size, name);
+}
+
+/*! \fn static void unref_interned_icon(gpointer data)
+    \brief To release an icon of the interning table. A NULL value records an icon that can not be loaded.
+
+    \param[in] data. The GdkPixbuf object or NULL.
+*/
+static void unref_interned_icon(gpointer data)
+{
+  if(data)
+    g_object_unref(data);
+}
+
+/*! \fn static void cb_decode_icon(gpointer data, gpointer user_data)
+    \brief The worker thread function of the icon decoding pipeline.
+
+    \param[in] data. The ICON_REQUEST object.
+    \param[in] user_data. The instance of class CAppCatalog.
+*/
+static void cb_decode_icon(gpointer data, gpointer user_data)
+{
+  ((CAppCatalog*)user_data)->m_ProcessIconRequest( (ICON_REQUEST*)data );
+}
+
+/*! \fn static gboolean cb_apply_icon_results(gpointer data)
+    \brief The idle callback function moving decoded icons into the tree store.
+
+    \param[in] data. The instance of class CAppCatalog.
+    \return TRUE to be called again, FALSE to remove the idle handler.
+*/
+static gboolean cb_apply_icon_results(gpointer data)
+{
+  return ((CAppCatalog*)data)->m_ApplyIconResults();
+}
+
+/*! \fn static gboolean cb_queue_deferred_icons(gpointer data)
+    \brief The low priority idle callback function queuing the deferred scalable icons to the worker threads.
+
+    \param[in] data. The instance of class CAppCatalog.
+    \return FALSE to remove the idle handler.
+*/
+static gboolean cb_queue_deferred_icons(gpointer data)
+{
+  return ((CAppCatalog*)data)->m_QueueDeferredIcons();
+}
+
+/*! \fn static gint cb_compare_icon_requests(gconstpointer a, gconstpointer b, gpointer data)
+    \brief The sort function of the worker threads' queue: the rasterization of scalable icons comes last.
+
+    \param[in] a. An ICON_REQUEST object.
+    \param[in] b. Another ICON_REQUEST object.
+    \param[in] data. Unused.
+    \return Less than, equal to or greater than zero as a is decoded before, with or after b.
+*/
+static gint cb_compare_icon_requests(gconstpointer a, gconstpointer b, gpointer data)
+{
+  data = data;
+
+  return (gint)((const ICON_REQUEST*)a)->rasterize - (gint)((const ICON_REQUEST*)b)->rasterize;
+}
+
+/*! \fn static void cb_icon_theme_changed(GtkIconTheme *theme, CAppCatalog *thisObject)
+    \brief The callback function of the default icon theme's "changed" signal, e.g. icons were installed.
+
+    \param[in] theme.
+    \param[in] thisObject. The instance of class CAppCatalog.
+*/
+static void cb_icon_theme_changed(GtkIconTheme *theme, CAppCatalog *thisObject)
+{
+  theme = theme;
+
+  thisObject->m_ExpireIconMisses();
+}
+
+/*! \fn static gboolean cb_is_icon_miss(gpointer key, gpointer value, gpointer data)
+    \brief The function of g_hash_table_foreach_remove() taking the icons which could not be loaded out of the
+           interning table.
+
+    \param[in] key.
+    \param[in] value. The GdkPixbuf object or NULL.
+    \param[in] data. Unused.
+    \return TRUE to remove the entry.
+*/
+static gboolean cb_is_icon_miss(gpointer key, gpointer value, gpointer data)
+{
+  key = key;
+  data = data;
+
+  return (value == NULL);
+}
+
+/*! \fn static gboolean is_scalable_icon_file(const gchar *file)
+    \brief To check if an image file is a scalable image(SVG) by its extension.
+
+    \param[in] file. It could be NULL.
+    \return TRUE or FALSE
+*/
+static gboolean is_scalable_icon_file(const gchar *file)
+{
+  return ( file && (g_str_has_suffix(file, EXT_NAME_SVG) || g_str_has_suffix(file, EXT_NAME_SVG "z")) );
+}
+
+/*! \fn static void fit_icon_size(int *width, int *height, int size)
+    \brief To scale an image's dimension so its longer side is "size", keeping the aspect ratio.
+
+    \param[in,out] width.
+    \param[in,out] height.
+    \param[in] size. The width(height) of the icon.
+*/
+static void fit_icon_size(int *width, int *height, int size)
+{
+  if( *height > *width )
+  {
+     *width = MAX(1, size * *width / *height);
+     *height = size;
+  }
+  else if( *height < *width )
+  {
+     *height = MAX(1, size * *height / *width);
+     *width = size;
+  }
+  else
+     *height = *width = size;
+}
+
+/*! \fn static void cb_icon_size_prepared(GdkPixbufLoader *loader, gint width, gint height, gpointer data)
+    \brief The callback function of the "size-prepared" signal: a scalable image(SVG) is rendered at the icon size.
+
+    A bitmap is decoded at its own size, the loader would scale it with the generic scaler afterwards anyway,
+    and scaled down by CIconScaler.
+
+    \param[in] loader.
+    \param[in] width. The width of the image file.
+    \param[in] height. The height of the image file.
+    \param[in] data. The width(height) of the icon.
+*/
+static void cb_icon_size_prepared(GdkPixbufLoader *loader, gint width, gint height, gpointer data)
+{
+  int size = GPOINTER_TO_INT(data);
+  GdkPixbufFormat *format = gdk_pixbuf_loader_get_format(loader);
+
+  if( format && gdk_pixbuf_format_is_scalable(format) && (width != size || height != size) )
+  {
+     fit_icon_size(&width, &height, size);
+     gdk_pixbuf_loader_set_size(loader, width, height);
+  }
+}
+
+/*! \fn static GdkPixbuf* scale_down_icon(GdkPixbuf *icon, int size)
+    \brief Scale down the icon if it's too big to be shown.
+
+    \param[in] icon. The icon, its reference is taken over.
+    \param[in] size. The width(height) of the icon.
+    \return PixelBuffer object or NULL.
+*/
+static GdkPixbuf* scale_down_icon(GdkPixbuf *icon, int size)
+{
+  if( G_LIKELY( icon ) )
+  {
+	int height = gdk_pixbuf_get_height(icon);
+    int width = gdk_pixbuf_get_width(icon);
+
+    /* Scale down the icon if it's too big to be shown. */
+    if(G_UNLIKELY( (height > size) || (width > size) ))
+    {
+      GdkPixbuf *scaled = NULL;
+
+      fit_icon_size(&width, &height, size);
+
+      /* The box filter kernels handle the 8 bits RGB(A) icons, the generic scaler anything else. */
+      scaled = CIconScaler::m_ScaleDown( icon, width, height );
+
+      if( !scaled )
+        scaled = gdk_pixbuf_scale_simple( icon, width, height, GDK_INTERP_BILINEAR );
+
+      g_object_unref( icon );
+      icon = scaled;
+    }
+  }
+
+  return icon;
+}
+
+/*! \fn static GdkPixbuf* load_theme_icon_file(const gchar *file, int size)
+    \brief To load an image file found in the icon theme. It does not touch GtkIconTheme, so it is safe in a worker thread.
+
+    A scalable image is rendered at the icon size, a bitmap bigger than the icon is scaled down to it,
+    a smaller one is kept at its own size.
+
+    \param[in] file. The full name of the image file.
+    \param[in] size. The width(height) of the icon.
+    \return PixelBuffer object or NULL.
+*/
+static GdkPixbuf* load_theme_icon_file(const gchar *file, int size)
+{
+  GMappedFile *mapped = g_mapped_file_new( file, FALSE, NULL );
+  GdkPixbufLoader *loader = NULL;
+  GdkPixbuf *icon = NULL;
+  gboolean bLoaded = FALSE;
+
+  if( !mapped )
+    return NULL;
+
+  if( g_mapped_file_get_length(mapped) > 0 )
+  {
+     loader = gdk_pixbuf_loader_new();
+     g_signal_connect(G_OBJECT(loader), "size-prepared", G_CALLBACK(cb_icon_size_prepared), GINT_TO_POINTER(size));
+
+     /* The loader has to be closed even if writing fails. */
+     bLoaded = gdk_pixbuf_loader_write( loader, (const guchar*)g_mapped_file_get_contents(mapped), g_mapped_file_get_length(mapped), NULL );
+     bLoaded = gdk_pixbuf_loader_close( loader, NULL ) && bLoaded;
+
+     if( bLoaded && gdk_pixbuf_loader_get_pixbuf(loader) )
+       icon = (GdkPixbuf*)g_object_ref( gdk_pixbuf_loader_get_pixbuf(loader) );
+
+     g_object_unref(loader);
+  }
+
+  g_mapped_file_unref(mapped);
+
+  return scale_down_icon(icon, size);
+}
+
+/*! \fn static GdkPixbuf* load_scaled_icon(const gchar *file_path, int size, gchar **source_file)
+    \brief To load an image file scaled to the given size.
+
+    \param[in] file_path. The full name of the image file.
+    \param[in] size. The width(height) of the icon.
+    \param[out] source_file. If not NULL and the file is loaded, it is set to a copy of file_path.
+    \return PixelBuffer object or NULL.
+*/
+static GdkPixbuf* load_scaled_icon(const gchar *file_path, int size, gchar **source_file)
+{
+  GdkPixbuf *icon = load_theme_icon_file( file_path, size );
+
+  /* Unlike a theme icon, a small image is scaled up to the icon size. */
+  if( icon && gdk_pixbuf_get_width(icon) < size && gdk_pixbuf_get_height(icon) < size )
+  {
+     int width = gdk_pixbuf_get_width(icon), height = gdk_pixbuf_get_height(icon);
+     GdkPixbuf *scaled = NULL;
+
+     fit_icon_size(&width, &height, size);
+     scaled = gdk_pixbuf_scale_simple( icon, width, height, GDK_INTERP_BILINEAR );
+     g_object_unref( icon );
+     icon = scaled;
+  }
+
+  if( icon && source_file )
+    *source_file = g_strdup( file_path );
+
+  return icon;
+}
+
+/*! \fn static gsize get_pixbuf_bytes(GdkPixbuf *pixbuf)
+    \brief To get the size of a pixel buffer's pixel data.
+
+    \param[in] pixbuf. It could be NULL.
+    \return The bytes.
+*/
+static gsize get_pixbuf_bytes(GdkPixbuf *pixbuf)
+{
+  return pixbuf ? (gsize)gdk_pixbuf_get_rowstride(pixbuf) * gdk_pixbuf_get_height(pixbuf) : 0;
+}
+
+/*! \fn static void count_tree_rows(GtkTreeModel *model, GtkTreeIter *parent, APPCHOOSER_MEMORY_STATS *stats)
+    \brief To count the rows under a row of the tree store, recursively.
+
+    \param[in] model.
+    \param[in] parent. NULL for the top-level rows.
+    \param[in,out] stats. The row counters.
+*/
+static void count_tree_rows(GtkTreeModel *model, GtkTreeIter *parent, APPCHOOSER_MEMORY_STATS *stats)
+{
+  GtkTreeIter iter;
+  gboolean bValid = gtk_tree_model_iter_children(model, &iter, parent);
+
+  for(; bValid; bValid = gtk_tree_model_iter_next(model, &iter))
+  {
+     gpointer nodeData = NULL, dirData = NULL;
+
+     gtk_tree_model_get(model, &iter, COLUMN_NODEDATA, &nodeData, COLUMN_DIRDATA, &dirData, -1);
+     stats->nRows++;
+
+     if(nodeData)
+       stats->nApplications++;
+     else if(dirData)
+       stats->nCategories++;
+
+     count_tree_rows(model, &iter, stats);
+  }
+}
+
+/*! \fn static void count_menu_items(GMenuTreeDirectory *dir, guint &nDirectories, guint &nEntries)
+    \brief To count the directories and entries of a menu directory, recursively.
+
+    \param[in] dir.
+    \param[in,out] nDirectories.
+    \param[in,out] nEntries.
+*/
+static void count_menu_items(GMenuTreeDirectory *dir, guint &nDirectories, guint &nEntries)
+{
+  GSList *items = gmenu_tree_directory_get_contents(dir), *item = NULL;
+
+  nDirectories++;
+
+  for(item = items; item; item = item->next)
+  {
+     GMenuTreeItemType type = gmenu_tree_item_get_type( (GMenuTreeItem*)item->data );
+
+     if( type == GMENU_TREE_ITEM_DIRECTORY )
+       count_menu_items( (GMenuTreeDirectory*)item->data, nDirectories, nEntries );
+     else if( type == GMENU_TREE_ITEM_ENTRY )
+       nEntries++;
+
+     gmenu_tree_item_unref(item->data);
+  }
+
+  g_slist_free(items);
+}
+
+/*! \fn static gboolean directory_has_contents(GMenuTreeDirectory *dir)
+    \brief To check if a menu directory has any item.
+
+    \param[in] dir.
+    \return TRUE or FALSE
+*/
+static gboolean directory_has_contents(GMenuTreeDirectory *dir)
+{
+  GSList *items = gmenu_tree_directory_get_contents(dir), *item = NULL;
+  gboolean bRet = (items != NULL);
+
+  /* The returned list and the references of its items belong to the caller. */
+  for(item = items; item; item = item->next)
+     gmenu_tree_item_unref(item->data);
+
+  g_slist_free(items);
+
+  return bRet;
+}
+
+/*! \fn static void collect_directory_entries(GMenuTreeDirectory *dir, GPtrArray *entries)
+    \brief To collect the shown entries of a directory and, recursively, of its sub-directories, in menu order.
+
+    \param[in] dir.
+    \param[out] entries. The GMenuTreeEntry objects. The caller owns a reference to each of them.
+*/
+static void collect_directory_entries(GMenuTreeDirectory *dir, GPtrArray *entries)
+{
+  GSList *itemList = gmenu_tree_directory_get_contents(dir), *item = NULL;
+
+  for(item = itemList; item; item = item->next)
+  {
+     GMenuTreeItemType type = gmenu_tree_item_get_type( (GMenuTreeItem*)item->data );
+
+     if( type == GMENU_TREE_ITEM_DIRECTORY )
+       collect_directory_entries( (GMenuTreeDirectory*)item->data, entries );
+     else if( type == GMENU_TREE_ITEM_ENTRY &&
+              !gmenu_tree_entry_get_is_nodisplay( (GMenuTreeEntry*)item->data ) &&
+              !gmenu_tree_entry_get_is_excluded( (GMenuTreeEntry*)item->data ) )
+     {
+        /* The list's reference is handed to the array. */
+        g_ptr_array_add(entries, item->data);
+        continue;
+     }
+
+     gmenu_tree_item_unref(item->data);
+  }
+
+  g_slist_free(itemList);
+}
+
+/*! \fn static void append_catalog_field(GString *out, const gchar *str)
+    \brief To append a tab and a field of a catalog daemon record, escaped like write_tsv_field().
+
+    \param[in] out.
+    \param[in] str. NULL is written as an empty field.
+*/
+static void append_catalog_field(GString *out, const gchar *str)
+{
+  g_string_append_c(out, '\t');
+
+  for(const gchar *p = str ? str : ""; *p; p++)
+  {
+     switch(*p)
+     {
+        case '\\': g_string_append(out, "\\\\"); break;
+        case '\n': g_string_append(out, "\\n"); break;
+        case '\r': g_string_append(out, "\\r"); break;
+        case '\t': g_string_append(out, "\\t"); break;
+        default:   g_string_append_c(out, *p);
+     }
+  }
+}
+
+/*! \fn static const gchar* catalog_field(const gchar *field)
+    \brief To get a field of a catalog daemon record, an empty field stands for NULL.
+
+    \param[in] field.
+    \return field or NULL.
+*/
+static const gchar* catalog_field(const gchar *field)
+{
+  return (field && *field) ? field : NULL;
+}
+
+/*! \fn static void free_iter_list(gpointer data)
+    \brief To release a list of copied tree iterators.
+
+    \param[in] data. The GSList object.
+*/
+static void free_iter_list(gpointer data)
+{
+  g_slist_free_full( (GSList*)data, (GDestroyNotify)gtk_tree_iter_free );
+}
+
+/*! \fn static void add_old_row(GHashTable *rows, const gchar *key, GtkTreeIter *iter)
+    \brief To add a row to a table of the rows before a reload. Rows with the same key are kept in their order.
+
+    \param[in] rows. Key -> list of copied tree iterators, see free_iter_list().
+    \param[in] key.
+    \param[in] iter.
+*/
+static void add_old_row(GHashTable *rows, const gchar *key, GtkTreeIter *iter)
+{
+  GSList *list = (GSList*)g_hash_table_lookup(rows, key);
+
+  /* Appending keeps the head of a list, so the hash table needs no update. */
+  if(list)
+    list = g_slist_append( list, gtk_tree_iter_copy(iter) );
+  else
+    g_hash_table_insert( rows, g_strdup(key), g_slist_append(NULL, gtk_tree_iter_copy(iter)) );
+}
+
+/*! \fn static gboolean take_old_row(GHashTable *rows, const gchar *key, GtkTreeIter *iter)
+    \brief To take the first row of a key out of a table of the rows before a reload.
+
+    \param[in] rows.
+    \param[in] key. It could be NULL.
+    \param[out] iter.
+    \return TRUE if a row is found.
+*/
+static gboolean take_old_row(GHashTable *rows, const gchar *key, GtkTreeIter *iter)
+{
+  GSList *list = key ? (GSList*)g_hash_table_lookup(rows, key) : NULL;
+
+  if(!list)
+    return false;
+
+  *iter = *(GtkTreeIter*)list->data;
+
+  if(!list->next)
+  {
+     g_hash_table_remove(rows, key);
+     return true;
+  }
+
+  /* The second row moves into the head, so the hash table keeps the same list. */
+  gtk_tree_iter_free( (GtkTreeIter*)list->data );
+  list->data = list->next->data;
+  list = g_slist_delete_link(list, list->next);
+
+  return true;
+}
+
+/*! \fn static GtkTreeStore* new_tree_store(void)
+    \brief To create an empty tree store. There has four fields:
+           { Pixel-Buffer, Text, GPointer(APP_ITEM_INFO), GPointer(GMenuTreeDirectory) }.
+
+    \param[in] NONE
+    \return The tree store owned by the caller.
+*/
+static GtkTreeStore* new_tree_store(void)
+{
+  return gtk_tree_store_new(NUM_COLS, GDK_TYPE_PIXBUF, G_TYPE_STRING, G_TYPE_POINTER, G_TYPE_POINTER);
+}
+
+/*! \fn static const gchar* directory_key(GMenuTreeDirectory *dir)
+    \brief To get the key a directory node is matched by when the menu is reloaded: its menu id, which does not
+           change with the translated name.
+
+    \param[in] dir.
+    \return The key owned by the directory, never NULL.
+*/
+static const gchar* directory_key(GMenuTreeDirectory *dir)
+{
+  const gchar *key = gmenu_tree_directory_get_menu_id(dir);
+
+  if(!key)
+    key = gmenu_tree_directory_get_name(dir);
+
+  return key ? key : "";
+}
+
+/*! \fn static gint get_next_position(GtkTreeModel *model, GtkTreeIter *prev)
+    \brief To get the position after a row among its siblings, where gtk_tree_store_insert_with_values() inserts.
+
+    \param[in] model.
+    \param[in] prev. NULL for the first position.
+    \return The position.
+*/
+static gint get_next_position(GtkTreeModel *model, GtkTreeIter *prev)
+{
+  GtkTreePath *path = NULL;
+  gint nPosition = 0;
+
+  if(!prev)
+    return 0;
+
+  path = gtk_tree_model_get_path(model, prev);
+  nPosition = gtk_tree_path_get_indices(path)[gtk_tree_path_get_depth(path) - 1] + 1;
+  gtk_tree_path_free(path);
+
+  return nPosition;
+}
+
+/*! \fn static gboolean catalog_depth(const gchar *field, guint *depth)
+    \brief To parse the depth field of a catalog daemon record.
+
+    \param[in] field.
+    \param[out] depth.
+    \return TRUE if the field is a depth.
+*/
+static gboolean catalog_depth(const gchar *field, guint *depth)
+{
+  gchar *end = NULL;
+  guint64 value = g_ascii_strtoull(field, &end, 10);
+
+  if( !*field || *end || value > G_MAXUINT16 )
+    return false;
+
+  *depth = (guint)value;
+
+  return true;
+}
+
+/*! \fn static void write_json_string(FILE *stream, const gchar *str)
+    \brief To write a string as a JSON string literal. A NULL string is written as an empty one.
+
+    \param[in] stream.
+    \param[in] str. UTF-8 string.
+*/
+static void write_json_string(FILE *stream, const gchar *str)
+{
+  fputc('"', stream);
+
+  for(const gchar *p = str ? str : ""; *p; p++)
+  {
+     switch(*p)
+     {
+        case '"':  fputs("\\\"", stream); break;
+        case '\\': fputs("\\\\", stream); break;
+        case '\n': fputs("\\n", stream); break;
+        case '\r': fputs("\\r", stream); break;
+        case '\t': fputs("\\t", stream); break;
+        default:
+          if( (guchar)*p < 0x20 )
+            fprintf(stream, "\\u%04x", (guchar)*p);
+          else
+            fputc(*p, stream);
+     }
+  }
+
+  fputc('"', stream);
+}
+
+/*! \fn static void write_tsv_field(FILE *stream, const gchar *str)
+    \brief To write a string as a TSV field. Backslash, tab and line breaks are escaped.
+
+    \param[in] stream.
+    \param[in] str. A NULL string is written as an empty field.
+*/
+static void write_tsv_field(FILE *stream, const gchar *str)
+{
+  for(const gchar *p = str ? str : ""; *p; p++)
+  {
+     switch(*p)
+     {
+        case '\\': fputs("\\\\", stream); break;
+        case '\n': fputs("\\n", stream); break;
+        case '\r': fputs("\\r", stream); break;
+        case '\t': fputs("\\t", stream); break;
+        default:   fputc(*p, stream);
+     }
+  }
+}
+
+//--------------- Class Methos Implementation.
+/*! \fn CAppCatalog::CAppCatalog()
+    \brief CAppCatalog constructor
+*/
+CAppCatalog::CAppCatalog()
+{
+  m_MenuTree = NULL;
+  m_RootDir = NULL;
+  m_bMenuTreeHeld = false;
+  m_TreeStore = NULL;
+  m_ListModel = NULL;
+  m_bMenuMonitored = false;
+  m_bMenuLoading = false;
+  m_MenuLoader = NULL;
+  m_nMenuIdleId = 0;
+  m_PendingMenuDirs = NULL;
+  m_bSnapshotStale = false;
+  m_nMenuLoadStart = 0;
+  m_bMenuFromSnapshot = false;
+  m_bMenuFromDaemon = false;
+  m_pPlaceholderIcon = NULL;
+  m_IconPool = NULL;
+  m_IconResults = NULL;
+  m_bIconPipelineCancelled = 0;
+  m_nIconIdleId = 0;
+  m_DeferredIcons = g_queue_new();
+  m_nDeferredIdleId = 0;
+  m_IconInternTable = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, unref_interned_icon);
+  m_nIconGeneration = 0;
+  m_nIconThemeHandler = 0;
+  m_IconPending = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+  m_IconFiles = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, (GDestroyNotify)free_icon_files);
+  m_nIconDecodes = 0;
+  m_nIconDecodesSaved = 0;
+  m_Views = NULL;
+  m_ExecTemplates = g_hash_table_new(g_direct_hash, g_direct_equal);
+
+  m_Options.lazy_load = false;
+  m_Options.sort_by_name = false;
+  m_Options.flat_list = false;
+  m_Options.async_menu_load = true;
+  m_Options.menu_snapshot = true;
+  m_Options.catalog_daemon = false;
+  m_Options.async_icon_load = true;
+  m_Options.defer_scalable_icons = true;
+  m_Options.usage_log = true;
+}
+
+/*! \fn CAppCatalog::~CAppCatalog()
+    \brief CAppCatalog destructor
+*/
+CAppCatalog::~CAppCatalog()
+{
+  m_StopMenuLoader();
+  m_StopIconPipeline();
+
+  g_hash_table_destroy(m_IconPending);
+  g_queue_free(m_DeferredIcons);
+  g_hash_table_destroy(m_IconInternTable);
+  g_hash_table_destroy(m_IconFiles);
+  g_hash_table_destroy(m_ExecTemplates);
+
+  for(GSList *view = m_Views; view; view = view->next)
+    g_free(view->data);
+
+  g_slist_free(m_Views);
+}
+
+/*! \fn void CAppCatalog::m_CreateInitValue(void)
+    \brief To build the rows, load the icons and follow the applications menu, as set by the options.
+
+    \param[in] NONE
+    \return NONE
+*/
+void CAppCatalog::m_CreateInitValue(void)
+{
+  /* An icon which could not be found may come with the next icon theme change. */
+  m_nIconThemeHandler = g_signal_connect( G_OBJECT(gtk_icon_theme_get_default()), "changed", G_CALLBACK(cb_icon_theme_changed), this );
+
+  /* To create the tree-store model. There has four fields: 
+         { Pixel-Buffer, Text, GPointer(APP_ITEM_INFO), GPointer(GMenuTreeDirectory) }.
+  */
+  if(!m_Options.flat_list)
+    m_TreeStore = new_tree_store();
+  else
+    m_ListModel = app_list_model_new(cb_load_list_icon, this);  // The same columns, only the applications, icons are loaded when they are drawn.
+
+  /* To open the on-disk icon cache. The icon theme name is a part of the cache key,
+     so switching the theme never shows the previous theme's icons. */
+  {
+     gchar *themeName = NULL;
+
+     g_object_get( gtk_settings_get_default(), "gtk-icon-theme-name", &themeName, NULL );
+     m_IconCache.m_Init(themeName);
+
+     /* The snapshot keeps the icon files found in this theme. */
+     if(m_Options.menu_snapshot)
+       m_MenuSnapshot.m_Init(APPLICATIONS_MENU, themeName, IMG_SIZE, IMG_SIZE_SHOW);
+
+     g_free(themeName);
+  }
+
+  /* To start the worker threads decoding icons while the menu tree is being walked. */
+  if(m_Options.async_icon_load && !m_Options.flat_list)
+    m_StartIconPipeline();
+
+  if(m_Options.usage_log)
+    m_UsageLog.m_Open();
+
+  /* To fill tree store(model) by reading Desktop Menu(.menu) file. */
+  m_LoadAndBuildAppsMenuTree();
+}
+
+/*! \fn void CAppCatalog::m_DeinitValue(void)
+    \brief To release the rows, the icons and the menu snapshot. The views must have dropped the model.
+
+    \param[in] NONE
+    \return NONE
+*/
+void CAppCatalog::m_DeinitValue(void)
+{
+  /* No loaded category, no decoded icon and no menu change may reach the tree store after this point. */
+  m_StopMenuLoader();
+  m_StopIconPipeline();
+  m_RemoveMenuMonitor();
+
+  if(m_nIconThemeHandler)
+    g_signal_handler_disconnect( G_OBJECT(gtk_icon_theme_get_default()), m_nIconThemeHandler );
+
+  m_nIconThemeHandler = 0;
+
+  /* The rows hold their own references to the shared icons. */
+  g_hash_table_remove_all(m_IconInternTable);
+  g_hash_table_remove_all(m_IconFiles);
+  m_nIconGeneration++;
+
+  if(m_TreeStore)
+  {
+     /* To clear all tree model data. */
+     gtk_tree_store_clear(m_TreeStore);
+     g_object_unref(m_TreeStore); 
+     m_TreeStore = NULL;
+  }
+
+  if(m_ListModel)
+  {
+     app_list_model_clear(m_ListModel);
+     g_object_unref(m_ListModel);
+     m_ListModel = NULL;
+  }
+
+  m_SearchIndex.m_Clear();
+
+  /* The templates are in the arena, keyed by its strings. */
+  g_hash_table_remove_all(m_ExecTemplates);
+
+  /* The node's data of all rows is released at once. */
+  m_AppItemArena.m_Clear();
+
+  /* The strings of the node's data built from the snapshot were in the mapped file. */
+  m_MenuSnapshot.m_Release();
+  m_bMenuFromSnapshot = false;
+  m_bMenuFromDaemon = false;
+
+  /* The choices not flushed yet are written. */
+  m_UsageLog.m_Close();
+}
+
+/*! \fn void CAppCatalog::m_ReleaseAppsMenuTree(void)
+    \brief To release the menu objects loaded by m_LoadAndBuildAppsMenuTree().
+
+    \param[in] NONE
+    \return NONE
+*/
+void CAppCatalog::m_ReleaseAppsMenuTree(void)
+{
+  m_StopMenuLoader();
+  m_RemoveMenuMonitor();
+
+  /* To decrease the reference counter of the menu directory object. */
+  if(m_RootDir)
+    gmenu_tree_item_unref(m_RootDir);
+
+  /* To decrease the reference counter of the menu tree object. */
+  if(m_MenuTree)
+    gmenu_tree_unref(m_MenuTree);
+
+  m_RootDir = NULL;
+  m_MenuTree = NULL;
+
+  if(m_bMenuTreeHeld)
+    nMenuTreeHolders--;
+
+  m_bMenuTreeHeld = false;
+}
+
+/*! \fn void CAppCatalog::m_SetOptions(const APP_CATALOG_OPTIONS *options)
+    \brief To set all options at once, before m_CreateInitValue().
+
+    \param[in] options.
+    \return NONE
+*/
+void CAppCatalog::m_SetOptions(const APP_CATALOG_OPTIONS *options)
+{
+  m_Options = *options;
+}
+
+//----------------------------------- Views
+/*! \fn void CAppCatalog::m_AttachView(APP_CATALOG_VIEW_FUNC func, gpointer data)
+    \brief To tell a view showing the model of the catalog about the changes of the rows.
+
+    \param[in] func. Called in the GTK main thread, it must not change the rows.
+    \param[in] data. The view, passed to func.
+    \return NONE
+*/
+void CAppCatalog::m_AttachView(APP_CATALOG_VIEW_FUNC func, gpointer data)
+{
+  APP_CATALOG_VIEW *view = g_new(APP_CATALOG_VIEW, 1);
+
+  view->func = func;
+  view->data = data;
+  m_Views = g_slist_prepend(m_Views, view);
+}
+
+/*! \fn void CAppCatalog::m_DetachView(gpointer data)
+    \brief To stop telling a view about the changes of the rows.
+
+    \param[in] data. The data passed to m_AttachView().
+    \return NONE
+*/
+void CAppCatalog::m_DetachView(gpointer data)
+{
+  for(GSList *item = m_Views; item; item = item->next)
+  {
+     APP_CATALOG_VIEW *view = (APP_CATALOG_VIEW*)item->data;
+
+     if(view->data == data)
+     {
+        m_Views = g_slist_delete_link(m_Views, item);
+        g_free(view);
+        return;
+     }
+  }
+}
+
+/*! \fn void CAppCatalog::m_NotifyViews(APP_CATALOG_EVENT event)
+    \brief To tell every attached view about a change of the rows.
+
+    \param[in] event.
+    \return NONE
+*/
+void CAppCatalog::m_NotifyViews(APP_CATALOG_EVENT event)
+{
+  GSList *item = m_Views;
+
+  /* A view may detach itself from the callback. */
+  while(item)
+  {
+     APP_CATALOG_VIEW *view = (APP_CATALOG_VIEW*)item->data;
+
+     item = item->next;
+     view->func(event, view->data);
+  }
+}
+
+/*! \fn GtkTreeModel* CAppCatalog::m_GetModel(void)
+    \brief To get the model of the rows, the tree store or the flat list model.
+
+    \param[in] NONE
+    \return The model owned by the catalog, NULL before m_CreateInitValue().
+*/
+GtkTreeModel* CAppCatalog::m_GetModel(void)
+{
+  if(m_ListModel)
+    return GTK_TREE_MODEL(m_ListModel);
+
+  return m_TreeStore ? GTK_TREE_MODEL(m_TreeStore) : NULL;
+}
+
+/*! \fn void CAppCatalog::m_SortTreeStore(void)
+    \brief To sort the rows of the tree store by name if m_Options.sort_by_name is set.
+
+    It is called once the store is filled. Rows inserted later, by a reload, go to their sorted position.
+
+    \param[in] NONE
+    \return NONE
+*/
+void CAppCatalog::m_SortTreeStore(void)
+{
+  GtkTreeSortable *sortable = NULL;
+
+  if(!m_Options.sort_by_name || !m_TreeStore)
+    return;
+
+  sortable = GTK_TREE_SORTABLE(m_TreeStore);
+
+  gtk_tree_sortable_set_sort_func(sortable, COLUMN_TEXT, cb_compare_rows, this, NULL);
+  gtk_tree_sortable_set_sort_column_id(sortable, COLUMN_TEXT, GTK_SORT_ASCENDING);
+}
+
+//----------------------------------- GMenus Reading Applications ".menu" file
+/*========== All things about applications menu starting from here! ==========*/
+/*! \fn gboolean CAppCatalog::m_LoadAndBuildAppsMenuTree(void)
+    \brief To load the main application menu(.menu) file. 
+
+    \param[in] NONE
+    \return TRUE or FALSE
+*/
+gboolean CAppCatalog::m_LoadAndBuildAppsMenuTree(void)
+{
+  GSList *directoryList = NULL;
+  gint64 spanStart = m_Profiler.m_Begin();
+
+  /* The applications the user chooses most are shown before the menu is loaded. */
+  m_AddFrequentCategory();
+
+  /* A running daemon has everything loaded already. */
+  if( m_Options.catalog_daemon && m_BuildAppsMenuFromDaemon() )
+  {
+     m_SortTreeStore();
+     m_Profiler.m_End("m_LoadAndBuildAppsMenuTree", spanStart);
+     return true;
+  }
+
+  /* Nothing is parsed before the window is shown while the snapshot of the last parse is fresh. The menu is
+     parsed in the background afterwards only to follow its changes. */
+  if( m_Options.menu_snapshot && m_BuildAppsMenuFromSnapshot() )
+  {
+     m_SortTreeStore();
+
+     /* The tree of the other holder is cached already, the lookup does not parse again. */
+     if( !m_StartMenuLoader() )
+     {
+        m_HoldMenuTree();
+        m_ParseAppsMenu();
+        m_bSnapshotStale = m_MenuSnapshot.m_IsStale();
+        m_FollowSnapshotMenu();
+     }
+
+     m_Profiler.m_End("m_LoadAndBuildAppsMenuTree", spanStart);
+     return true;
+  }
+
+  /* The window is shown while a thread parses the menu, the categories are added when it is done. */
+  if( m_Options.async_menu_load && m_StartMenuLoader() )
+  {
+     m_Profiler.m_End("m_LoadAndBuildAppsMenuTree", spanStart);
+     return true;
+  }
+
+  m_HoldMenuTree();
+  m_ParseAppsMenu();
+
+  /* To build the top-level tree node. Without a menu the store stays empty. */
+  directoryList = m_RootDir ? gmenu_tree_directory_get_contents( m_RootDir ) : NULL;
+
+  for(GSList *item = directoryList; item; item = item->next)
+  {
+     /* The root directory keeps the directory alive, the row does not need the list's reference. */
+     m_AddAppsMenuDirectory( (GMenuTreeDirectory*)item->data );
+     gmenu_tree_item_unref(item->data);
+  }
+
+  g_slist_free(directoryList);
+
+  m_FinishAppsMenuLoad();
+
+  m_Profiler.m_End("m_LoadAndBuildAppsMenuTree", spanStart);
+
+  return true;
+}
+
+/*! \fn void CAppCatalog::m_ParseAppsMenu(void)
+    \brief To parse the main application menu(.menu) file and every desktop entry it includes.
+           It runs in the menu loading thread, or in the GTK main thread if the menu is loaded synchronously.
+
+    \param[in] NONE
+    \return NONE
+*/
+void CAppCatalog::m_ParseAppsMenu(void)
+{
+  gint64 parseStart = m_Profiler.m_Begin();
+
+  /*------------ THE ENTRY POINT !!! -------------*/
+  g_mutex_lock(&menuParseMutex);
+
+  /* To open the applications .menu file. */
+  m_MenuTree = gmenu_tree_lookup( APPLICATIONS_MENU, GMENU_TREE_FLAGS_NONE );
+
+  /* To store the parsed direcotry contents. Both are NULL if the menu file can not be found or parsed. */
+  m_RootDir = m_MenuTree ? gmenu_tree_get_root_directory( m_MenuTree ) : NULL;
+
+  g_mutex_unlock(&menuParseMutex);
+
+  m_Profiler.m_End("gmenu parse", parseStart);
+}
+
+/*! \fn void CAppCatalog::m_AddAppsMenuDirectory(GMenuTreeDirectory *appsDir)
+    \brief To add a top-level directory of the menu: a category with its applications, or only its applications
+           in flat list mode.
+
+    \param[in] appsDir. An item of the root directory. Items which are not directories are skipped.
+*/
+void CAppCatalog::m_AddAppsMenuDirectory(GMenuTreeDirectory *appsDir)
+{
+  GtkTreeIter iter;
+
+  /* To check its type. */
+  if( G_UNLIKELY(gmenu_tree_item_get_type((GMenuTreeItem*)appsDir) != GMENU_TREE_ITEM_DIRECTORY) )
+    return;
+
+  /* The flat list has only the applications. */
+  if(m_Options.flat_list)
+  {
+     m_AddAppsMenuListRows(appsDir);
+     return;
+  }
+
+  /* To build top-level(Directory) nodes. */          
+  m_InsertAppsMenuDirectoryRow(&iter, NULL, -1, appsDir);
+
+  /* To build child nodes(sub-directories and applications). */
+  m_AddAppsMenuCategoryChildren(&iter, appsDir);
+}
+
+/*! \fn void CAppCatalog::m_FinishAppsMenuLoad(void)
+    \brief To sort the rows, follow changes of the menu and write its snapshot once all its top-level directories
+           are added.
+
+    \param[in] NONE
+    \return NONE
+*/
+void CAppCatalog::m_FinishAppsMenuLoad(void)
+{
+  m_bMenuLoading = false;
+
+  /* Sorted once, not on every row added. */
+  m_SortTreeStore();
+
+  /* To follow changes of installed applications, the store is updated in place.
+     It is not done earlier, a reload must never see a half built store. */
+  if(m_MenuTree)
+  {
+     gmenu_tree_add_monitor( m_MenuTree, cb_menu_tree_changed, this );
+     m_bMenuMonitored = true;
+  }
+
+  /* The next start reads this parse from the snapshot. A menu which could not be loaded is not kept. */
+  if(m_Options.menu_snapshot && m_RootDir)
+    m_WriteAppsMenuSnapshot();
+
+  /* The views stop showing the busy indicator, the rows added after the search text was typed are searched. */
+  m_NotifyViews(APP_CATALOG_MENU_LOADED);
+}
+
+//----------------------------------- Background Menu Loading
+/*! \fn gboolean CAppCatalog::m_StartMenuLoader(void)
+    \brief To parse the menu in a thread. The window can be shown and drawn in the meantime.
+
+    GNOME Menus is not thread safe. The thread is only started while no other instance of the process holds a menu
+    tree, and its lookup shares a lock with the synchronous ones, so no other GNOME Menus call runs beside it.
+    After a snapshot build the rows are all shown already, the parsed menu is only followed, see m_FollowSnapshotMenu().
+
+    \param[in] NONE
+    \return TRUE or FALSE. On FALSE, the menu has to be loaded synchronously.
+*/
+gboolean CAppCatalog::m_StartMenuLoader(void)
+{
+  if(nMenuTreeHolders > 0)
+    return false;
+
+  m_nMenuLoadStart = m_Profiler.m_Begin();
+  m_bMenuLoading = !m_bMenuFromSnapshot;
+  m_MenuLoader = g_thread_try_new("menu-loader", cb_load_menu, this, NULL);
+
+  if( G_UNLIKELY(!m_MenuLoader) )
+  {
+     m_bMenuLoading = false;
+     return false;
+  }
+
+  m_HoldMenuTree();
+
+  return true;
+}
+
+/*! \fn void CAppCatalog::m_HoldMenuTree(void)
+    \brief To count this instance as a holder of the process-wide menu tree until m_ReleaseAppsMenuTree().
+           It runs in the GTK main thread, before the menu is parsed.
+
+    \param[in] NONE
+    \return NONE
+*/
+void CAppCatalog::m_HoldMenuTree(void)
+{
+  if(m_bMenuTreeHeld)
+    return;
+
+  m_bMenuTreeHeld = true;
+  nMenuTreeHolders++;
+}
+
+/*! \fn void CAppCatalog::m_LoadMenuInThread(void)
+    \brief The body of the menu loading thread: parse the menu, then hand it to the GTK main thread.
+
+    \param[in] NONE
+    \return NONE
+*/
+void CAppCatalog::m_LoadMenuInThread(void)
+{
+  m_ParseAppsMenu();
+
+  /* GNOME Menus watches the files from the parse on. A change made between the snapshot load and the parse is
+     only seen by checking the directories again. */
+  if(m_bMenuFromSnapshot)
+    m_bSnapshotStale = m_MenuSnapshot.m_IsStale();
+
+  /* The idle handler joins this thread before it reads anything written here, including the handler's id. */
+  m_nMenuIdleId = g_idle_add(cb_add_loaded_menu_categories, this);
+}
+
+/*! \fn gboolean CAppCatalog::m_AddLoadedMenuCategories(void)
+    \brief To add the top-level directories of the parsed menu, one per call, so the window is redrawn in between.
+           It runs in the GTK main thread.
+
+    \param[in] NONE
+    \return TRUE if there are more directories to add, otherwise FALSE.
+*/
+gboolean CAppCatalog::m_AddLoadedMenuCategories(void)
+{
+  GSList *item = NULL;
+
+  /* The first call: the thread has finished parsing. */
+  if(m_MenuLoader)
+  {
+     g_thread_join(m_MenuLoader);
+     m_MenuLoader = NULL;
+
+     if(m_bMenuFromSnapshot)
+     {
+        m_nMenuIdleId = 0;
+        m_FollowSnapshotMenu();
+        m_Profiler.m_End("menu parse behind the snapshot", m_nMenuLoadStart);
+        return false;
+     }
+
+     m_PendingMenuDirs = m_RootDir ? gmenu_tree_directory_get_contents( m_RootDir ) : NULL;
+  }
+
+  if(m_PendingMenuDirs)
+  {
+     item = m_PendingMenuDirs;
+     m_PendingMenuDirs = g_slist_delete_link(m_PendingMenuDirs, item);
+
+     /* The root directory keeps the directory alive, the row does not need the list's reference. */
+     m_AddAppsMenuDirectory( (GMenuTreeDirectory*)item->data );
+     gmenu_tree_item_unref(item->data);
+  }
+
+  if(m_PendingMenuDirs)
+    return true;
+
+  m_nMenuIdleId = 0;
+  m_FinishAppsMenuLoad();
+  m_Profiler.m_End("menu load until last category", m_nMenuLoadStart);
+
+  return false;
+}
+
+/*! \fn void CAppCatalog::m_FollowSnapshotMenu(void)
+    \brief To follow the changes of the menu parsed behind the rows built from the snapshot. If it changed since
+           the snapshot was written, the rows are built again from it at once.
+
+    \param[in] NONE
+    \return NONE
+*/
+void CAppCatalog::m_FollowSnapshotMenu(void)
+{
+  if(!m_MenuTree)
+    return;
+
+  gmenu_tree_add_monitor( m_MenuTree, cb_menu_tree_changed, this );
+  m_bMenuMonitored = true;
+
+  if(m_bSnapshotStale)
+    m_ReloadAppsMenuTree();
+}
+
+/*! \fn void CAppCatalog::m_StopMenuLoader(void)
+    \brief To wait for the menu loading thread and drop the directories not added yet.
+
+    The thread can not be interrupted while GNOME Menus parses, so this waits until the parse is done.
+    The parsed menu is kept in m_MenuTree and m_RootDir for m_ReleaseAppsMenuTree().
+
+    \param[in] NONE
+    \return NONE
+*/
+void CAppCatalog::m_StopMenuLoader(void)
+{
+  if(m_MenuLoader)
+  {
+     g_thread_join(m_MenuLoader);
+     m_MenuLoader = NULL;
+  }
+
+  if(m_nMenuIdleId)
+    g_source_remove(m_nMenuIdleId);
+
+  m_nMenuIdleId = 0;
+
+  g_slist_free_full(m_PendingMenuDirs, (GDestroyNotify)gmenu_tree_item_unref);
+  m_PendingMenuDirs = NULL;
+  m_bMenuLoading = false;
+}
+
+/*! \fn void CAppCatalog::m_AddAppsMenuCategoryChildren(GtkTreeIter *iter, GMenuTreeDirectory *appsDir)
+    \brief To create the children of a directory node: its sub-directories and leaves, or only a dummy child in lazy mode.
+
+    \param[in] iter. The directory node.
+    \param[in] appsDir.
+*/
+void CAppCatalog::m_AddAppsMenuCategoryChildren(GtkTreeIter *iter, GMenuTreeDirectory *appsDir)
+{
+  if(m_Options.lazy_load)
+  {
+     /* A dummy child makes the category expandable, the real ones are created by m_PopulateCategory(). */
+     if( directory_has_contents(appsDir) )
+       gtk_tree_store_insert_with_values(m_TreeStore, NULL, iter, -1, COLUMN_TEXT, NULL, -1);
+
+     return;
+  }
+
+  m_AddAppsMenuDirectoryRows(iter, appsDir);
+}
+
+/*! \fn gboolean CAppCatalog::m_InsertAppsMenuDirectoryRow(GtkTreeIter *iter, GtkTreeIter *parent, gint position, GMenuTreeDirectory *appsDir)
+    \brief To insert a directory node.
+
+    \param[out] iter. The new node.
+    \param[in] parent. The parent directory node, NULL for a top-level one.
+    \param[in] position. The position among the parent's children, -1 to append.
+    \param[in] appsDir.
+    \return TRUE or FALSE
+*/
+gboolean CAppCatalog::m_InsertAppsMenuDirectoryRow(GtkTreeIter *iter, GtkTreeIter *parent, gint position, GMenuTreeDirectory *appsDir)
+{
+  return m_InsertCategoryRow(iter, parent, position, gmenu_tree_directory_get_name(appsDir), gmenu_tree_directory_get_icon(appsDir), appsDir);
+}
+
+/*! \fn gboolean CAppCatalog::m_InsertCategoryRow(GtkTreeIter *iter, GtkTreeIter *parent, gint position, const gchar *name, const gchar *icon_name, gpointer dirData)
+    \brief To insert a directory node with all its columns set.
+
+    \param[out] iter. The new node.
+    \param[in] parent. The parent directory node, NULL for a top-level one.
+    \param[in] position. The position among the parent's children, -1 to append.
+    \param[in] name.
+    \param[in] icon_name.
+    \param[in] dirData. The GMenuTreeDirectory object, or the MENU_SNAPSHOT_CATEGORY record if the menu is read from the snapshot.
+    \return TRUE or FALSE
+*/
+gboolean CAppCatalog::m_InsertCategoryRow(GtkTreeIter *iter, GtkTreeIter *parent, gint position, const gchar *name,
+                                                 const gchar *icon_name, gpointer dirData)
+{
+  GdkPixbuf *pixbuf = NULL;
+
+  /* To get PixelBuffer of the Directory icon. */
+  pixbuf = m_GetRowIcon(icon_name, IMG_SIZE ); 
+
+  m_Profiler.m_Count(PROFILE_ROWS_INSERTED);
+
+  /* One insertion with the columns' content, so the views see a single "row-inserted" and no "row-changed". */
+  gtk_tree_store_insert_with_values(m_TreeStore, iter, parent, position,
+                                    COLUMN_ICON, pixbuf,
+                                    COLUMN_TEXT, name,
+                                    COLUMN_NODEDATA, NULL,
+                                    COLUMN_DIRDATA, dirData,
+                                    -1);
+
+  /* The real icon replaces the placeholder when it is decoded. */
+  m_QueueIconRequest(iter, icon_name, IMG_SIZE);
+
+  /* pixbuf has a referece count of "1" now, as the tree store has added its own reference. 
+     So to decrease the reference count of pixbuf. */
+  if(pixbuf)
+    g_object_unref(pixbuf);
+
+  return true;
+}
+
+/*! \fn void CAppCatalog::m_AddAppsMenuDirectoryRows(GtkTreeIter *iter, GMenuTreeDirectory *appsDir)
+    \brief To create the nodes of a directory's items under its node, in menu order: sub-directory nodes and leaves(applications).
+
+    The sub-directories are walked with an explicit stack holding every open directory with its node, so each item
+    is inserted under the node of its own directory. In lazy mode a sub-directory node gets only a dummy child.
+
+    \param[in] iter. The directory node.
+    \param[in] appsDir.
+*/
+void CAppCatalog::m_AddAppsMenuDirectoryRows(GtkTreeIter *iter, GMenuTreeDirectory *appsDir)
+{
+  GArray *stack = NULL;
+  MENU_BUILD_FRAME frame;
+
+  if( G_UNLIKELY(!appsDir) )
+    return;
+
+  stack = g_array_new(FALSE, FALSE, sizeof(MENU_BUILD_FRAME));
+
+  frame.items = frame.next = gmenu_tree_directory_get_contents(appsDir);
+  frame.node = *iter;
+  g_array_append_val(stack, frame);
+
+  while(stack->len > 0)
+  {
+     MENU_BUILD_FRAME *top = &g_array_index(stack, MENU_BUILD_FRAME, stack->len - 1);
+     GtkTreeIter node = top->node, child;
+     GMenuTreeItem *item = NULL;
+     GMenuTreeItemType type;
+
+     /* The directory is done. The returned list and the references of its items belong to the caller,
+        the rows keep pointing to the directories, which live as long as the root directory. */
+     if(!top->next)
+     {
+        g_slist_free_full(top->items, (GDestroyNotify)gmenu_tree_item_unref);
+        g_array_set_size(stack, stack->len - 1);
+        continue;
+     }
+
+     item = (GMenuTreeItem*)top->next->data;
+     top->next = top->next->next;
+     type = gmenu_tree_item_get_type(item);
+
+     if( type == GMENU_TREE_ITEM_DIRECTORY )
+     {
+        m_InsertAppsMenuDirectoryRow(&child, &node, -1, (GMenuTreeDirectory*)item);
+
+        if(m_Options.lazy_load)
+        {
+           if( directory_has_contents((GMenuTreeDirectory*)item) )
+             gtk_tree_store_insert_with_values(m_TreeStore, NULL, &child, -1, COLUMN_TEXT, NULL, -1);
+
+           continue;
+        }
+
+        /* "top" is invalid once the stack grows. */
+        frame.items = frame.next = gmenu_tree_directory_get_contents( (GMenuTreeDirectory*)item );
+        frame.node = child;
+        g_array_append_val(stack, frame);
+     }
+     else if( type == GMENU_TREE_ITEM_ENTRY )
+     {
+        /* To determine if the current item need not to be shown. If it is, continue. */
+        if(gmenu_tree_entry_get_is_nodisplay( (GMenuTreeEntry*)item ) || 
+           gmenu_tree_entry_get_is_excluded( (GMenuTreeEntry*)item ) )
+          continue;
+
+        /* Add a tree leaf. */
+        m_InsertAppsMenuEntryRow(&child, &node, -1, (GMenuTreeEntry*)item);
+     }
+  }
+
+  g_array_free(stack, TRUE);
+}
+
+/*! \fn APP_ITEM_INFO* CAppCatalog::m_NewAppItemInfo(GMenuTreeEntry *item)
+    \brief To create the node-data of an application and make it searchable.
+
+    \param[in] item.
+    \return The node-data. It is zeroed by the arena, and lives until the arena is cleared in m_DeinitValue().
+*/
+APP_ITEM_INFO* CAppCatalog::m_NewAppItemInfo(GMenuTreeEntry *item)
+{
+  APP_ITEM_INFO *appInfo = (APP_ITEM_INFO*)m_AppItemArena.m_Alloc( sizeof(APP_ITEM_INFO) );
+
+  appInfo->name = m_AppItemArena.m_InternString( gmenu_tree_entry_get_name( item ) );
+  appInfo->icon = m_AppItemArena.m_InternString( gmenu_tree_entry_get_icon( item ) );
+  appInfo->exec = m_AppItemArena.m_InternString( gmenu_tree_entry_get_exec( item ) );
+  appInfo->comment = m_AppItemArena.m_InternString( gmenu_tree_entry_get_comment( item ) );
+
+  #if 1
+  appInfo->desktopfile = m_AppItemArena.m_InternString( gmenu_tree_entry_get_desktop_file_path( item ) );
+  #else
+  appInfo->desktopfile = m_AppItemArena.m_InternString( gmenu_tree_entry_get_desktop_file_id( item ) );
+  #endif
+
+  /* To make the application searchable. */
+  m_SearchIndex.m_Add(appInfo, appInfo->name, appInfo->comment, appInfo->exec);
+  m_PrepareExecTemplate(appInfo->exec);
+
+  return appInfo;
+}
+
+/*! \fn gboolean CAppCatalog::m_InsertAppsMenuEntryRow(GtkTreeIter *iter, GtkTreeIter *parent, gint position, GMenuTreeEntry *item)
+    \brief To insert a leaf node(application).
+
+    \param[out] iter. The new node.
+    \param[in] parent. The directory node.
+    \param[in] position. The position among the parent's children, -1 to append.
+    \param[in] item.
+    \return TRUE or FALSE
+*/
+gboolean CAppCatalog::m_InsertAppsMenuEntryRow(GtkTreeIter *iter, GtkTreeIter *parent, gint position, GMenuTreeEntry *item)
+{
+  /* To create a object containing information about current leaf node. */
+  return m_InsertAppItemRow(iter, parent, position, m_NewAppItemInfo(item));
+}
+
+/*! \fn gboolean CAppCatalog::m_InsertAppItemRow(GtkTreeIter *iter, GtkTreeIter *parent, gint position, APP_ITEM_INFO *appInfo)
+    \brief To insert a leaf node(application) with all its columns set.
+
+    \param[out] iter. The new node.
+    \param[in] parent. The directory node.
+    \param[in] position. The position among the parent's children, -1 to append.
+    \param[in] appInfo. The node-data.
+    \return TRUE or FALSE
+*/
+gboolean CAppCatalog::m_InsertAppItemRow(GtkTreeIter *iter, GtkTreeIter *parent, gint position, APP_ITEM_INFO *appInfo)
+{
+  GdkPixbuf *pixbuf = NULL;
+  const gchar *icon_name = appInfo->icon;
+
+  /* To create the icon for the currently read node. */
+  if(icon_name)
+    pixbuf = m_GetRowIcon(icon_name, IMG_SIZE );
+  else
+    pixbuf = m_GetRowIcon(DEFAULT_APP__MIME_ICON, IMG_SIZE );  // If there has no icon name in .desktop file, using the system default icon for application.
+
+  m_Profiler.m_Count(PROFILE_ROWS_INSERTED);
+
+  gtk_tree_store_insert_with_values(m_TreeStore, iter, parent, position,
+                                    COLUMN_ICON, pixbuf,
+                                    COLUMN_TEXT, appInfo->name,
+                                    COLUMN_NODEDATA, appInfo,
+                                    -1);
+
+  /* The real icon replaces the placeholder when it is decoded. */
+  m_QueueIconRequest(iter, icon_name ? icon_name : DEFAULT_APP__MIME_ICON, IMG_SIZE);
+				
+  /* pixbuf has a referece count of "1" now, as the tree store has added its own reference. 
+     So to decrease the reference count of pixbuf. */
+  if(pixbuf)
+    g_object_unref(pixbuf);
+
+  return true;
+}
+
+//----------------------------------- Incremental Menu Reload
+/*! \fn void CAppCatalog::m_RemoveMenuMonitor(void)
+    \brief To stop following changes of the applications menu.
+
+    \param[in] NONE
+    \return NONE
+*/
+void CAppCatalog::m_RemoveMenuMonitor(void)
+{
+  if(!m_bMenuMonitored)
+    return;
+
+  gmenu_tree_remove_monitor( m_MenuTree, cb_menu_tree_changed, this );
+  m_bMenuMonitored = false;
+}
+
+/*! \fn void CAppCatalog::m_ReloadAppsMenuTree(void)
+    \brief To bring the tree store up to date with the changed applications menu.
+
+    The new menu contents are compared with the rows level by level: directory nodes by menu id, leaves by
+    desktop entry file.
+    Only new rows are inserted, vanished rows removed, changed rows updated and kept rows moved to their new menu
+    position; untouched rows keep their icons. The icons which could not be found are looked up again, they may
+    have come with the change.
+    If less than half of the categories are kept, or most strings of the arena are not used anymore after the
+    former reloads, the store is built again by m_RebuildAppsMenuTree() instead.
+
+    \param[in] NONE
+    \return NONE
+*/
+void CAppCatalog::m_ReloadAppsMenuTree(void)
+{
+  GtkTreeModel *model = GTK_TREE_MODEL(m_TreeStore);
+  GMenuTreeDirectory *newRootDir = NULL;
+  GHashTable *oldDirs = NULL;
+  GSList *directoryList = NULL, *item = NULL;
+  GHashTableIter hashIter;
+  GtkTreeIter iter, prevIter;
+  gboolean bHasPrev = false;
+  gpointer value = NULL;
+  guint nDirs = 0, nKeptDirs = 0;
+
+  if( G_UNLIKELY((!m_TreeStore && !m_ListModel) || !m_MenuTree) )
+    return;
+
+  /* GNOME Menus parses the changed menu again here. */
+  newRootDir = gmenu_tree_get_root_directory( m_MenuTree );
+
+  m_ExpireIconMisses();
+
+  /* The rows of the snapshot have no menu objects to compare with. They are built again from the parsed menu,
+     then the strings of the snapshot are not used anymore. The next start writes a new snapshot. */
+  if(m_bMenuFromSnapshot)
+  {
+     m_bMenuFromSnapshot = false;
+
+     if(m_Options.flat_list)
+       m_ReloadAppsMenuList(newRootDir);
+     else
+     {
+        m_RebuildAppsMenuTree(newRootDir);
+        m_NotifyViews(APP_CATALOG_ROWS_CHANGED);
+     }
+
+     m_MenuSnapshot.m_Release();
+     return;
+  }
+
+  if(m_Options.flat_list)
+  {
+     m_ReloadAppsMenuList(newRootDir);
+     return;
+  }
+
+  /* The menu can not be parsed anymore, e.g. it is being rewritten: no category is left until the next change. */
+  if( G_UNLIKELY(!newRootDir) )
+  {
+     m_RebuildAppsMenuTree(NULL);
+     m_NotifyViews(APP_CATALOG_ROWS_CHANGED);
+     return;
+  }
+
+  /* Menu id -> top-level node. */
+  oldDirs = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, (GDestroyNotify)gtk_tree_iter_free);
+
+  if( gtk_tree_model_get_iter_first(model, &iter) )
+  {
+     do
+     {
+        gpointer dirData = NULL;
+
+        gtk_tree_model_get(model, &iter, COLUMN_DIRDATA, &dirData, -1);
+
+        /* It is not a menu directory, new categories go after it. */
+        if(dirData == FREQUENT_CATEGORY_DATA)
+        {
+           prevIter = iter;
+           bHasPrev = true;
+           continue;
+        }
+
+        g_hash_table_insert(oldDirs, g_strdup(dirData ? directory_key((GMenuTreeDirectory*)dirData) : ""), gtk_tree_iter_copy(&iter));
+     } while( gtk_tree_model_iter_next(model, &iter) );
+  }
+
+  directoryList = gmenu_tree_directory_get_contents( newRootDir );
+
+  /* When most categories are new(e.g. another menu layout), updating the attached store in place would send
+     a signal to every view for every row. A new store is built detached instead. */
+  for(item = directoryList; item; item = item->next)
+  {
+     if( gmenu_tree_item_get_type((GMenuTreeItem*)item->data) != GMENU_TREE_ITEM_DIRECTORY )
+       continue;
+
+     nDirs++;
+
+     if( g_hash_table_lookup(oldDirs, directory_key((GMenuTreeDirectory*)item->data)) )
+       nKeptDirs++;
+  }
+
+  if( nKeptDirs * 2 < nDirs || m_AppItemArena.m_IsMostlyUnused() )
+  {
+     for(item = directoryList; item; item = item->next)
+       gmenu_tree_item_unref(item->data);
+
+     g_slist_free(directoryList);
+     g_hash_table_destroy(oldDirs);
+
+     m_RebuildAppsMenuTree(newRootDir);
+     m_NotifyViews(APP_CATALOG_ROWS_CHANGED);
+     return;
+  }
+
+  for(item = directoryList; item; item = item->next)
+  {
+     GMenuTreeDirectory *tmpDir = (GMenuTreeDirectory*)item->data;
+     const gchar *key = NULL;
+
+     if( gmenu_tree_item_get_type((GMenuTreeItem*)tmpDir) != GMENU_TREE_ITEM_DIRECTORY )
+     {
+        gmenu_tree_item_unref(tmpDir);
+        continue;
+     }
+
+     key = directory_key(tmpDir);
+
+     if( g_hash_table_lookup_extended(oldDirs, key, NULL, &value) )
+     {
+        iter = *(GtkTreeIter*)value;
+        g_hash_table_remove(oldDirs, key);
+
+        m_MoveRowAfter(&iter, bHasPrev ? &prevIter : NULL);
+        m_ReloadCategory(&iter, tmpDir);
+     }
+     else
+     {
+        /* A new category, inserted at its menu position. */
+        m_InsertAppsMenuDirectoryRow(&iter, NULL, get_next_position(model, bHasPrev ? &prevIter : NULL), tmpDir);
+        m_AddAppsMenuCategoryChildren(&iter, tmpDir);
+     }
+
+     prevIter = iter;
+     bHasPrev = true;
+
+     gmenu_tree_item_unref(tmpDir);
+  }
+
+  g_slist_free(directoryList);
+
+  /* The categories left have vanished. */
+  g_hash_table_iter_init(&hashIter, oldDirs);
+
+  while( g_hash_table_iter_next(&hashIter, NULL, &value) )
+    m_RemoveAppsMenuRow( (GtkTreeIter*)value );
+
+  g_hash_table_destroy(oldDirs);
+
+  /* The rows refer to the new directories now. */
+  if(m_RootDir)
+    gmenu_tree_item_unref(m_RootDir);
+
+  m_RootDir = newRootDir;
+
+  /* A frequently used application could have been removed or changed. */
+  m_UpdateFrequentCategory();
+
+  /* The changed applications could match the search or not anymore. */
+  m_NotifyViews(APP_CATALOG_ROWS_CHANGED);
+}
+
+/*! \fn void CAppCatalog::m_RebuildAppsMenuTree(GMenuTreeDirectory *newRootDir)
+    \brief To build a new tree store for the changed menu while no tree view shows it, then show it at once.
+
+    The store is filled with no view connected, so inserting a row emits no signal anybody handles, it is sorted
+    once and only then set as the model of every view. The expanded categories are not kept. The icons are taken
+    from the intern table, only icons not loaded yet are decoded. The node-data is built in a new arena
+    generation, the old one is released with the old store.
+
+    \param[in] newRootDir. The root directory of the changed menu. Its reference is taken over. If it is NULL,
+                only the "Frequently used" category is left.
+    \return NONE
+*/
+void CAppCatalog::m_RebuildAppsMenuTree(GMenuTreeDirectory *newRootDir)
+{
+  GtkTreeStore *oldStore = m_TreeStore;
+  GSList *directoryList = NULL, *item = NULL;
+  GHashTableIter hashIter;
+  gpointer value = NULL;
+  gint64 spanStart = m_Profiler.m_Begin();
+
+  /* The rows of the old store wait for no icon anymore. */
+  g_hash_table_iter_init(&hashIter, m_IconPending);
+
+  while( g_hash_table_iter_next(&hashIter, NULL, &value) )
+    g_array_set_size( ((ICON_REQUEST*)value)->iters, 0 );
+
+  /* Only the new rows are searched. Their node-data and commands go to a new generation of the arena,
+     the old rows keep theirs until their store is dropped. */
+  m_SearchIndex.m_Clear();
+  g_hash_table_remove_all(m_ExecTemplates);
+  m_AppItemArena.m_NewGeneration();
+
+  m_TreeStore = new_tree_store();
+
+  m_AddFrequentCategory();
+
+  directoryList = newRootDir ? gmenu_tree_directory_get_contents( newRootDir ) : NULL;
+
+  for(item = directoryList; item; item = item->next)
+  {
+     m_AddAppsMenuDirectory( (GMenuTreeDirectory*)item->data );
+     gmenu_tree_item_unref(item->data);
+  }
+
+  g_slist_free(directoryList);
+
+  m_SortTreeStore();
+
+  /* The old store is released with the last filter model over it. */
+  m_NotifyViews(APP_CATALOG_MODEL_REPLACED);
+
+  g_object_unref(oldStore);
+
+  /* No row refers to the former generation anymore. */
+  m_AppItemArena.m_ReleaseRetired();
+
+  /* The rows refer to the new directories now. */
+  if(m_RootDir)
+    gmenu_tree_item_unref(m_RootDir);
+
+  m_RootDir = newRootDir;
+
+  m_Profiler.m_End("m_RebuildAppsMenuTree", spanStart);
+}
+
+/*! \fn void CAppCatalog::m_ReloadCategory(GtkTreeIter *iter, GMenuTreeDirectory *appsDir)
+    \brief To bring a directory node and its children up to date with the changed menu directory.
+           The kept sub-directory nodes are reloaded the same way.
+
+    \param[in] iter. The directory node.
+    \param[in] appsDir. The directory of the reloaded menu.
+*/
+void CAppCatalog::m_ReloadCategory(GtkTreeIter *iter, GMenuTreeDirectory *appsDir)
+{
+  GtkTreeModel *model = GTK_TREE_MODEL(m_TreeStore);
+  GMenuTreeDirectory *oldDir = NULL;
+  GHashTable *oldRows[2] = { NULL, NULL };  /* Sub-directory nodes and leaves. */
+  GSList *itemList = NULL, *item = NULL;
+  GHashTableIter hashIter;
+  GtkTreeIter child, prevIter;
+  gboolean bHasPrev = false;
+  gpointer value = NULL;
+
+  gtk_tree_model_get(model, iter, COLUMN_DIRDATA, &oldDir, -1);
+
+  if( oldDir && g_strcmp0(gmenu_tree_directory_get_icon(oldDir), gmenu_tree_directory_get_icon(appsDir)) != 0 )
+    m_UpdateRowIcon(iter, gmenu_tree_directory_get_icon(appsDir));
+
+  gtk_tree_store_set(m_TreeStore, iter, COLUMN_DIRDATA, appsDir, -1);
+
+  /* No child yet. */
+  if( !gtk_tree_model_iter_children(model, &child, iter) )
+  {
+     m_AddAppsMenuCategoryChildren(iter, appsDir);
+     return;
+  }
+
+  /* Not populated yet in lazy mode, it is done on expansion. */
+  if( m_IsDummyRow(&child) )
+  {
+     if( !directory_has_contents(appsDir) )
+       gtk_tree_store_remove(m_TreeStore, &child);
+
+     return;
+  }
+
+  /* Menu id -> sub-directory nodes, desktop entry file -> leaves. */
+  oldRows[0] = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, free_iter_list);
+  oldRows[1] = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, free_iter_list);
+
+  do
+  {
+     gpointer nodeData = NULL, dirData = NULL;
+
+     gtk_tree_model_get(model, &child, COLUMN_NODEDATA, &nodeData, COLUMN_DIRDATA, &dirData, -1);
+
+     if(dirData)
+       add_old_row(oldRows[0], directory_key((GMenuTreeDirectory*)dirData), &child);
+     else
+       add_old_row(oldRows[1], (nodeData && ((APP_ITEM_INFO*)nodeData)->desktopfile) ? ((APP_ITEM_INFO*)nodeData)->desktopfile : "", &child);
+  } while( gtk_tree_model_iter_next(model, &child) );
+
+  itemList = gmenu_tree_directory_get_contents(appsDir);
+
+  for(item = itemList; item; item = item->next)
+  {
+     GMenuTreeItemType type = gmenu_tree_item_get_type( (GMenuTreeItem*)item->data );
+
+     if( type == GMENU_TREE_ITEM_DIRECTORY )
+     {
+        GMenuTreeDirectory *subDir = (GMenuTreeDirectory*)item->data;
+
+        if( take_old_row(oldRows[0], directory_key(subDir), &child) )
+        {
+           m_MoveRowAfter(&child, bHasPrev ? &prevIter : NULL);
+           m_ReloadCategory(&child, subDir);
+        }
+        else
+        {
+           /* A new sub-directory, inserted at its menu position. */
+           m_InsertAppsMenuDirectoryRow(&child, iter, get_next_position(model, bHasPrev ? &prevIter : NULL), subDir);
+           m_AddAppsMenuCategoryChildren(&child, subDir);
+        }
+     }
+     else if( type == GMENU_TREE_ITEM_ENTRY &&
+              !gmenu_tree_entry_get_is_nodisplay( (GMenuTreeEntry*)item->data ) &&
+              !gmenu_tree_entry_get_is_excluded( (GMenuTreeEntry*)item->data ) )
+     {
+        GMenuTreeEntry *entry = (GMenuTreeEntry*)item->data;
+
+        if( take_old_row(oldRows[1], gmenu_tree_entry_get_desktop_file_path(entry), &child) )
+        {
+           m_MoveRowAfter(&child, bHasPrev ? &prevIter : NULL);
+           m_UpdateAppsMenuEntryRow(&child, entry);
+        }
+        else
+        {
+           /* A new application, inserted at its menu position. */
+           m_InsertAppsMenuEntryRow(&child, iter, get_next_position(model, bHasPrev ? &prevIter : NULL), entry);
+        }
+     }
+     else
+     {
+        gmenu_tree_item_unref(item->data);
+        continue;
+     }
+
+     prevIter = child;
+     bHasPrev = true;
+
+     gmenu_tree_item_unref(item->data);
+  }
+
+  g_slist_free(itemList);
+
+  /* The sub-directories and leaves left have vanished. */
+  for(guint i = 0; i < G_N_ELEMENTS(oldRows); i++)
+  {
+     g_hash_table_iter_init(&hashIter, oldRows[i]);
+
+     while( g_hash_table_iter_next(&hashIter, NULL, &value) )
+     {
+        for(GSList *row = (GSList*)value; row; row = row->next)
+          m_RemoveAppsMenuRow( (GtkTreeIter*)row->data );
+     }
+  }
+
+  g_hash_table_destroy(oldRows[0]);
+  g_hash_table_destroy(oldRows[1]);
+}
+
+/*! \fn void CAppCatalog::m_UpdateAppsMenuEntryRow(GtkTreeIter *iter, GMenuTreeEntry *item)
+    \brief To update a leaf node whose desktop entry is still in the menu. Unchanged leaves are not touched.
+
+    \param[in] iter.
+    \param[in] item.
+*/
+void CAppCatalog::m_UpdateAppsMenuEntryRow(GtkTreeIter *iter, GMenuTreeEntry *item)
+{
+  gpointer value = NULL;
+  APP_ITEM_INFO *appInfo = NULL, old;
+  const gchar *icon_name = gmenu_tree_entry_get_icon(item);
+  gboolean bExecChanged = false, bCommentChanged = false, bNameChanged = false;
+
+  gtk_tree_model_get(GTK_TREE_MODEL(m_TreeStore), iter, COLUMN_NODEDATA, &value, -1);
+  appInfo = (APP_ITEM_INFO*)value;
+
+  if( G_UNLIKELY(!appInfo) )
+    return;
+
+  old = *appInfo;
+
+  bExecChanged = replace_string(m_AppItemArena, &appInfo->exec, gmenu_tree_entry_get_exec(item));
+  bCommentChanged = replace_string(m_AppItemArena, &appInfo->comment, gmenu_tree_entry_get_comment(item));
+  bNameChanged = replace_string(m_AppItemArena, &appInfo->name, gmenu_tree_entry_get_name(item));
+
+  if(bExecChanged || bCommentChanged || bNameChanged)
+    m_SearchIndex.m_Add(appInfo, appInfo->name, appInfo->comment, appInfo->exec);
+
+  if(bExecChanged)
+    m_PrepareExecTemplate(appInfo->exec);
+
+  if(bNameChanged)
+    gtk_tree_store_set(m_TreeStore, iter, COLUMN_TEXT, appInfo->name, -1);
+
+  if( replace_string(m_AppItemArena, &appInfo->icon, icon_name) )
+  {
+     m_UpdateRowIcon(iter, icon_name ? icon_name : DEFAULT_APP__MIME_ICON);
+     m_ReleaseAppString(old.icon);
+  }
+
+  /* The replaced strings, once the search index and the row show the new ones. */
+  if(bExecChanged)
+    m_ReleaseAppString(old.exec);
+
+  if(bCommentChanged)
+    m_ReleaseAppString(old.comment);
+
+  if(bNameChanged)
+    m_ReleaseAppString(old.name);
+}
+
+/*! \fn void CAppCatalog::m_UpdateRowIcon(GtkTreeIter *iter, const gchar *name)
+    \brief To replace the icon of an existing row.
+
+    \param[in] iter.
+    \param[in] name. The new icon name.
+*/
+void CAppCatalog::m_UpdateRowIcon(GtkTreeIter *iter, const gchar *name)
+{
+  GdkPixbuf *pixbuf = NULL;
+
+  /* A request for the old icon must not overwrite the new one. */
+  m_CancelIconRequests(iter);
+
+  if(m_IconPool)
+  {
+     m_QueueIconRequest(iter, name, IMG_SIZE);
+     return;
+  }
+
+  pixbuf = m_LoadIcon(name, IMG_SIZE, TRUE);
+  gtk_tree_store_set(m_TreeStore, iter, COLUMN_ICON, pixbuf, -1);
+
+  if(pixbuf)
+    g_object_unref(pixbuf);
+}
+
+/*! \fn void CAppCatalog::m_MoveRowAfter(GtkTreeIter *iter, GtkTreeIter *prev)
+    \brief To move a kept row right after its previous sibling in the reloaded menu, if the menu order changed.
+           A store sorted by name orders its rows itself.
+
+    \param[in] iter.
+    \param[in] prev. NULL to move it to the first position.
+*/
+void CAppCatalog::m_MoveRowAfter(GtkTreeIter *iter, GtkTreeIter *prev)
+{
+  GtkTreeModel *model = GTK_TREE_MODEL(m_TreeStore);
+  GtkTreePath *path = NULL;
+  gint nPosition = 0;
+
+  if(m_Options.sort_by_name)
+    return;
+
+  path = gtk_tree_model_get_path(model, iter);
+  nPosition = gtk_tree_path_get_indices(path)[gtk_tree_path_get_depth(path) - 1];
+  gtk_tree_path_free(path);
+
+  if( nPosition != get_next_position(model, prev) )
+    gtk_tree_store_move_after(m_TreeStore, iter, prev);
+}
+
+/*! \fn void CAppCatalog::m_ExpireIconMisses(void)
+    \brief To forget the icon names which could not be found and the resolved icon files, so the next lookups see
+           the icons installed or removed with a menu or icon theme change. The loaded icons are kept.
+
+    \param[in] NONE
+    \return NONE
+*/
+void CAppCatalog::m_ExpireIconMisses(void)
+{
+  m_IconResolver.m_Clear();
+
+  if( g_hash_table_foreach_remove(m_IconInternTable, cb_is_icon_miss, NULL) )
+    m_nIconGeneration++;
+
+  g_hash_table_remove_all(m_IconFiles);
+}
+
+/*! \fn void CAppCatalog::m_RemoveAppsMenuRow(GtkTreeIter *iter)
+    \brief To remove a row with its descendants, their search index entries and pending icon requests.
+           Their node-data is given back to the arena.
+
+    \param[in] iter.
+*/
+void CAppCatalog::m_RemoveAppsMenuRow(GtkTreeIter *iter)
+{
+  GPtrArray *records = g_ptr_array_new();
+
+  m_ForgetAppsMenuRow(iter, records);
+  gtk_tree_store_remove(m_TreeStore, iter);
+
+  /* No row refers to them anymore. */
+  for(guint n = 0; n < records->len; n++)
+    m_ReleaseAppItemInfo( (APP_ITEM_INFO*)g_ptr_array_index(records, n) );
+
+  g_ptr_array_free(records, TRUE);
+}
+
+/*! \fn void CAppCatalog::m_ReleaseAppItemInfo(APP_ITEM_INFO *appInfo)
+    \brief To give the node-data of a removed row and its strings back to the arena.
+
+    \param[in] appInfo.
+*/
+void CAppCatalog::m_ReleaseAppItemInfo(APP_ITEM_INFO *appInfo)
+{
+  m_ReleaseAppString(appInfo->name);
+  m_ReleaseAppString(appInfo->icon);
+  m_ReleaseAppString(appInfo->exec);
+  m_ReleaseAppString(appInfo->comment);
+  m_ReleaseAppString(appInfo->desktopfile);
+
+  m_AppItemArena.m_Free( appInfo, sizeof(APP_ITEM_INFO) );
+}
+
+/*! \fn void CAppCatalog::m_ReleaseAppString(const gchar *str)
+    \brief To drop a user of a node-data string. The template of a command no node-data uses anymore goes with it.
+
+    \param[in] str. It could be NULL.
+*/
+void CAppCatalog::m_ReleaseAppString(const gchar *str)
+{
+  gpointer tmpl = NULL;
+
+  if( !m_AppItemArena.m_ReleaseString(str) || !g_hash_table_lookup_extended(m_ExecTemplates, str, NULL, &tmpl) )
+    return;
+
+  g_hash_table_remove(m_ExecTemplates, str);
+
+  if(tmpl)
+    m_AppItemArena.m_Free( tmpl, ((EXEC_TEMPLATE*)tmpl)->size );
+}
+
+/*! \fn void CAppCatalog::m_ForgetAppsMenuRow(GtkTreeIter *iter, GPtrArray *records)
+    \brief To take a row and its descendants out of the search index and the pending icon requests.
+
+    \param[in] iter.
+    \param[out] records. Their node-data is appended, to be released once the rows are removed.
+*/
+void CAppCatalog::m_ForgetAppsMenuRow(GtkTreeIter *iter, GPtrArray *records)
+{
+  GtkTreeModel *model = GTK_TREE_MODEL(m_TreeStore);
+  GtkTreeIter child;
+  gpointer value = NULL;
+
+  if( gtk_tree_model_iter_children(model, &child, iter) )
+  {
+     do
+     {
+        m_ForgetAppsMenuRow(&child, records);
+     } while( gtk_tree_model_iter_next(model, &child) );
+  }
+
+  gtk_tree_model_get(model, iter, COLUMN_NODEDATA, &value, -1);
+
+  if(value)
+  {
+     m_SearchIndex.m_Remove(value);
+     g_ptr_array_add(records, value);
+  }
+
+  m_CancelIconRequests(iter);
+}
+
+/*! \fn void CAppCatalog::m_CancelIconRequests(GtkTreeIter *iter)
+    \brief To take a row out of the pending icon requests, e.g. because the row is going to be removed.
+
+    \param[in] iter.
+*/
+void CAppCatalog::m_CancelIconRequests(GtkTreeIter *iter)
+{
+  GHashTableIter hashIter;
+  gpointer value = NULL;
+
+  g_hash_table_iter_init(&hashIter, m_IconPending);
+
+  while( g_hash_table_iter_next(&hashIter, NULL, &value) )
+  {
+     GArray *iters = ((ICON_REQUEST*)value)->iters;
+
+     /* GtkTreeStore identifies a row by "user_data" of its iterators. */
+     for(guint n = iters->len; n > 0; n--)
+     {
+        if( g_array_index(iters, GtkTreeIter, n - 1).user_data == iter->user_data )
+          g_array_remove_index(iters, n - 1);
+     }
+  }
+}
+
+/*! \fn gboolean CAppCatalog::m_IsDummyRow(GtkTreeIter *iter)
+    \brief To check if a row is the dummy child of a category which is not populated yet in lazy mode.
+
+    \param[in] iter.
+    \return TRUE or FALSE
+*/
+gboolean CAppCatalog::m_IsDummyRow(GtkTreeIter *iter)
+{
+  gpointer nodeData = NULL, dirData = NULL;
+
+  gtk_tree_model_get(GTK_TREE_MODEL(m_TreeStore), iter, COLUMN_NODEDATA, &nodeData, COLUMN_DIRDATA, &dirData, -1);
+
+  return (!nodeData && !dirData);
+}
+
+//----------------------------------- Icon Decoding Pipeline
+/*! \fn gboolean CAppCatalog::m_StartIconPipeline(void)
+    \brief To create the worker threads decoding icons, one per processor core.
+
+    \param[in] NONE
+    \return TRUE or FALSE. On FALSE, icons are loaded synchronously.
+*/
+gboolean CAppCatalog::m_StartIconPipeline(void)
+{
+  long nCores = sysconf(_SC_NPROCESSORS_ONLN);
+
+  if(m_IconPool)
+    return true;
+
+  /* Every row shows this icon until its own icon is decoded. It is also what a row keeps
+     when its icon can not be loaded, the same fallback m_LoadIcon() would use. */
+  if(!m_pPlaceholderIcon)
+    m_pPlaceholderIcon = m_LoadIcon(DEFAULT_APP_ICON, IMG_SIZE, TRUE);
+
+  m_bIconPipelineCancelled = 0;
+  m_nIconIdleId = 0;
+  m_IconResults = g_async_queue_new();
+  m_IconPool = g_thread_pool_new(cb_decode_icon, this, (nCores > 0)? (gint)nCores : 1, TRUE, NULL);
+
+  if( G_UNLIKELY(!m_IconPool) )
+  {
+     g_async_queue_unref(m_IconResults);
+     m_IconResults = NULL;
+     return false;
+  }
+
+  /* A row waiting for its first icon goes before a row showing the preview of a scalable one. */
+  g_thread_pool_set_sort_function(m_IconPool, cb_compare_icon_requests, NULL);
+
+  return true;
+}
+
+/*! \fn void CAppCatalog::m_StopIconPipeline(void)
+    \brief To stop the worker threads and drop all pending icon requests.
+
+    \param[in] NONE
+    \return NONE
+*/
+void CAppCatalog::m_StopIconPipeline(void)
+{
+  ICON_REQUEST *request = NULL;
+
+  if(!m_IconPool)
+    return;
+
+  /* Queued requests are dropped by the workers, then wait for the running ones. */
+  g_atomic_int_set(&m_bIconPipelineCancelled, 1);
+  g_thread_pool_free(m_IconPool, FALSE, TRUE);
+  m_IconPool = NULL;
+
+  while( (request = (ICON_REQUEST*)g_async_queue_try_pop(m_IconResults)) != NULL )
+    free_icon_request(request);
+
+  while( (request = (ICON_REQUEST*)g_queue_pop_head(m_DeferredIcons)) != NULL )
+    free_icon_request(request);
+
+  if(m_nDeferredIdleId)
+    g_source_remove(m_nDeferredIdleId);
+
+  m_nDeferredIdleId = 0;
+
+  g_hash_table_remove_all(m_IconPending);
+
+  /* The workers are gone, nothing schedules the handler anymore. */
+  if(m_nIconIdleId)
+    g_source_remove(m_nIconIdleId);
+
+  m_nIconIdleId = 0;
+
+  g_async_queue_unref(m_IconResults);
+  m_IconResults = NULL;
+
+  if(m_pPlaceholderIcon)
+    g_object_unref(m_pPlaceholderIcon);
+
+  m_pPlaceholderIcon = NULL;
+}
+
+/*! \fn GdkPixbuf* CAppCatalog::m_GetRowIcon(const gchar* name, gint size)
+    \brief To get the icon a new tree row starts with.
+
+    \param[in] name. The icon name.
+    \param[in] size.
+    \return PixelBuffer object the caller owns a reference to: the placeholder icon if the icon decoding pipeline
+             is running, otherwise the loaded icon.
+*/
+GdkPixbuf* CAppCatalog::m_GetRowIcon(const gchar* name, gint size)
+{
+  if(m_IconPool)
+    return m_pPlaceholderIcon ? (GdkPixbuf*)g_object_ref(m_pPlaceholderIcon) : NULL;
+
+  return m_LoadIcon(name, size, TRUE);
+}
+
+/*! \fn void CAppCatalog::m_QueueIconRequest(GtkTreeIter *iter, const gchar* name, gint size)
+    \brief To queue the icon of a tree row for the worker threads. It does nothing if the pipeline is not running.
+
+    A row whose icon is already loaded gets the shared icon at once, a row whose icon is being decoded
+    joins that request. Only the first row of every icon name and size is decoded.
+
+    \param[in] iter. The tree row. GtkTreeStore iterators persist, so it stays valid until the row is removed.
+    \param[in] name. The icon name.
+    \param[in] size.
+*/
+void CAppCatalog::m_QueueIconRequest(GtkTreeIter *iter, const gchar* name, gint size)
+{
+  ICON_REQUEST *request = NULL;
+  gpointer icon = NULL;
+  gchar *key = NULL;
+
+  if(!m_IconPool || !name)
+    return;
+
+  key = make_icon_key(name, size);
+
+  if( g_hash_table_lookup_extended(m_IconInternTable, key, NULL, &icon) )
+  {
+     /* Already loaded. If it could not be loaded, the row keeps the placeholder. */
+     if(icon)
+       gtk_tree_store_set(m_TreeStore, iter, COLUMN_ICON, icon, -1);
+
+     m_nIconDecodesSaved++;
+     g_free(key);
+     return;
+  }
+
+  request = (ICON_REQUEST*)g_hash_table_lookup(m_IconPending, key);
+
+  if(request)
+  {
+     /* The worker threads do not touch the rows, so it is safe to add one while the request is decoded. */
+     g_array_append_vals(request->iters, iter, 1);
+
+     if(request->preview)
+       gtk_tree_store_set(m_TreeStore, iter, COLUMN_ICON, request->preview, -1);
+
+     m_nIconDecodesSaved++;
+     g_free(key);
+     return;
+  }
+
+  request = g_slice_new0(ICON_REQUEST);
+  request->name = g_strdup(name);
+  request->size = size;
+  request->iters = g_array_new(FALSE, FALSE, sizeof(GtkTreeIter));
+  g_array_append_vals(request->iters, iter, 1);
+
+  /* GtkIconTheme is not thread safe, so the theme lookup is done here. It does not decode anything. */
+  request->theme_file = m_ResolveThemeIconFile(name, size);
+
+  /* Rasterizing a scalable image is by far the slowest decoding, a bitmap of the same icon is shown meanwhile. */
+  if( m_Options.defer_scalable_icons && is_scalable_icon_file(request->theme_file ? request->theme_file : name) )
+  {
+     request->scalable = true;
+     request->preview_file = m_LookupThemePreviewFile(name, size);
+  }
+
+  /* The table takes over the key. */
+  g_hash_table_insert(m_IconPending, key, request);
+
+  g_thread_pool_push(m_IconPool, request, NULL);
+}
+
+/*! \fn void CAppCatalog::m_ProcessIconRequest(ICON_REQUEST *request)
+    \brief To decode the icon of one request. It runs in a worker thread.
+
+    \param[in] request.
+*/
+void CAppCatalog::m_ProcessIconRequest(ICON_REQUEST *request)
+{
+  if( g_atomic_int_get(&m_bIconPipelineCancelled) )
+  {
+     free_icon_request(request);
+     return;
+  }
+
+  if(request->scalable && !request->rasterize)
+    request->icon = m_DecodeIconPreview(request);
+  else
+    request->icon = m_DecodeIcon(request->name, request->theme_file, request->size);
+
+  /* The handler id is only read and written under the lock of the queue, see m_ApplyIconResults().
+     Only the first result after the handler has drained the queue schedules a new one. */
+  g_async_queue_lock(m_IconResults);
+  g_async_queue_push_unlocked(m_IconResults, request);
+
+  if(!m_nIconIdleId)
+    m_nIconIdleId = g_idle_add(cb_apply_icon_results, this);
+
+  g_async_queue_unlock(m_IconResults);
+}
+
+/*! \fn gboolean CAppCatalog::m_ApplyIconResults(void)
+    \brief To move a batch of decoded icons into the tree store. It runs in the GTK main thread.
+
+    \param[in] NONE
+    \return TRUE if there are more decoded icons waiting, otherwise FALSE.
+*/
+gboolean CAppCatalog::m_ApplyIconResults(void)
+{
+  ICON_REQUEST *request = NULL;
+  GdkPixbuf *shared = NULL;
+  gchar *key = NULL;
+
+  for(int i = 0; i < ICON_RESULT_BATCH; i++)
+  {
+     request = (ICON_REQUEST*)g_async_queue_try_pop(m_IconResults);
+
+     if(!request)
+       break;
+
+     /* A row whose icon can not be loaded keeps the placeholder. */
+     if(request->icon)
+     {
+        for(guint n = 0; n < request->iters->len; n++)
+           gtk_tree_store_set(m_TreeStore, &g_array_index(request->iters, GtkTreeIter, n), COLUMN_ICON, request->icon, -1);
+     }
+
+     /* Only the preview is shown, the request stays pending until the icon is rasterized. */
+     if(request->scalable && !request->rasterize)
+     {
+        m_DeferIconRequest(request);
+        continue;
+     }
+
+     /* Later rows using the same icon share this one. The rows of a scalable icon which can not be rasterized
+        keep its preview, so do the later ones. */
+     shared = request->icon ? request->icon : request->preview;
+     key = make_icon_key(request->name, request->size);
+     g_hash_table_remove(m_IconPending, key);
+     g_hash_table_insert(m_IconInternTable, key, shared ? g_object_ref(shared) : NULL);
+     m_nIconGeneration++;
+     m_nIconDecodes++;
+
+     free_icon_request(request);
+  }
+
+  /* A worker seeing the id cleared schedules a new handler, so the queue is checked under the same lock. */
+  g_async_queue_lock(m_IconResults);
+
+  if( g_async_queue_length_unlocked(m_IconResults) > 0 )
+  {
+     g_async_queue_unlock(m_IconResults);
+     return true;
+  }
+
+  m_nIconIdleId = 0;
+  g_async_queue_unlock(m_IconResults);
+
+  return false;
+}
+
+/*! \fn GdkPixbuf* CAppCatalog::m_DecodeIconPreview(ICON_REQUEST *request)
+    \brief To get the icon of a scalable icon request from the on-disk icon cache, or else its bitmap preview.
+           It runs in a worker thread.
+
+    \param[in] request. Its "scalable" flag is cleared if the rasterized icon is found in the cache.
+    \return PixelBuffer object or NULL.
+*/
+GdkPixbuf* CAppCatalog::m_DecodeIconPreview(ICON_REQUEST *request)
+{
+  GdkPixbuf *icon = NULL;
+  gint64 spanStart = m_Profiler.m_Begin();
+
+  /* It was rasterized by an earlier run. */
+  icon = m_IconCache.m_Lookup(request->name, request->size);
+
+  if(icon)
+  {
+     request->scalable = false;
+     m_Profiler.m_Count(PROFILE_ICON_CACHE_HITS);
+     m_Profiler.m_End("icon cache lookup", spanStart);
+
+     return icon;
+  }
+
+  /* The preview is not stored in the cache, which keeps the rasterized icon under the same name. */
+  if(request->preview_file)
+  {
+     icon = load_theme_icon_file(request->preview_file, request->size);
+     m_Profiler.m_Count( icon ? PROFILE_ICON_DECODES : PROFILE_ICON_FAILED_OPENS );
+  }
+
+  m_Profiler.m_End("m_DecodeIconPreview", spanStart);
+
+  return icon;
+}
+
+/*! \fn void CAppCatalog::m_DeferIconRequest(ICON_REQUEST *request)
+    \brief To keep a scalable icon request, whose rows show the preview, until the other icons are decoded.
+           It runs in the GTK main thread.
+
+    \param[in] request. It stays in m_IconPending, so rows added meanwhile join it and get the preview.
+*/
+void CAppCatalog::m_DeferIconRequest(ICON_REQUEST *request)
+{
+  request->preview = request->icon;
+  request->icon = NULL;
+
+  g_queue_push_tail(m_DeferredIcons, request);
+
+  /* It runs when the main loop has nothing else to do, e.g. after the rows are drawn. */
+  if(!m_nDeferredIdleId)
+    m_nDeferredIdleId = g_idle_add_full(G_PRIORITY_LOW, cb_queue_deferred_icons, this, NULL);
+}
+
+/*! \fn gboolean CAppCatalog::m_QueueDeferredIcons(void)
+    \brief To queue the deferred scalable icons to the worker threads, behind the requests still waiting.
+           The rasterized icons are stored in the on-disk icon cache by m_DecodeIcon().
+
+    \param[in] NONE
+    \return FALSE to remove the idle handler.
+*/
+gboolean CAppCatalog::m_QueueDeferredIcons(void)
+{
+  ICON_REQUEST *request = NULL;
+
+  m_nDeferredIdleId = 0;
+
+  while( (request = (ICON_REQUEST*)g_queue_pop_head(m_DeferredIcons)) != NULL )
+  {
+     request->rasterize = true;
+     g_thread_pool_push(m_IconPool, request, NULL);
+  }
+
+  return false;
+}
+
+/*! \fn gboolean CAppCatalog::m_PopulateCategory(GtkTreeIter *iter)
+    \brief To create the children of a directory node which has only the dummy child created in lazy mode.
+           Its sub-directory nodes get their own dummy child.
+
+    \param[in] iter. The directory node.
+    \return TRUE if the node has children, otherwise FALSE.
+*/
+gboolean CAppCatalog::m_PopulateCategory(GtkTreeIter *iter)
+{
+  GtkTreeModel *model = GTK_TREE_MODEL(m_TreeStore);
+  GtkTreeIter dummyIter;
+  gpointer dirData = NULL;
+
+  if( !gtk_tree_model_iter_children(model, &dummyIter, iter) )
+    return false;
+
+  gtk_tree_model_get(model, iter, COLUMN_DIRDATA, &dirData, -1);
+
+  /* Already populated. */
+  if( !dirData || !m_IsDummyRow(&dummyIter) )
+    return true;
+
+  /* The children are inserted besides the dummy child, which is removed afterwards. */
+  if(m_bMenuFromSnapshot)
+    m_AddSnapshotNodes( iter, m_MenuSnapshot.m_GetCategoryIndex((const MENU_SNAPSHOT_CATEGORY*)dirData) );
+  else
+    m_AddAppsMenuDirectoryRows( iter, (GMenuTreeDirectory*)dirData );
+
+  gtk_tree_store_remove(m_TreeStore, &dummyIter);
+
+  return gtk_tree_model_iter_has_child(model, iter);
+}
+
+//----------------------------------- Menu Snapshot
+/*! \fn gboolean CAppCatalog::m_BuildAppsMenuFromSnapshot(void)
+    \brief To build the tree store(or the flat list model) from the menu snapshot instead of parsing the menu.
+
+    The node-data's strings are not copied, they point into the mapped snapshot. The GMenuTree object is loaded
+    by the menu loading thread afterwards, the first change of the menu builds the rows again from it.
+
+    \param[in] NONE
+    \return TRUE if the snapshot is fresh and the rows are built, otherwise FALSE.
+*/
+gboolean CAppCatalog::m_BuildAppsMenuFromSnapshot(void)
+{
+  const MENU_SNAPSHOT_CATEGORY *category = NULL;
+  GtkTreeIter iter;
+  gint64 spanStart = m_Profiler.m_Begin();
+  gboolean bFresh = m_MenuSnapshot.m_Load();
+
+  m_Profiler.m_End("menu snapshot load", spanStart);
+
+  if(!bFresh)
+    return false;
+
+  m_bMenuFromSnapshot = true;
+
+  /* The flat list has only the applications. */
+  if(m_Options.flat_list)
+  {
+     for(guint i = 0; i < m_MenuSnapshot.m_GetCategoryCount(); i++)
+     {
+        category = m_MenuSnapshot.m_GetCategory(i);
+
+        for(guint n = 0; n < category->n_entries; n++)
+        {
+           APP_ITEM_INFO *appInfo = m_NewSnapshotAppItemInfo( m_MenuSnapshot.m_GetEntry(category->first_entry + n) );
+
+           app_list_model_append(m_ListModel, appInfo->name, appInfo->icon ? appInfo->icon : DEFAULT_APP__MIME_ICON, appInfo);
+           m_Profiler.m_Count(PROFILE_ROWS_INSERTED);
+        }
+     }
+
+     return true;
+  }
+
+  /* The top-level directories, each one followed by its sub-directories. */
+  for(guint i = 0; i < m_MenuSnapshot.m_GetCategoryCount(); i = category->end)
+  {
+     category = m_MenuSnapshot.m_GetCategory(i);
+
+     m_InsertSnapshotCategoryRow(&iter, NULL, -1, category);
+
+     /* A dummy child makes the category expandable, the real ones are created by m_PopulateCategory(). */
+     if(m_Options.lazy_load)
+     {
+        if(category->n_items > 0)
+          gtk_tree_store_insert_with_values(m_TreeStore, NULL, &iter, -1, COLUMN_TEXT, NULL, -1);
+
+        continue;
+     }
+
+     m_AddSnapshotNodes(&iter, i);
+  }
+
+  return true;
+}
+
+/*! \fn void CAppCatalog::m_InsertSnapshotCategoryRow(GtkTreeIter *iter, GtkTreeIter *parent, gint position, const MENU_SNAPSHOT_CATEGORY *category)
+    \brief To insert the node of a directory of the menu snapshot.
+
+    \param[out] iter. The new node.
+    \param[in] parent. The parent directory node, NULL for a top-level one.
+    \param[in] position. The position among the parent's children, -1 to append.
+    \param[in] category.
+*/
+void CAppCatalog::m_InsertSnapshotCategoryRow(GtkTreeIter *iter, GtkTreeIter *parent, gint position,
+                                                     const MENU_SNAPSHOT_CATEGORY *category)
+{
+  /* The icon files of the snapshot spare the lookups of the rows' icons. */
+  if( m_MenuSnapshot.m_HasIconFiles() )
+    m_AddIconFiles( m_MenuSnapshot.m_GetString(category->icon), m_MenuSnapshot.m_GetString(category->icon_file),
+                    m_MenuSnapshot.m_GetString(category->show_file) );
+
+  m_InsertCategoryRow(iter, parent, position, m_MenuSnapshot.m_GetString(category->name), m_MenuSnapshot.m_GetString(category->icon),
+                      (gpointer)category);
+}
+
+/*! \fn void CAppCatalog::m_AddSnapshotNodes(GtkTreeIter *iter, guint index)
+    \brief To create the children of the node of a directory of the menu snapshot in menu order: its leaves and
+           its sub-directory nodes, at any depth(or only the direct ones with a dummy child in lazy mode).
+
+    \param[in] iter. The directory node.
+    \param[in] index. The index of the directory.
+*/
+void CAppCatalog::m_AddSnapshotNodes(GtkTreeIter *iter, guint index)
+{
+  const MENU_SNAPSHOT_CATEGORY *category = m_MenuSnapshot.m_GetCategory(index), *subCategory = NULL;
+  GtkTreeIter child;
+
+  if( G_UNLIKELY(!category) )
+    return;
+
+  for(guint n = 0; n < category->n_items; n++)
+  {
+     guint32 item = m_MenuSnapshot.m_GetItem(category->first_item + n);
+
+     if( !(item & MENU_SNAPSHOT_ITEM_DIRECTORY) )
+     {
+        m_InsertAppItemRow(&child, iter, -1, m_NewSnapshotAppItemInfo( m_MenuSnapshot.m_GetEntry(item) ));
+        continue;
+     }
+
+     /* The snapshot is validated: it is a direct sub-directory. */
+     subCategory = m_MenuSnapshot.m_GetCategory(item & ~MENU_SNAPSHOT_ITEM_DIRECTORY);
+
+     m_InsertSnapshotCategoryRow(&child, iter, -1, subCategory);
+
+     /* In lazy mode the children of the sub-directories are created on expansion. */
+     if(m_Options.lazy_load)
+     {
+        if(subCategory->n_items > 0)
+          gtk_tree_store_insert_with_values(m_TreeStore, NULL, &child, -1, COLUMN_TEXT, NULL, -1);
+
+        continue;
+     }
+
+     m_AddSnapshotNodes(&child, item & ~MENU_SNAPSHOT_ITEM_DIRECTORY);
+  }
+}
+
+/*! \fn APP_ITEM_INFO* CAppCatalog::m_NewSnapshotAppItemInfo(const MENU_SNAPSHOT_ENTRY *entry)
+    \brief To create the node-data of an application of the menu snapshot and make it searchable.
+
+    \param[in] entry.
+    \return The node-data. Its strings belong to the mapped snapshot, which is released in m_DeinitValue().
+*/
+APP_ITEM_INFO* CAppCatalog::m_NewSnapshotAppItemInfo(const MENU_SNAPSHOT_ENTRY *entry)
+{
+  APP_ITEM_INFO *appInfo = (APP_ITEM_INFO*)m_AppItemArena.m_Alloc( sizeof(APP_ITEM_INFO) );
+
+  appInfo->name = (gchar*)m_MenuSnapshot.m_GetString(entry->name);
+  appInfo->icon = (gchar*)m_MenuSnapshot.m_GetString(entry->icon);
+  appInfo->exec = (gchar*)m_MenuSnapshot.m_GetString(entry->exec);
+  appInfo->comment = (gchar*)m_MenuSnapshot.m_GetString(entry->comment);
+  appInfo->desktopfile = (gchar*)m_MenuSnapshot.m_GetString(entry->desktopfile);
+
+  /* The files are the ones of the name the row asks for, see m_WriteAppsMenuSnapshot(). */
+  if( m_MenuSnapshot.m_HasIconFiles() )
+    m_AddIconFiles( appInfo->icon ? appInfo->icon : DEFAULT_APP__MIME_ICON, m_MenuSnapshot.m_GetString(entry->icon_file),
+                    m_MenuSnapshot.m_GetString(entry->show_file) );
+
+  /* To make the application searchable. */
+  m_SearchIndex.m_Add(appInfo, appInfo->name, appInfo->comment, appInfo->exec);
+  m_PrepareExecTemplate(appInfo->exec);
+
+  return appInfo;
+}
+
+/*! \fn void CAppCatalog::m_WriteAppsMenuSnapshot(void)
+    \brief To write the parsed menu: the directories, their shown applications and the icon files.
+
+    \param[in] NONE
+    \return NONE
+*/
+void CAppCatalog::m_WriteAppsMenuSnapshot(void)
+{
+  GSList *directoryList = NULL, *item = NULL;
+  gint64 spanStart = m_Profiler.m_Begin();
+
+  if( G_UNLIKELY(!m_RootDir) )
+    return;
+
+  m_MenuSnapshot.m_BeginWrite();
+
+  directoryList = gmenu_tree_directory_get_contents( m_RootDir );
+
+  for(item = directoryList; item; item = item->next)
+  {
+     GMenuTreeDirectory *dir = (GMenuTreeDirectory*)item->data;
+
+     if( gmenu_tree_item_get_type((GMenuTreeItem*)dir) == GMENU_TREE_ITEM_DIRECTORY )
+       m_WriteSnapshotDirectory(dir, MENU_SNAPSHOT_NO_PARENT);
+
+     gmenu_tree_item_unref(item->data);
+  }
+
+  g_slist_free(directoryList);
+
+  m_MenuSnapshot.m_Commit();
+
+  m_Profiler.m_End("menu snapshot write", spanStart);
+}
+
+/*! \fn guint32 CAppCatalog::m_WriteSnapshotDirectory(GMenuTreeDirectory *dir, guint32 parent)
+    \brief To add a directory of the parsed menu to the snapshot: its shown applications, then its sub-directories,
+           then all of them in menu order.
+
+    \param[in] dir.
+    \param[in] parent. The index of the parent directory, MENU_SNAPSHOT_NO_PARENT for a top-level one.
+    \return The index of the directory.
+*/
+guint32 CAppCatalog::m_WriteSnapshotDirectory(GMenuTreeDirectory *dir, guint32 parent)
+{
+  GSList *itemList = gmenu_tree_directory_get_contents(dir), *item = NULL;
+  const ICON_FILES *files = m_GetIconFiles( gmenu_tree_directory_get_icon(dir) );
+  GArray *items = g_array_new(FALSE, FALSE, sizeof(guint32));
+  GArray *dirSlots = g_array_new(FALSE, FALSE, sizeof(guint));  /* The items of the sub-directories, in menu order. */
+  guint32 index = 0, nItem = 0;
+  guint nDir = 0;
+
+  index = m_MenuSnapshot.m_AddCategory( gmenu_tree_directory_get_name(dir), gmenu_tree_directory_get_icon(dir),
+                                        files ? files->theme_file : NULL, files ? files->show_file : NULL, parent );
+
+  /* The entries added belong to the last added directory, so they are added before any sub-directory. */
+  for(item = itemList; item; item = item->next)
+  {
+     GMenuTreeEntry *entry = (GMenuTreeEntry*)item->data;
+     const gchar *icon_name = NULL;
+
+     if( gmenu_tree_item_get_type((GMenuTreeItem*)entry) == GMENU_TREE_ITEM_DIRECTORY )
+     {
+        g_array_append_val(dirSlots, items->len);
+        g_array_set_size(items, items->len + 1);
+        continue;
+     }
+
+     if( gmenu_tree_item_get_type((GMenuTreeItem*)entry) != GMENU_TREE_ITEM_ENTRY ||
+         gmenu_tree_entry_get_is_nodisplay(entry) || gmenu_tree_entry_get_is_excluded(entry) )
+       continue;
+
+     /* The icon files of the name the row asks the pipeline for. */
+     icon_name = gmenu_tree_entry_get_icon(entry);
+     files = m_GetIconFiles( icon_name ? icon_name : DEFAULT_APP__MIME_ICON );
+     nItem = m_MenuSnapshot.m_AddEntry( gmenu_tree_entry_get_name(entry), icon_name, files->theme_file, files->show_file,
+                                        gmenu_tree_entry_get_exec(entry), gmenu_tree_entry_get_comment(entry),
+                                        gmenu_tree_entry_get_desktop_file_path(entry) );
+     g_array_append_val(items, nItem);
+  }
+
+  for(item = itemList; item; item = item->next)
+  {
+     if( gmenu_tree_item_get_type((GMenuTreeItem*)item->data) != GMENU_TREE_ITEM_DIRECTORY )
+       continue;
+
+     nItem = m_WriteSnapshotDirectory( (GMenuTreeDirectory*)item->data, index );
+     g_array_index(items, guint32, g_array_index(dirSlots, guint, nDir++)) = nItem | MENU_SNAPSHOT_ITEM_DIRECTORY;
+  }
+
+  m_MenuSnapshot.m_SetCategoryItems(index, items);
+
+  g_array_free(dirSlots, TRUE);
+  g_array_free(items, TRUE);
+  g_slist_free_full(itemList, (GDestroyNotify)gmenu_tree_item_unref);
+
+  return index;
+}
+
+//----------------------------------- Catalog Daemon
+/*! \fn gboolean CAppCatalog::m_BuildAppsMenuFromDaemon(void)
+    \brief To build the tree store(or the flat list model) from the records of a running catalog daemon.
+
+    The daemon's decoded icons are mapped from its shared segment and interned, so the rows using them decode
+    nothing. The icon files come with the records, so choosing an application looks nothing up either.
+    No GMenuTree object is loaded, the daemon follows the changes of the menu.
+
+    \param[in] NONE
+    \return TRUE if the daemon answered and the rows are built, otherwise FALSE.
+*/
+gboolean CAppCatalog::m_BuildAppsMenuFromDaemon(void)
+{
+  CCatalogClient client;
+  GPtrArray *records = NULL;
+  GHashTable *icons = NULL;
+  GHashTableIter hashIter;
+  GArray *nodes = NULL;
+  gpointer key = NULL, value = NULL;
+  gint size = 0;
+  gint64 spanStart = m_Profiler.m_Begin();
+
+  if( !client.m_Connect() )
+  {
+     m_Profiler.m_End("catalog daemon connect", spanStart);
+     return false;
+  }
+
+  records = g_ptr_array_new_with_free_func( (GDestroyNotify)g_strfreev );
+
+  if( !client.m_List(records) )
+  {
+     g_ptr_array_free(records, TRUE);
+     m_Profiler.m_End("catalog daemon list", spanStart);
+     return false;
+  }
+
+  icons = client.m_MapIcons(&size);
+
+  if(icons)
+  {
+     if(size == IMG_SIZE)
+     {
+        g_hash_table_iter_init(&hashIter, icons);
+
+        while( g_hash_table_iter_next(&hashIter, &key, &value) )
+          g_hash_table_insert( m_IconInternTable, make_icon_key((const gchar*)key, IMG_SIZE), g_object_ref(value) );
+
+        m_nIconGeneration++;
+     }
+
+     g_hash_table_destroy(icons);
+  }
+
+  m_bMenuFromDaemon = true;
+
+  /* The last category node of every depth, the records come in pre-order. */
+  nodes = g_array_new(FALSE, FALSE, sizeof(GtkTreeIter));
+
+  for(guint i = 0; i < records->len; i++)
+  {
+     gchar **fields = (gchar**)g_ptr_array_index(records, i);
+     guint nFields = g_strv_length(fields);
+     guint depth = 0;
+
+     if( nFields == N_CATALOG_CATEGORY_FIELDS && strcmp(fields[CATALOG_FIELD_TYPE], CATALOG_RECORD_CATEGORY) == 0 &&
+         catalog_depth(fields[CATALOG_CATEGORY_DEPTH], &depth) && depth <= nodes->len )
+     {
+        const gchar *icon_name = catalog_field(fields[CATALOG_CATEGORY_ICON]);
+        GtkTreeIter iter;
+
+        m_AddIconFiles( icon_name, catalog_field(fields[CATALOG_CATEGORY_ICON_FILE]), catalog_field(fields[CATALOG_CATEGORY_SHOW_FILE]) );
+
+        /* The flat list has only the applications. */
+        if(m_Options.flat_list)
+        {
+           g_array_set_size(nodes, depth + 1);
+           continue;
+        }
+
+        /* The directory data of the row is its icon name, see m_GetCategoryIcon(). */
+        m_InsertCategoryRow( &iter, depth ? &g_array_index(nodes, GtkTreeIter, depth - 1) : NULL, -1,
+                             fields[CATALOG_CATEGORY_NAME], icon_name, m_AppItemArena.m_InternString(icon_name ? icon_name : "") );
+
+        g_array_set_size(nodes, depth + 1);
+        g_array_index(nodes, GtkTreeIter, depth) = iter;
+     }
+     else if( nFields == N_CATALOG_ENTRY_FIELDS && strcmp(fields[CATALOG_FIELD_TYPE], CATALOG_RECORD_ENTRY) == 0 &&
+              catalog_depth(fields[CATALOG_ENTRY_DEPTH], &depth) && depth < nodes->len )
+     {
+        APP_ITEM_INFO *appInfo = (APP_ITEM_INFO*)m_AppItemArena.m_Alloc( sizeof(APP_ITEM_INFO) );
+        const gchar *icon_name = NULL;
+
+        appInfo->name = m_AppItemArena.m_InternString( catalog_field(fields[CATALOG_ENTRY_NAME]) );
+        appInfo->icon = m_AppItemArena.m_InternString( catalog_field(fields[CATALOG_ENTRY_ICON]) );
+        appInfo->exec = m_AppItemArena.m_InternString( catalog_field(fields[CATALOG_ENTRY_EXEC]) );
+        appInfo->comment = m_AppItemArena.m_InternString( catalog_field(fields[CATALOG_ENTRY_COMMENT]) );
+        appInfo->desktopfile = m_AppItemArena.m_InternString( catalog_field(fields[CATALOG_ENTRY_DESKTOPFILE]) );
+
+        icon_name = appInfo->icon ? appInfo->icon : DEFAULT_APP__MIME_ICON;
+        m_AddIconFiles( icon_name, catalog_field(fields[CATALOG_ENTRY_ICON_FILE]), catalog_field(fields[CATALOG_ENTRY_SHOW_FILE]) );
+
+        /* To make the application searchable. */
+        m_SearchIndex.m_Add(appInfo, appInfo->name, appInfo->comment, appInfo->exec);
+        m_PrepareExecTemplate(appInfo->exec);
+
+        if(m_Options.flat_list)
+        {
+           app_list_model_append(m_ListModel, appInfo->name, icon_name, appInfo);
+           m_Profiler.m_Count(PROFILE_ROWS_INSERTED);
+        }
+        else
+        {
+           GtkTreeIter child;
+
+           m_InsertAppItemRow(&child, &g_array_index(nodes, GtkTreeIter, depth), -1, appInfo);
+        }
+     }
+  }
+
+  g_array_free(nodes, TRUE);
+  g_ptr_array_free(records, TRUE);
+
+  m_Profiler.m_End("menu from catalog daemon", spanStart);
+
+  return true;
+}
+
+/*! \fn const gchar* CAppCatalog::m_GetCategoryIcon(gpointer dirData)
+    \brief To get the icon name of a directory node from its directory data.
+
+    \param[in] dirData. The COLUMN_DIRDATA value of the node.
+    \return The icon name or NULL.
+*/
+const gchar* CAppCatalog::m_GetCategoryIcon(gpointer dirData)
+{
+  if(!dirData)
+    return NULL;
+
+  if(dirData == FREQUENT_CATEGORY_DATA)
+    return FREQUENT_CATEGORY_ICON;
+
+  if(m_bMenuFromDaemon)
+    return catalog_field( (const gchar*)dirData );
+
+  if(m_bMenuFromSnapshot)
+    return m_MenuSnapshot.m_GetString( ((const MENU_SNAPSHOT_CATEGORY*)dirData)->icon );
+
+  return gmenu_tree_directory_get_icon( (GMenuTreeDirectory*)dirData );
+}
+
+/*! \fn void CAppCatalog::m_WriteCatalogRecords(GString *out, const gchar *text)
+    \brief To write the "C" and "E" records of the catalog daemon, see CCatalogProtocol.h.
+
+    The tree store is walked in its order, a flat list has no categories and writes nothing.
+
+    \param[in] out. The records are appended.
+    \param[in] text. Only the applications containing it and the categories above them are written. NULL writes all.
+*/
+void CAppCatalog::m_WriteCatalogRecords(GString *out, const gchar *text)
+{
+  GHashTable *matches = NULL;
+  GArray *pending = NULL;
+
+  if( !m_TreeStore || gtk_tree_model_iter_n_children(GTK_TREE_MODEL(m_TreeStore), NULL) == 0 )
+    return;
+
+  /* In lazy mode only the expanded categories are created yet. */
+  if(m_Options.lazy_load)
+    m_PopulateAllCategories();
+
+  if(text)
+  {
+     matches = g_hash_table_new(g_direct_hash, g_direct_equal);
+     m_SearchIndex.m_Query(text, matches);
+  }
+
+  pending = g_array_new(FALSE, FALSE, sizeof(GtkTreeIter));
+
+  m_WriteCatalogNodes(out, NULL, 0, matches, pending);
+
+  g_array_free(pending, TRUE);
+
+  if(matches)
+    g_hash_table_destroy(matches);
+}
+
+/*! \fn void CAppCatalog::m_WriteCatalogNodes(GString *out, GtkTreeIter *parent, guint depth, GHashTable *matches, GArray *pending)
+    \brief To write the records of the children of a directory node, and of their descendants.
+
+    \param[in] out. The records are appended.
+    \param[in] parent. The directory node, NULL for the top-level nodes.
+    \param[in] depth. The depth of the children, 0 for the top-level nodes.
+    \param[in] matches. The found APP_ITEM_INFO objects, or NULL to write all.
+    \param[in,out] pending. When searching, the category nodes above not written yet: a category is written with
+                    the first application found under it.
+*/
+void CAppCatalog::m_WriteCatalogNodes(GString *out, GtkTreeIter *parent, guint depth, GHashTable *matches, GArray *pending)
+{
+  GtkTreeModel *model = GTK_TREE_MODEL(m_TreeStore);
+  GtkTreeIter child;
+
+  if( !gtk_tree_model_iter_children(model, &child, parent) )
+    return;
+
+  do
+  {
+     gpointer dirData = NULL, nodeData = NULL;
+
+     gtk_tree_model_get(model, &child, COLUMN_NODEDATA, &nodeData, COLUMN_DIRDATA, &dirData, -1);
+
+     if(dirData)
+     {
+        if(matches)
+          g_array_append_val(pending, child);
+        else
+          m_WriteCatalogCategory(out, &child, depth);
+
+        m_WriteCatalogNodes(out, &child, depth + 1, matches, pending);
+
+        /* Nothing found under it. */
+        if(pending->len > 0)
+          g_array_set_size(pending, pending->len - 1);
+     }
+     /* The dummy child of a lazy category has no node-data. */
+     else if( nodeData && depth > 0 && (!matches || g_hash_table_contains(matches, nodeData)) )
+     {
+        /* The pending categories are the innermost ones above the application. */
+        for(guint i = 0; i < pending->len; i++)
+          m_WriteCatalogCategory(out, &g_array_index(pending, GtkTreeIter, i), depth - pending->len + i);
+
+        g_array_set_size(pending, 0);
+
+        m_WriteCatalogEntry(out, (APP_ITEM_INFO*)nodeData, depth - 1);
+     }
+  } while( gtk_tree_model_iter_next(model, &child) );
+}
+
+/*! \fn void CAppCatalog::m_WriteCatalogCategory(GString *out, GtkTreeIter *iter, guint depth)
+    \brief To write the "C" record of a directory node.
+
+    \param[in] out. The record is appended.
+    \param[in] iter. The directory node.
+    \param[in] depth. 0 for a top-level node.
+*/
+void CAppCatalog::m_WriteCatalogCategory(GString *out, GtkTreeIter *iter, guint depth)
+{
+  gchar *name = NULL;
+  gpointer dirData = NULL;
+  const gchar *icon_name = NULL;
+  const ICON_FILES *files = NULL;
+
+  gtk_tree_model_get(GTK_TREE_MODEL(m_TreeStore), iter, COLUMN_TEXT, &name, COLUMN_DIRDATA, &dirData, -1);
+  icon_name = m_GetCategoryIcon(dirData);
+  files = m_GetIconFiles(icon_name);
+
+  g_string_append(out, CATALOG_RECORD_CATEGORY);
+  append_catalog_field(out, name);
+  append_catalog_field(out, icon_name);
+  append_catalog_field(out, files ? files->theme_file : NULL);
+  append_catalog_field(out, files ? files->show_file : NULL);
+  g_string_append_printf(out, "\t%u\n", depth);
+
+  g_free(name);
+}
+
+/*! \fn void CAppCatalog::m_WriteCatalogEntry(GString *out, APP_ITEM_INFO *appInfo, guint depth)
+    \brief To write the "E" record of an application.
+
+    \param[in] out. The record is appended.
+    \param[in] appInfo.
+    \param[in] depth. The depth of its category.
+*/
+void CAppCatalog::m_WriteCatalogEntry(GString *out, APP_ITEM_INFO *appInfo, guint depth)
+{
+  /* The files of the name the row asks for. */
+  const ICON_FILES *files = m_GetIconFiles( appInfo->icon ? appInfo->icon : DEFAULT_APP__MIME_ICON );
+
+  g_string_append(out, CATALOG_RECORD_ENTRY);
+  append_catalog_field(out, appInfo->name);
+  append_catalog_field(out, appInfo->icon);
+  append_catalog_field(out, appInfo->exec);
+  append_catalog_field(out, appInfo->comment);
+  append_catalog_field(out, appInfo->desktopfile);
+  append_catalog_field(out, files->theme_file);
+  append_catalog_field(out, files->show_file);
+  g_string_append_printf(out, "\t%u\n", depth);
+}
+
+/*! \fn void CAppCatalog::m_WriteIconFilesRecord(GString *out, const gchar *name)
+    \brief To write the "R" record of an icon name.
+
+    \param[in] out. The record is appended.
+    \param[in] name.
+*/
+void CAppCatalog::m_WriteIconFilesRecord(GString *out, const gchar *name)
+{
+  const ICON_FILES *files = m_GetIconFiles(name);
+
+  /* The client asks for a chosen application, so its shown file is resolved. */
+  g_string_append(out, CATALOG_RECORD_RESOLVE);
+  append_catalog_field(out, files ? files->theme_file : NULL);
+  append_catalog_field(out, files ? m_GetIconShowFile(name) : NULL);
+  g_string_append_c(out, '\n');
+}
+
+/*! \fn gint CAppCatalog::m_CollectInternedIcons(GHashTable *icons)
+    \brief To get the loaded icons of the rows' size.
+
+    \param[out] icons. Icon name -> GdkPixbuf, both owned by the interning table. They stay valid until
+                an icon is loaded or the table is cleared.
+    \return The size of the icons.
+*/
+gint CAppCatalog::m_CollectInternedIcons(GHashTable *icons)
+{
+  GHashTableIter hashIter;
+  gpointer key = NULL, value = NULL;
+  gchar *name = NULL;
+
+  g_hash_table_iter_init(&hashIter, m_IconInternTable);
+
+  while( g_hash_table_iter_next(&hashIter, &key, &value) )
+  {
+     /* The key is "size\nname", an icon which could not be loaded has no pixel buffer. */
+     if( !value || strtol((const gchar*)key, &name, 10) != IMG_SIZE || *name != '\n' )
+       continue;
+
+     g_hash_table_insert(icons, name + 1, value);
+  }
+
+  return IMG_SIZE;
+}
+
+//----------------------------------- Usage Log
+/*! \fn gboolean CAppCatalog::m_LogUsage(const gchar *desktopfile)
+    \brief To log the choice of an application if the usage_log option is set.
+
+    \param[in] desktopfile. The desktop entry file of the chosen application.
+    \return TRUE if the choice is logged, else FALSE.
+*/
+gboolean CAppCatalog::m_LogUsage(const gchar *desktopfile)
+{
+  if(!m_Options.usage_log)
+    return false;
+
+  return m_UsageLog.m_Append(desktopfile);
+}
+
+/*! \fn void CAppCatalog::m_AddFrequentCategory(void)
+    \brief To insert the "Frequently used" category as the first top-level node, with the applications of the
+           highest frecency scores.
+
+    Its applications are read from their desktop files, so it is shown before the menu is parsed. They are not in
+    the search index, the application is found in its menu category.
+
+    \param[in] NONE
+    \return NONE
+*/
+void CAppCatalog::m_AddFrequentCategory(void)
+{
+  GtkTreeIter iter, child;
+
+  if( !m_Options.usage_log || m_Options.flat_list || !m_TreeStore || m_UsageLog.m_GetEntryCount() == 0 )
+    return;
+
+  m_InsertCategoryRow(&iter, NULL, 0, _("Frequently used"), FREQUENT_CATEGORY_ICON, FREQUENT_CATEGORY_DATA);
+  m_AddFrequentRows(&iter);
+
+  /* None of them is installed anymore. */
+  if( !gtk_tree_model_iter_children(GTK_TREE_MODEL(m_TreeStore), &child, &iter) )
+    m_RemoveAppsMenuRow(&iter);
+}
+
+/*! \fn void CAppCatalog::m_AddFrequentRows(GtkTreeIter *iter)
+    \brief To create the leaves of the "Frequently used" category, the highest score first.
+
+    \param[in] iter. The category node.
+    \return NONE
+*/
+void CAppCatalog::m_AddFrequentRows(GtkTreeIter *iter)
+{
+  GPtrArray *entries = m_UsageLog.m_GetTopEntries(FREQUENT_CATEGORY_SIZE);
+  GtkTreeIter child;
+
+  for(guint n = 0; n < entries->len; n++)
+  {
+     APP_ITEM_INFO *appInfo = m_NewDesktopFileAppItemInfo( (const gchar*)g_ptr_array_index(entries, n) );
+
+     if(appInfo)
+       m_InsertAppItemRow(&child, iter, -1, appInfo);
+  }
+
+  g_ptr_array_free(entries, TRUE);
+}
+
+/*! \fn void CAppCatalog::m_UpdateFrequentCategory(void)
+    \brief To create the leaves of the "Frequently used" category again after a choice or a menu change.
+           The node-data of the old leaves is given back to the arena and reused by the new ones.
+
+    \param[in] NONE
+    \return NONE
+*/
+void CAppCatalog::m_UpdateFrequentCategory(void)
+{
+  GtkTreeIter iter, child;
+
+  if( !m_Options.usage_log || m_Options.flat_list || !m_TreeStore )
+    return;
+
+  if( !m_FindFrequentCategory(&iter) )
+  {
+     m_AddFrequentCategory();
+     return;
+  }
+
+  while( gtk_tree_model_iter_children(GTK_TREE_MODEL(m_TreeStore), &child, &iter) )
+    m_RemoveAppsMenuRow(&child);
+
+  m_AddFrequentRows(&iter);
+
+  if( !gtk_tree_model_iter_children(GTK_TREE_MODEL(m_TreeStore), &child, &iter) )
+    m_RemoveAppsMenuRow(&iter);
+}
+
+/*! \fn gboolean CAppCatalog::m_FindFrequentCategory(GtkTreeIter *iter)
+    \brief To find the node of the "Frequently used" category.
+
+    \param[out] iter.
+    \return TRUE or FALSE
+*/
+gboolean CAppCatalog::m_FindFrequentCategory(GtkTreeIter *iter)
+{
+  GtkTreeModel *model = GTK_TREE_MODEL(m_TreeStore);
+  gboolean bValid = gtk_tree_model_get_iter_first(model, iter);
+
+  for(; bValid; bValid = gtk_tree_model_iter_next(model, iter))
+  {
+     gpointer dirData = NULL;
+
+     gtk_tree_model_get(model, iter, COLUMN_DIRDATA, &dirData, -1);
+
+     if(dirData == FREQUENT_CATEGORY_DATA)
+       return true;
+  }
+
+  return false;
+}
+
+/*! \fn APP_ITEM_INFO* CAppCatalog::m_NewDesktopFileAppItemInfo(const gchar *desktopfile)
+    \brief To create the node-data of an application from its desktop file, without the menu.
+
+    \param[in] desktopfile. The desktop file path.
+    \return The node-data owned by m_AppItemArena, or NULL if the file can not be read or the application is hidden.
+*/
+APP_ITEM_INFO* CAppCatalog::m_NewDesktopFileAppItemInfo(const gchar *desktopfile)
+{
+  GKeyFile *keyFile = g_key_file_new();
+  APP_ITEM_INFO *appInfo = NULL;
+  gchar *name = NULL, *icon = NULL, *exec = NULL, *comment = NULL;
+
+  if( !g_key_file_load_from_file(keyFile, desktopfile, G_KEY_FILE_NONE, NULL) ||
+      g_key_file_get_boolean(keyFile, G_KEY_FILE_DESKTOP_GROUP, G_KEY_FILE_DESKTOP_KEY_HIDDEN, NULL) ||
+      g_key_file_get_boolean(keyFile, G_KEY_FILE_DESKTOP_GROUP, G_KEY_FILE_DESKTOP_KEY_NO_DISPLAY, NULL) )
+  {
+     g_key_file_free(keyFile);
+     return NULL;
+  }
+
+  name = g_key_file_get_locale_string(keyFile, G_KEY_FILE_DESKTOP_GROUP, G_KEY_FILE_DESKTOP_KEY_NAME, NULL, NULL);
+  icon = g_key_file_get_string(keyFile, G_KEY_FILE_DESKTOP_GROUP, G_KEY_FILE_DESKTOP_KEY_ICON, NULL);
+  exec = g_key_file_get_string(keyFile, G_KEY_FILE_DESKTOP_GROUP, G_KEY_FILE_DESKTOP_KEY_EXEC, NULL);
+  comment = g_key_file_get_locale_string(keyFile, G_KEY_FILE_DESKTOP_GROUP, G_KEY_FILE_DESKTOP_KEY_COMMENT, NULL, NULL);
+
+  if(name && exec)
+  {
+     appInfo = (APP_ITEM_INFO*)m_AppItemArena.m_Alloc( sizeof(APP_ITEM_INFO) );
+     appInfo->name = m_AppItemArena.m_InternString(name);
+     appInfo->icon = m_AppItemArena.m_InternString(icon);
+     appInfo->exec = m_AppItemArena.m_InternString(exec);
+     appInfo->comment = m_AppItemArena.m_InternString(comment);
+     appInfo->desktopfile = m_AppItemArena.m_InternString(desktopfile);
+
+     m_PrepareExecTemplate(appInfo->exec);
+  }
+
+  g_free(name);
+  g_free(icon);
+  g_free(exec);
+  g_free(comment);
+  g_key_file_free(keyFile);
+
+  return appInfo;
+}
+
+//----------------------------------- Launcher
+/*! \fn void CAppCatalog::m_PrepareExecTemplate(const gchar *exec)
+    \brief To tokenize the command of a node-data once, when it is created, so launching it does not parse it.
+
+    \param[in] exec. The "Exec" string of the node-data, a command is looked up by this very string.
+    \return NONE
+*/
+void CAppCatalog::m_PrepareExecTemplate(const gchar *exec)
+{
+  EXEC_TEMPLATE *tmpl = NULL, *parsed = NULL;
+
+  if( !exec || g_hash_table_lookup_extended(m_ExecTemplates, exec, NULL, NULL) )
+    return;
+
+  /* An invalid command is kept as NULL, so it is not parsed again. */
+  if( (parsed = CExecTemplate::m_Parse(exec, NULL)) )
+  {
+     tmpl = (EXEC_TEMPLATE*)m_AppItemArena.m_Alloc(parsed->size);
+     memcpy(tmpl, parsed, parsed->size);
+     g_free(parsed);
+  }
+
+  g_hash_table_insert(m_ExecTemplates, (gpointer)exec, tmpl);
+}
+
+/*! \fn const EXEC_TEMPLATE* CAppCatalog::m_GetExecTemplate(APP_ITEM_INFO *appInfo)
+    \brief To get the tokenized command of a node-data.
+
+    \param[in] appInfo. A node-data of the rows of this catalog.
+    \return The template, owned by the arena. NULL if the command is invalid.
+*/
+const EXEC_TEMPLATE* CAppCatalog::m_GetExecTemplate(APP_ITEM_INFO *appInfo)
+{
+  if(!appInfo || !appInfo->exec)
+    return NULL;
+
+  /* A node-data created before it could be prepared is tokenized now. */
+  m_PrepareExecTemplate(appInfo->exec);
+
+  return (const EXEC_TEMPLATE*)g_hash_table_lookup(m_ExecTemplates, appInfo->exec);
+}
+
+//----------------------------------- Flat List Mode
+/*! \fn void CAppCatalog::m_AddAppsMenuListRows(GMenuTreeDirectory *appsDir)
+    \brief To append the applications of a top-level directory, including its sub-directories, to the flat list model.
+
+    \param[in] appsDir.
+*/
+void CAppCatalog::m_AddAppsMenuListRows(GMenuTreeDirectory *appsDir)
+{
+  GPtrArray *entries = g_ptr_array_new();
+
+  collect_directory_entries(appsDir, entries);
+
+  for(guint i = 0; i < entries->len; i++)
+  {
+     GMenuTreeEntry *entry = (GMenuTreeEntry*)g_ptr_array_index(entries, i);
+     APP_ITEM_INFO *appInfo = m_NewAppItemInfo(entry);
+
+     /* Nothing but the record is stored, the icon is loaded when the row is drawn. */
+     app_list_model_append(m_ListModel, appInfo->name, appInfo->icon ? appInfo->icon : DEFAULT_APP__MIME_ICON, appInfo);
+     m_Profiler.m_Count(PROFILE_ROWS_INSERTED);
+
+     gmenu_tree_item_unref(entry);
+  }
+
+  g_ptr_array_free(entries, TRUE);
+}
+
+/*! \fn void CAppCatalog::m_ReloadAppsMenuList(GMenuTreeDirectory *newRootDir)
+    \brief To rebuild the flat list model after the applications menu has changed.
+           The rows are only records, so building them again is cheaper than comparing them. Their node-data
+           is released with them.
+
+    \param[in] newRootDir. The root directory of the reloaded menu. Its reference is taken over. If it is NULL,
+                the list is left empty.
+*/
+void CAppCatalog::m_ReloadAppsMenuList(GMenuTreeDirectory *newRootDir)
+{
+  GSList *directoryList = NULL, *item = NULL;
+
+  for(gint row = 0; row < app_list_model_get_n_rows(m_ListModel); row++)
+    m_SearchIndex.m_Remove( app_list_model_get_node_data(m_ListModel, row) );
+
+  app_list_model_clear(m_ListModel);
+
+  /* The list held the only node-data, the new rows start an empty arena. */
+  g_hash_table_remove_all(m_ExecTemplates);
+  m_AppItemArena.m_Clear();
+
+  directoryList = newRootDir ? gmenu_tree_directory_get_contents( newRootDir ) : NULL;
+
+  for(item = directoryList; item; item = item->next)
+  {
+     if( gmenu_tree_item_get_type((GMenuTreeItem*)item->data) == GMENU_TREE_ITEM_DIRECTORY )
+       m_AddAppsMenuListRows( (GMenuTreeDirectory*)item->data );
+
+     gmenu_tree_item_unref(item->data);
+  }
+
+  g_slist_free(directoryList);
+
+  if(m_RootDir)
+    gmenu_tree_item_unref(m_RootDir);
+
+  m_RootDir = newRootDir;
+
+  m_NotifyViews(APP_CATALOG_ROWS_CHANGED);
+}
+
+/*! \fn GdkPixbuf* CAppCatalog::m_LoadListIcon(const gchar *icon_name)
+    \brief To load the icon of a flat list row. It is not shared with other rows, so it is released
+           as soon as the model drops it; only the fallback icon is shared.
+
+    \param[in] icon_name.
+    \return PixelBuffer object owned by the caller.
+*/
+GdkPixbuf* CAppCatalog::m_LoadListIcon(const gchar *icon_name)
+{
+  GdkPixbuf *icon = NULL;
+  gchar *key = make_icon_key(icon_name, IMG_SIZE);
+
+  /* Only the icons mapped from the catalog daemon are interned in flat list mode. */
+  icon = (GdkPixbuf*)g_hash_table_lookup(m_IconInternTable, key);
+  g_free(key);
+
+  if(icon)
+    return (GdkPixbuf*)g_object_ref(icon);
+
+  icon = m_LoadIconUnshared(icon_name, IMG_SIZE);
+
+  if( G_UNLIKELY(!icon) )
+    icon = m_LoadIcon(DEFAULT_APP_ICON, IMG_SIZE, TRUE);
+
+  return icon;
+}
+
+/*! \fn void CAppCatalog::m_PopulateAllCategories(void)
+    \brief To create the children of all categories not populated yet in lazy mode, at any depth.
+
+    \param[in] NONE
+    \return NONE
+*/
+void CAppCatalog::m_PopulateAllCategories(void)
+{
+  if(m_TreeStore)
+    m_PopulateCategories(NULL);
+}
+
+/*! \fn void CAppCatalog::m_PopulateCategories(GtkTreeIter *parent)
+    \brief To create the children of the directory nodes under a node, and of their sub-directory nodes.
+
+    \param[in] parent. NULL for the top-level nodes.
+    \return NONE
+*/
+void CAppCatalog::m_PopulateCategories(GtkTreeIter *parent)
+{
+  GtkTreeModel *model = GTK_TREE_MODEL(m_TreeStore);
+  GtkTreeIter iter;
+
+  if( !gtk_tree_model_iter_children(model, &iter, parent) )
+    return;
+
+  do
+  {
+     gpointer dirData = NULL;
+
+     gtk_tree_model_get(model, &iter, COLUMN_DIRDATA, &dirData, -1);
+
+     if(!dirData)
+       continue;
+
+     m_PopulateCategory(&iter);
+     m_PopulateCategories(&iter);
+  } while( gtk_tree_model_iter_next(model, &iter) );
+}
+
+/*! \fn gint CAppCatalog::m_DumpAppsMenu(FILE *stream, APPCHOOSER_DUMP_FORMAT format)
+    \brief To write the flattened application items(APP_ITEM_INFO) of the main application menu.
+
+    It only reads the menu with GNOME Menus, so neither gtk_init() nor a display is needed and no icon is loaded.
+    Each record has the top-level category, name, exec, icon, comment and desktopfile fields.
+
+    \param[in] stream. The output stream, e.g. stdout.
+    \param[in] format. JSON Lines or TSV.
+    \return The number of written records, or -1 if the menu can not be loaded.
+*/
+gint CAppCatalog::m_DumpAppsMenu(FILE *stream, APPCHOOSER_DUMP_FORMAT format)
+{
+  GMenuTree *menuTree = NULL;
+  GMenuTreeDirectory *rootDir = NULL;
+  GSList *directoryList = NULL, *item = NULL;
+  gint nCount = 0;
+
+  g_mutex_lock(&menuParseMutex);
+  menuTree = gmenu_tree_lookup( APPLICATIONS_MENU, GMENU_TREE_FLAGS_NONE );
+  rootDir = menuTree ? gmenu_tree_get_root_directory( menuTree ) : NULL;
+  g_mutex_unlock(&menuParseMutex);
+
+  if( G_UNLIKELY(!menuTree) )
+    return -1;
+
+  if( G_UNLIKELY(!rootDir) )
+  {
+     gmenu_tree_unref(menuTree);
+     return -1;
+  }
+
+  if(format == APPCHOOSER_DUMP_TSV)
+    fputs("category\tname\texec\ticon\tcomment\tdesktopfile\n", stream);
+
+  directoryList = gmenu_tree_directory_get_contents( rootDir );
+
+  for(item = directoryList; item; item = item->next)
+  {
+     GMenuTreeDirectory *tmpDir = (GMenuTreeDirectory*)item->data;
+
+     if( gmenu_tree_item_get_type((GMenuTreeItem*)tmpDir) == GMENU_TREE_ITEM_DIRECTORY )
+       m_DumpAppsMenuDirectory(stream, format, gmenu_tree_directory_get_name(tmpDir), tmpDir, nCount);
+
+     gmenu_tree_item_unref(tmpDir);
+  }
+
+  g_slist_free(directoryList);
+  gmenu_tree_item_unref(rootDir);
+  gmenu_tree_unref(menuTree);
+
+  return nCount;
+}
+
+/*! \fn void CAppCatalog::m_DumpAppsMenuDirectory(FILE *stream, APPCHOOSER_DUMP_FORMAT format, const gchar *category, GMenuTreeDirectory *appsDir, gint &nCount)
+    \brief To write the application items of a directory and, recursively, of its sub-directories.
+
+    The same items m_AddAppsMenuDirectoryRows() shows are written, all under the top-level category.
+
+    \param[in] stream.
+    \param[in] format.
+    \param[in] category. The name of the top-level directory.
+    \param[in] appsDir.
+    \param[in,out] nCount. The number of written records.
+*/
+void CAppCatalog::m_DumpAppsMenuDirectory(FILE *stream, APPCHOOSER_DUMP_FORMAT format, const gchar *category,
+                                                 GMenuTreeDirectory *appsDir, gint &nCount)
+{
+  GSList *itemList = gmenu_tree_directory_get_contents(appsDir), *item = NULL;
+
+  for(item = itemList; item; item = item->next)
+  {
+     GMenuTreeItemType type = gmenu_tree_item_get_type( (GMenuTreeItem*)item->data );
+
+     if( type == GMENU_TREE_ITEM_DIRECTORY )
+       m_DumpAppsMenuDirectory(stream, format, category, (GMenuTreeDirectory*)item->data, nCount);
+     else if( type == GMENU_TREE_ITEM_ENTRY )
+     {
+        GMenuTreeEntry *entry = (GMenuTreeEntry*)item->data;
+        const gchar *fields[6];
+
+        if( !gmenu_tree_entry_get_is_nodisplay(entry) && !gmenu_tree_entry_get_is_excluded(entry) )
+        {
+           fields[0] = category;
+           fields[1] = gmenu_tree_entry_get_name(entry);
+           fields[2] = gmenu_tree_entry_get_exec(entry);
+           fields[3] = gmenu_tree_entry_get_icon(entry);
+           fields[4] = gmenu_tree_entry_get_comment(entry);
+           fields[5] = gmenu_tree_entry_get_desktop_file_path(entry);
+
+           if(format == APPCHOOSER_DUMP_TSV)
+           {
+              for(int i = 0; i < 6; i++)
+              {
+                 if(i)
+                   fputc('\t', stream);
+
+                 write_tsv_field(stream, fields[i]);
+              }
+           }
+           else
+           {
+              static const char *keys[6] = { "category", "name", "exec", "icon", "comment", "desktopfile" };
+
+              fputc('{', stream);
+
+              for(int i = 0; i < 6; i++)
+              {
+                 fprintf(stream, "%s\"%s\":", i ? "," : "", keys[i]);
+
+                 if(fields[i])
+                   write_json_string(stream, fields[i]);
+                 else
+                   fputs("null", stream);
+              }
+
+              fputc('}', stream);
+           }
+
+           fputc('\n', stream);
+           nCount++;
+        }
+     }
+
+     gmenu_tree_item_unref(item->data);
+  }
+
+  g_slist_free(itemList);
+}
+
+/*! \fn GdkPixbuf* CAppCatalog::m_LoadIcon(const gchar* name, gint size, gboolean use_fallback)
+    \brief To load a icon's image contents.
+
+    \param[in] name.
+    \param[in] size. 
+    \param[in] use_fallback.
+    \return PixelBuffer object representing the designated icon.
+*/
+GdkPixbuf* CAppCatalog::m_LoadIcon(const gchar* name, gint size, gboolean use_fallback)
+{
+  GdkPixbuf *icon = NULL;
+  gint64 spanStart = m_Profiler.m_Begin();
+
+  if(name)
+    icon = m_LoadIconByName(name, size);
+	
+  if(G_UNLIKELY(!icon) && use_fallback)  /* fallback to generic icon */
+  {
+     icon = m_LoadIconByName(DEFAULT_APP_ICON, size);
+
+     if( G_UNLIKELY(!icon) )  /* fallback to generic icon */
+       icon = m_LoadIconByName(DEFAULT_APP__MIME_ICON, size );
+  }
+
+  m_Profiler.m_End("m_LoadIcon", spanStart);
+	
+  return icon;
+}
+
+/*! \fn GdkPixbuf* CAppCatalog::m_LoadIconByName(const gchar* name, gint size)
+    \brief To load a icon's image contents from the on-disk icon cache, or decode it and add it to the cache.
+
+    An icon is loaded once per name and size, later calls share the same pixel buffer.
+
+    \param[in] name. The icon name, the basename of an icon file or the full name of an icon file.
+    \param[in] size. 
+    \return PixelBuffer object representing the designated icon.
+*/
+GdkPixbuf* CAppCatalog::m_LoadIconByName(const gchar* name, gint size)
+{
+  gchar *key = NULL;
+  gpointer interned = NULL;
+  GdkPixbuf *icon = NULL;
+
+  /* Rows using the same icon share one pixel buffer. */
+  key = make_icon_key(name, size);
+
+  if( g_hash_table_lookup_extended(m_IconInternTable, key, NULL, &interned) )
+  {
+     m_nIconDecodesSaved++;
+     g_free(key);
+
+     return interned ? (GdkPixbuf*)g_object_ref(interned) : NULL;
+  }
+
+  icon = m_LoadIconUnshared(name, size);
+
+  /* The table takes over the key. */
+  g_hash_table_insert(m_IconInternTable, key, icon ? g_object_ref(icon) : NULL);
+  m_nIconGeneration++;
+  m_nIconDecodes++;
+
+  return icon;
+}
+
+/*! \fn GdkPixbuf* CAppCatalog::m_LoadIconUnshared(const gchar* name, gint size)
+    \brief To load a icon's image contents from the on-disk icon cache, or decode it and add it to the cache,
+           without sharing it with other rows.
+
+    \param[in] name. The icon name, the basename of an icon file or the full name of an icon file.
+    \param[in] size. 
+    \return PixelBuffer object or NULL.
+*/
+GdkPixbuf* CAppCatalog::m_LoadIconUnshared(const gchar* name, gint size)
+{
+  gchar *theme_file = NULL, *icon_name = NULL, *suffix = NULL;
+  GdkPixbuf *icon = NULL;
+
+  if( G_UNLIKELY(!name) )
+    return NULL;
+
+  theme_file = m_ResolveThemeIconFile(name, size);
+  icon = m_DecodeIcon(name, theme_file, size);
+
+  /* The theme has no file for it, but it could still be one of the built-in icons. */
+  if( G_UNLIKELY(!icon && !theme_file) && !g_path_is_absolute(name) )
+  {
+     suffix = strchr((char*)name, '.' );
+     icon_name = suffix ? g_strndup(name, (suffix-name) ) : g_strdup(name);
+     icon = m_LoadThemeIcon( gtk_icon_theme_get_default(), icon_name, size );
+     g_free( icon_name );
+  }
+
+  g_free(theme_file);
+
+  return icon;
+}
+
+/*! \fn gchar* CAppCatalog::m_ResolveThemeIconFile(const gchar* name, gint size)
+    \brief To get the image file of an icon in the current icon theme. This must run in the GTK main thread.
+
+    The files of the rows' size come from m_GetIconFiles(), so every icon name is looked up once.
+
+    \param[in] name. The icon name or the basename of an icon file.
+    \param[in] size.
+    \return Newly allocated full name of the image file, or NULL if it is not found or it is a built-in icon.
+*/
+gchar* CAppCatalog::m_ResolveThemeIconFile(const gchar* name, gint size)
+{
+  if( G_UNLIKELY(!name) || g_path_is_absolute(name) )
+    return NULL;
+
+  if(size == IMG_SIZE)
+    return g_strdup( m_GetIconFiles(name)->theme_file );
+
+  return m_LookupThemeIconFile(name, size);
+}
+
+/*! \fn gchar* CAppCatalog::m_LookupThemeIconFile(const gchar* name, gint size)
+    \brief To look up the image file of an icon in the current icon theme. This must run in the GTK main thread.
+
+    If the name has a file extension, the extension is removed before looking it up in the icon theme.
+
+    \param[in] name. The icon name or the basename of an icon file.
+    \param[in] size.
+    \return Newly allocated full name of the image file, or NULL if it is not found or it is a built-in icon.
+*/
+gchar* CAppCatalog::m_LookupThemeIconFile(const gchar* name, gint size)
+{
+  GtkIconInfo *info = NULL;
+  gchar *icon_name = NULL, *suffix = NULL, *file = NULL;
+  gint64 spanStart = 0;
+
+  if( G_UNLIKELY(!name) || g_path_is_absolute(name) )
+    return NULL;
+
+  suffix = strchr((char*)name, '.' );
+  icon_name = suffix ? g_strndup(name, (suffix-name) ) : g_strdup(name);
+
+  spanStart = m_Profiler.m_Begin();
+  info = gtk_icon_theme_lookup_icon( gtk_icon_theme_get_default(), icon_name, size, GTK_ICON_LOOKUP_USE_BUILTIN );
+  m_Profiler.m_End("icon theme lookup", spanStart);
+  g_free(icon_name);
+
+  if( G_UNLIKELY(!info) )
+    return NULL;
+
+  file = g_strdup( gtk_icon_info_get_filename(info) );
+  gtk_icon_info_free(info);
+
+  return file;
+}
+
+/*! \fn gchar* CAppCatalog::m_LookupThemePreviewFile(const gchar* name, gint size)
+    \brief To look up a bitmap image of an icon in the current icon theme, shown until its scalable image is
+           rasterized. This must run in the GTK main thread.
+
+    \param[in] name. The icon name or the basename of an icon file.
+    \param[in] size.
+    \return Newly allocated full name of the image file, or NULL if the theme has no bitmap of the icon.
+*/
+gchar* CAppCatalog::m_LookupThemePreviewFile(const gchar* name, gint size)
+{
+  GtkIconInfo *info = NULL;
+  gchar *icon_name = NULL, *suffix = NULL, *file = NULL;
+
+  if( G_UNLIKELY(!name) || g_path_is_absolute(name) )
+    return NULL;
+
+  suffix = strchr((char*)name, '.' );
+  icon_name = suffix ? g_strndup(name, (suffix-name) ) : g_strdup(name);
+
+  info = gtk_icon_theme_lookup_icon( gtk_icon_theme_get_default(), icon_name, size, GTK_ICON_LOOKUP_NO_SVG );
+  g_free(icon_name);
+
+  if( G_UNLIKELY(!info) )
+    return NULL;
+
+  file = g_strdup( gtk_icon_info_get_filename(info) );
+  gtk_icon_info_free(info);
+
+  return file;
+}
+
+/*! \fn gchar* CAppCatalog::m_LookupIconShowFile(const gchar* name)
+    \brief To find the full name of the icon file at IMG_SIZE_SHOW handed out for the chosen application.
+
+    A name with a directory part is used as it is. Otherwise the icon theme is asked first, then the
+    alternative paths, and at last the default icon is taken.
+
+    \param[in] name. The icon name, the basename of an icon file or the name of an icon file with a directory part.
+    \return Newly allocated full name of the icon file. It is NULL only if the icon theme has a built-in icon
+            of the name and no file of it is found in the alternative paths.
+*/
+gchar* CAppCatalog::m_LookupIconShowFile(const gchar* name)
+{
+  GtkIconInfo *info = NULL;
+  gchar *dirName = g_path_get_dirname(name), *file = NULL;
+  gboolean bHasDir = ( dirName && (*dirName != '.') );
+
+  g_free(dirName);
+
+  if(bHasDir)
+    return g_strdup(name);
+
+  info = gtk_icon_theme_lookup_icon( gtk_icon_theme_get_default(), name, IMG_SIZE_SHOW, GTK_ICON_LOOKUP_USE_BUILTIN );
+
+  if(info)
+  {
+     file = g_strdup( gtk_icon_info_get_filename(info) );
+     gtk_icon_info_free(info);
+
+     /* To search the icon in alternative paths if it is a built-in icon. */
+     return file ? file : m_GetIconFullName(name, IMG_SIZE_SHOW);
+  }
+
+  /* To search the icon in alternative paths. */
+  file = m_GetIconFullName(name, IMG_SIZE_SHOW);
+
+  /* If it can not find the icon file name specified in the ".desktop" file. */
+  return file ? file : g_strdup(DEFAULT_ICON);
+}
+
+/*! \fn const ICON_FILES* CAppCatalog::m_GetIconFiles(const gchar* name)
+    \brief To get the files of an icon name, resolving the rows' file the first time. The shown file is left to
+           m_GetIconShowFile(), only a chosen application needs it. This must run in the GTK main thread.
+
+    \param[in] name. The icon name, the basename of an icon file or the full name of an icon file.
+    \return The files, owned by m_IconFiles until m_DeinitValue() or a menu reload. NULL if name is NULL.
+*/
+const ICON_FILES* CAppCatalog::m_GetIconFiles(const gchar* name)
+{
+  ICON_FILES *files = NULL;
+
+  if( G_UNLIKELY(!name) )
+    return NULL;
+
+  files = (ICON_FILES*)g_hash_table_lookup(m_IconFiles, name);
+
+  if(files)
+    return files;
+
+  files = g_slice_new0(ICON_FILES);
+  files->theme_file = m_LookupThemeIconFile(name, IMG_SIZE);
+
+  g_hash_table_insert(m_IconFiles, g_strdup(name), files);
+
+  return files;
+}
+
+/*! \fn void CAppCatalog::m_AddIconFiles(const gchar* name, const gchar* theme_file, const gchar* show_file)
+    \brief To add the files of an icon name resolved before(e.g. read from the menu snapshot). Known names are kept.
+
+    \param[in] name. The icon name. Nothing is added if it is NULL.
+    \param[in] theme_file. The image file in the icon theme at IMG_SIZE, or NULL.
+    \param[in] show_file. The full name of the icon file at IMG_SIZE_SHOW, or NULL if it is not resolved yet.
+*/
+void CAppCatalog::m_AddIconFiles(const gchar* name, const gchar* theme_file, const gchar* show_file)
+{
+  ICON_FILES *files = NULL;
+
+  if( !name || g_hash_table_lookup(m_IconFiles, name) )
+    return;
+
+  files = g_slice_new0(ICON_FILES);
+  files->theme_file = g_strdup(theme_file);
+  files->show_file = g_strdup(show_file);
+
+  g_hash_table_insert(m_IconFiles, g_strdup(name), files);
+}
+
+/*! \fn const gchar* CAppCatalog::m_GetIconShowFile(const gchar* name)
+    \brief To get the full name of the icon file at IMG_SIZE_SHOW of an application.
+
+    It is looked up the first time an application using the icon is chosen, not for every row, and kept with
+    the rows' file of the name.
+
+    \param[in] name. The "icon" value of the application, it could be NULL.
+    \return The full name owned by m_IconFiles, DEFAULT_ICON if name is NULL.
+*/
+const gchar* CAppCatalog::m_GetIconShowFile(const gchar* name)
+{
+  ICON_FILES *files = NULL;
+
+  /* If the icon field in the ".desktop" is empty, it is the default icon. */
+  if(!name)
+    return DEFAULT_ICON;
+
+  files = (ICON_FILES*)m_GetIconFiles(name);
+
+  if(!files->show_file)
+    files->show_file = m_LookupIconShowFile(name);
+
+  return files->show_file;
+}
+
+/*! \fn GdkPixbuf* CAppCatalog::m_DecodeIcon(const gchar* name, const gchar* theme_file, gint size)
+    \brief To get an icon from the on-disk icon cache, or decode it and add it to the cache.
+
+    It does not touch GTK+ objects, so it is safe to call it in a worker thread of the icon decoding pipeline.
+
+    \param[in] name. The icon name, the basename of an icon file or the full name of an icon file.
+    \param[in] theme_file. The image file found by m_ResolveThemeIconFile(). It could be NULL.
+    \param[in] size. 
+    \return PixelBuffer object or NULL.
+*/
+GdkPixbuf* CAppCatalog::m_DecodeIcon(const gchar* name, const gchar* theme_file, gint size)
+{
+  gchar *source_file = NULL;
+  GdkPixbuf *icon = NULL;
+  gint64 spanStart = m_Profiler.m_Begin();
+
+  /* A warm start maps the pre-scaled pixels and does not decode anything. */
+  icon = m_IconCache.m_Lookup(name, size);
+
+  if(icon)
+  {
+     m_Profiler.m_Count(PROFILE_ICON_CACHE_HITS);
+     m_Profiler.m_End("icon cache lookup", spanStart);
+
+     return icon;
+  }
+
+  if( g_path_is_absolute( name) )
+  {
+    icon = load_scaled_icon( name, size, &source_file );
+    m_Profiler.m_Count( icon ? PROFILE_ICON_DECODES : PROFILE_ICON_FAILED_OPENS );
+  }
+  else
+  {
+    if( strchr(name, '.') )  /* Having file extension, it is the basename of icon file */
+    {
+      /*Try to find it in "pixmaps", "icons/hicolor" and "icons/hicolor/scalable/apps" directories */
+      icon = m_LoadIconFile( name, size, &source_file );
+    }
+
+    /* No file extension, or unfortunately it is not found: use the file found in the icon theme. */
+    if( !icon && theme_file )
+    {
+      icon = load_theme_icon_file( theme_file, size );
+      m_Profiler.m_Count( icon ? PROFILE_ICON_DECODES : PROFILE_ICON_FAILED_OPENS );
+
+      if(icon)
+        source_file = g_strdup(theme_file);
+    }
+  }
+
+  if(icon && source_file)
+    m_IconCache.m_Store(name, size, source_file, icon);
+
+  g_free(source_file);
+
+  m_Profiler.m_End("m_DecodeIcon", spanStart);
+
+  return icon;
+}
+
+/*! \fn GdkPixbuf* CAppCatalog::m_LoadIconFile(const char* file_name, int size, gchar **source_file)
+    \brief Try to find it in "pixmaps", "icons/hicolor", "icons/hicolor/scalable/apps" directories.
+
+    The directories are not probed file by file, the name is resolved through the index of m_IconResolver.
+
+    \param[in] file_name. The icon name for searching.
+    \param[in] size. The width(height) of the icon for searching. 
+    \param[out] source_file. If not NULL, it is set to the newly allocated full name of the loaded image file.
+    \return PixelBuffer object representing the designated icon.
+*/
+GdkPixbuf* CAppCatalog::m_LoadIconFile(const char* file_name, int size, gchar **source_file)
+{
+  GdkPixbuf* icon = NULL;
+  gint64 spanStart = m_Profiler.m_Begin();
+  gchar *file_path = m_IconResolver.m_Resolve(file_name, size);
+
+  m_Profiler.m_End("icon resolve", spanStart);
+
+  if( !file_path )
+  {
+     m_Profiler.m_Count(PROFILE_ICON_LOOKUP_MISSES);
+     m_Profiler.m_End("m_LoadIconFile", spanStart);
+     return NULL;
+  }
+
+  icon = load_scaled_icon( file_path, size, source_file );
+  m_Profiler.m_Count( icon ? PROFILE_ICON_DECODES : PROFILE_ICON_FAILED_OPENS );
+
+  /* The file exists but it can not be loaded, do not try it again. */
+  if( G_UNLIKELY(!icon) )
+    m_IconResolver.m_AddMiss(file_name, size);
+
+  g_free(file_path);
+
+  m_Profiler.m_End("m_LoadIconFile", spanStart);
+
+  return icon;
+}
+
+/*! \fn GdkPixbuf* CAppCatalog::m_LoadThemeIcon(GtkIconTheme* theme, const char* icon_name, int size, gchar **source_file)
+    \brief To load a icon contents found in theme icon pool.
+
+    \param[in] theme.
+    \param[in] icon_name. 
+    \param[in] size.
+    \param[out] source_file. If not NULL, it is set to the newly allocated full name of the loaded image file.
+                 It stays untouched for a built-in icon.
+    \return PixelBuffer object representing the designated icon.
+*/
+GdkPixbuf* CAppCatalog::m_LoadThemeIcon(GtkIconTheme* theme, const char* icon_name, int size, gchar **source_file)
+{
+  GdkPixbuf *icon = NULL;
+  const char *file = NULL;
+  gint64 spanStart = m_Profiler.m_Begin();
+  GtkIconInfo *info = gtk_icon_theme_lookup_icon(theme, icon_name, size, GTK_ICON_LOOKUP_USE_BUILTIN);
+
+  m_Profiler.m_End("icon theme lookup", spanStart);
+
+  if( G_UNLIKELY(!info) )
+    return NULL;
+
+  file = gtk_icon_info_get_filename( info );
+
+  if( G_LIKELY( file ) )
+  {
+    icon = load_theme_icon_file( file, size );
+    m_Profiler.m_Count( icon ? PROFILE_ICON_DECODES : PROFILE_ICON_FAILED_OPENS );
+
+    if( icon && source_file )
+      *source_file = g_strdup( file );
+  }
+  else
+  {
+    /* No extra reference is added to a built-in pixbuf, take one since the caller owns the result. */
+    icon = gtk_icon_info_get_builtin_pixbuf( info );
+
+    if( icon )
+      icon = scale_down_icon( (GdkPixbuf*)g_object_ref( icon ), size );
+  }
+
+  gtk_icon_info_free( info );
+
+  m_Profiler.m_End("m_LoadThemeIcon", spanStart);
+
+  return icon;
+}
+
+/*! \fn gchar* CAppCatalog::m_GetIconFullName(const char* file_name, int size )
+    \brief Try to find it in "pixmaps", "icons/hicolor", "icons/hicolor/scalable/apps" directories.
+
+    \param[in] file_name.
+    \param[in] size.
+    \return Newly allocated string representing the icon's full name.
+*/
+gchar* CAppCatalog::m_GetIconFullName(const char* file_name, int size)
+{
+  /* Only the file name is wanted, so the icon is not decoded. */
+  return m_IconResolver.m_Resolve(file_name, size);
+}
+
+//----------------------------------- Memory Accounting
+/*! \fn void CAppCatalog::m_GetMemoryStats(APPCHOOSER_MEMORY_STATS *stats)
+    \brief To count what the catalog holds: rows, records and strings, icons by size and the caches.
+
+    It walks the rows and the loaded menu, so it is meant for diagnostics, not for every frame.
+
+    \param[out] stats.
+    \return NONE
+*/
+void CAppCatalog::m_GetMemoryStats(APPCHOOSER_MEMORY_STATS *stats)
+{
+  GHashTableIter hashIter;
+  gpointer key = NULL, value = NULL;
+
+  memset(stats, 0, sizeof(APPCHOOSER_MEMORY_STATS));
+
+  /* Rows. */
+  if( m_ListModel )
+    stats->nRows = stats->nApplications = app_list_model_get_n_rows(m_ListModel);
+  else if( m_TreeStore )
+    count_tree_rows(GTK_TREE_MODEL(m_TreeStore), NULL, stats);
+
+  m_AppItemArena.m_GetStats(&stats->arena);
+
+  /* Icons, the size is the beginning of the intern key. */
+  g_hash_table_iter_init(&hashIter, m_IconInternTable);
+
+  while( g_hash_table_iter_next(&hashIter, &key, &value) )
+  {
+     gint size = atoi( (const gchar*)key );
+     gsize nBytes = get_pixbuf_bytes( (GdkPixbuf*)value );
+     guint i = 0;
+
+     if( !value )
+     {
+        stats->nIconFailures++;
+        continue;
+     }
+
+     while( i < stats->nIconSizes && stats->iconSizes[i].size != size && i < APPCHOOSER_MAX_ICON_SIZES - 1 )
+       i++;
+
+     if( i == stats->nIconSizes )
+     {
+        stats->iconSizes[i].size = size;
+        stats->nIconSizes++;
+     }
+
+     stats->iconSizes[i].nIcons++;
+     stats->iconSizes[i].nPixelBytes += nBytes;
+     stats->nIcons++;
+     stats->nIconPixelBytes += nBytes;
+  }
+
+  stats->nPendingIcons = g_hash_table_size(m_IconPending);
+
+  if( m_ListModel )
+    app_list_model_get_icon_cache_stats(m_ListModel, &stats->nListIcons, &stats->nListIconCapacity,
+                                        &stats->nListIconPixelBytes);
+
+  /* Caches. */
+  g_hash_table_iter_init(&hashIter, m_IconFiles);
+
+  while( g_hash_table_iter_next(&hashIter, &key, &value) )
+  {
+     ICON_FILES *files = (ICON_FILES*)value;
+
+     stats->nIconFiles++;
+     stats->nIconFileBytes += sizeof(ICON_FILES) + strlen( (const gchar*)key ) + 1 +
+                              (files->theme_file ? strlen(files->theme_file) + 1 : 0) +
+                              (files->show_file ? strlen(files->show_file) + 1 : 0);
+  }
+
+  m_IconResolver.m_GetStats(stats->nResolverNames, stats->nResolverMisses);
+  m_SearchIndex.m_GetStats(stats->nSearchDocuments, stats->nSearchGrams, stats->nSearchBytes);
+  stats->nExecTemplates = g_hash_table_size(m_ExecTemplates);
+  stats->nSnapshotBytes = m_MenuSnapshot.m_GetMappedSize();
+
+  if( m_RootDir && !m_bMenuLoading )
+    count_menu_items(m_RootDir, stats->nMenuDirectories, stats->nMenuEntries);
+
+  stats->nTotalBytes = stats->arena.nBlockBytes + stats->arena.nStringBytes + stats->nIconPixelBytes +
+                       stats->nListIconPixelBytes + stats->nIconFileBytes + stats->nSearchBytes + stats->nSnapshotBytes;
+}
+
@@ -0,0 +1,379 @@
+/*! \file    CAppCatalog.h
+    \brief   The applications catalog: the rows of the menu, their icons and everything loaded to build them.
+
+    \date    2026-10-17
+    \version 1.0
+
+    \b Change_History:
+    \n 1) 2026-10-17 initialized.
+*/
+
+#ifndef __CAPPCATALOG_H
+#define __CAPPCATALOG_H
+
+#include <stdio.h>
+#include <glib.h>
+#include <gtk/gtk.h>
+#include <gdk/gdk.h>
+
+#define GMENU_I_KNOW_THIS_IS_UNSTABLE  /* This definition must be added else it will fail to build the image. */
+#include <gmenu-tree.h>	 /* GNOME Menus library header. */
+
+#include "AppListModel.h"
+#include "CAppItemArena.h"
+#include "CAppSearchIndex.h"
+#include "CCatalogClient.h"
+#include "CExecTemplate.h"
+#include "CIconCache.h"
+#include "CIconResolver.h"
+#include "CIconScaler.h"
+#include "CMenuSnapshot.h"
+#include "CStartupProfiler.h"
+#include "CUsageLog.h"
+
+/*! \enum APPS_MENU_ITEM_IDX 
+    \brief The application items tree-view column. The flat list model(APP_LIST_COLUMN) has the same columns.
+*/
+enum APPS_MENU_ITEM_IDX 
+{
+  COLUMN_ICON = APP_LIST_COLUMN_ICON,
+  COLUMN_TEXT = APP_LIST_COLUMN_TEXT,
+  COLUMN_NODEDATA = APP_LIST_COLUMN_NODEDATA,
+  COLUMN_DIRDATA = APP_LIST_COLUMN_DIRDATA,
+  NUM_COLS
+};
+
+/*! \enum  APPCHOOSER_DUMP_FORMAT
+    \brief The output formats of the headless menu dump.
+*/
+enum APPCHOOSER_DUMP_FORMAT {
+  APPCHOOSER_DUMP_JSONL = 0,  /*!< One JSON object per line. */
+  APPCHOOSER_DUMP_TSV         /*!< A header line, then one tab separated record per line. */
+};
+
+/*! \struct APP_ITEM_INFO
+    \brief The application item's information. This follows freedesktop.org Desktop Entry specification.
+*/
+typedef  struct {
+  gchar *name;
+  gchar *icon;
+  gchar *exec;
+  gchar *comment;
+  gchar *desktopfile;
+} APP_ITEM_INFO;
+
+/*! \struct ICON_REQUEST
+    \brief A request of the icon decoding pipeline. It is created in the GTK main thread, decoded in a worker thread
+           and handed back to the GTK main thread to update the tree row.
+*/
+typedef  struct {
+  gchar *name;         /*!< The icon name, the basename of an icon file or the full name of an icon file. */
+  gchar *theme_file;   /*!< The image file found in the icon theme by the GTK main thread, or NULL. */
+  gint size;
+  GArray *iters;       /*!< The tree rows(GtkTreeIter) showing the icon. */
+  GdkPixbuf *icon;     /*!< The decoded icon, NULL if it could not be loaded. */
+  gboolean scalable;   /*!< The icon is rasterized from a scalable image(SVG): the first decoding only loads the preview. */
+  gboolean rasterize;  /*!< The second decoding of a scalable icon, queued after all other requests. */
+  gchar *preview_file; /*!< A bitmap image of the icon in the icon theme shown until it is rasterized, or NULL. */
+  GdkPixbuf *preview;  /*!< The loaded preview, only used by the GTK main thread. */
+} ICON_REQUEST;
+
+/*! \struct MENU_BUILD_FRAME
+    \brief A directory of the menu being walked while its nodes are created, see CAppCatalog::m_AddAppsMenuDirectoryRows().
+*/
+typedef  struct {
+  GSList *items;       /*!< The directory's contents, released when the walk leaves it. */
+  GSList *next;        /*!< The next item to create the node of. */
+  GtkTreeIter node;    /*!< The node of the directory. */
+} MENU_BUILD_FRAME;
+
+/*! \struct ICON_FILES
+    \brief The files of an icon name for every size the chooser uses. The rows' file is resolved the first time the
+           name is needed, the shown file the first time an application using it is chosen.
+*/
+typedef  struct {
+  gchar *theme_file;   /*!< The image file in the icon theme at IMG_SIZE the rows' icon is decoded from, or NULL. */
+  gchar *show_file;    /*!< The full name of the icon file at IMG_SIZE_SHOW handed out for the chosen application.
+                            NULL until it is resolved, see CAppCatalog::m_GetIconShowFile(). */
+} ICON_FILES;
+
+/*! \def APPCHOOSER_MAX_ICON_SIZES
+    \brief The icon sizes APPCHOOSER_MEMORY_STATS counts separately, the chooser uses two.
+*/
+#define APPCHOOSER_MAX_ICON_SIZES  4
+
+/*! \struct APPCHOOSER_ICON_SIZE_STATS
+    \brief The loaded icons of one requested size.
+*/
+typedef  struct {
+  gint size;
+  guint nIcons;
+  gsize nPixelBytes;
+} APPCHOOSER_ICON_SIZE_STATS;
+
+/*! \struct APPCHOOSER_MEMORY_STATS
+    \brief What a chooser holds, see m_GetMemoryStats(). The bytes are the payload(pixels, strings, records),
+           without the overhead of the allocator, the hash tables and the GObjects.
+*/
+typedef  struct {
+  /* Rows of the tree store or of the flat list model. */
+  guint nRows;                 /*!< All rows, including the dummy rows of categories not populated yet. */
+  guint nCategories;
+  guint nApplications;
+  APP_ITEM_ARENA_STATS arena;  /*!< The APP_ITEM_INFO records and their strings. */
+
+  /* Loaded icons. */
+  guint nIcons;
+  gsize nIconPixelBytes;
+  guint nIconFailures;         /*!< The icon names which could not be loaded. */
+  guint nIconSizes;
+  APPCHOOSER_ICON_SIZE_STATS iconSizes[APPCHOOSER_MAX_ICON_SIZES];  /*!< A size beyond the last one is added to it. */
+  guint nPendingIcons;
+  guint nListIcons;            /*!< The icon cache of the flat list model. */
+  guint nListIconCapacity;
+  gsize nListIconPixelBytes;
+
+  /* Caches. */
+  guint nIconFiles;            /*!< The names in the ICON_FILES table. */
+  gsize nIconFileBytes;
+  guint nResolverNames;        /*!< The icon files indexed by m_IconResolver. */
+  guint nResolverMisses;
+  guint nSearchDocuments;
+  guint nSearchGrams;
+  gsize nSearchBytes;
+  guint nExecTemplates;        /*!< The parsed "Exec" commands, their bytes are in the arena. */
+  gsize nSnapshotBytes;        /*!< The mapped menu snapshot. */
+  guint nMenuDirectories;      /*!< The GMenuTree items held, their own size is not visible. */
+  guint nMenuEntries;
+
+  guint nWidgets;              /*!< The widgets of the dialog window. */
+  gsize nTotalBytes;           /*!< The sum of the bytes above. */
+} APPCHOOSER_MEMORY_STATS;
+
+/*! \struct APP_CATALOG_OPTIONS
+    \brief How the catalog is built. They are set before CAppCatalog::m_CreateInitValue().
+*/
+typedef  struct {
+  gboolean lazy_load;             /*!< A category's applications are created when it is expanded the first time. */
+  gboolean sort_by_name;          /*!< The rows are sorted by name instead of kept in menu order. */
+  gboolean flat_list;             /*!< The applications are one flat list instead of a tree. */
+  gboolean async_menu_load;       /*!< The menu is parsed by a thread while the window is shown(default). */
+  gboolean menu_snapshot;         /*!< The menu snapshot is read and written(default). */
+  gboolean catalog_daemon;        /*!< The rows are got from a running catalog daemon before anything is loaded. */
+  gboolean async_icon_load;       /*!< Icons are decoded by the worker threads(default). */
+  gboolean defer_scalable_icons;  /*!< Scalable icons show a preview and are rasterized after the other icons(default). */
+  gboolean usage_log;             /*!< The chosen applications are logged and the most used shown first(default). */
+} APP_CATALOG_OPTIONS;
+
+/*! \enum  APP_CATALOG_EVENT
+    \brief The changes of the rows a view is told about, see CAppCatalog::m_AttachView().
+*/
+enum APP_CATALOG_EVENT {
+  APP_CATALOG_MENU_LOADED = 0,  /*!< The last category of the menu is added. */
+  APP_CATALOG_ROWS_CHANGED,     /*!< Rows were added, removed or changed in the model. */
+  APP_CATALOG_MODEL_REPLACED    /*!< The model is a new one, see CAppCatalog::m_GetModel(). */
+};
+
+typedef void (*APP_CATALOG_VIEW_FUNC)(APP_CATALOG_EVENT event, gpointer data);
+
+/*! \struct APP_CATALOG_VIEW
+    \brief A view told about the changes of the rows.
+*/
+typedef  struct {
+  APP_CATALOG_VIEW_FUNC func;
+  gpointer data;
+} APP_CATALOG_VIEW;
+
+/*! \class CAppCatalog
+    \brief The rows of the applications menu and what is loaded to build them, without any window.
+
+    It is owned by a dialog showing it, shared by the dialogs of a process, or served by the catalog daemon.
+*/
+class CAppCatalog
+{
+  private:
+    APP_CATALOG_OPTIONS m_Options;
+    GtkTreeStore  *m_TreeStore;    /*!< The rows of the menu. */
+    AppListModel *m_ListModel;     /*!< The flat list model used instead of m_TreeStore when the flat_list option is set. */
+    CAppItemArena m_AppItemArena;  /*!< Holds the node-data(APP_ITEM_INFO) of all tree leaves, their strings and commands. */
+    gboolean m_bMenuMonitored;  /*!< To indicate if changes of the applications menu are followed. */
+    gboolean m_bMenuTreeHeld;  /*!< To indicate if this instance counts as a holder of the process-wide menu tree. */
+    GSList *m_Views;           /*!< The APP_CATALOG_VIEW objects told about the changes of the rows. */
+
+    /* Startup profiling relevant variables. */
+    CStartupProfiler m_Profiler;  /*!< Enabled by the environment variable PROFILE_ENV_NAME. */
+
+    /* Type-ahead search relevant variables. */
+    CAppSearchIndex m_SearchIndex;  /*!< The index of the applications' name, comment and command. */
+
+    /* GNOME Menus relevant variables. */   
+    GMenuTree *m_MenuTree;          /*!< The application menu tree. */
+    GMenuTreeDirectory *m_RootDir;  /*!< The directories' content. */
+    CMenuSnapshot m_MenuSnapshot;   /*!< The flattened menu of the last parse, read instead of parsing while it is fresh. */
+    gboolean m_bMenuFromSnapshot;   /*!< To indicate if the rows are built from m_MenuSnapshot, then m_MenuTree is NULL. */
+    gboolean m_bMenuFromDaemon;     /*!< To indicate if the rows are built from the catalog daemon, then m_MenuTree is NULL. */
+    gboolean m_bMenuLoading;        /*!< To indicate if the menu loading thread has started and not all categories are added yet. */
+    GThread *m_MenuLoader;          /*!< The menu loading thread, NULL once it is joined. */
+    guint m_nMenuIdleId;            /*!< The idle handler adding the categories of the parsed menu. */
+    GSList *m_PendingMenuDirs;      /*!< The top-level directories of the parsed menu not added yet. */
+    gboolean m_bSnapshotStale;      /*!< Set by the menu loading thread after a snapshot build if the menu changed since the snapshot was written. */
+    gint64 m_nMenuLoadStart;        /*!< The start of the span ending when the last category is added. */
+
+    /* Icon loading relevant variables. */
+    CIconCache m_IconCache;  /*!< The on-disk cache of pre-scaled icons. */
+    CIconResolver m_IconResolver;  /*!< The index of the alternative icons searching paths. */
+    GdkPixbuf *m_pPlaceholderIcon;    /*!< The icon shown in a row until its own icon is decoded. */
+    GThreadPool *m_IconPool;          /*!< The worker threads decoding icons. NULL if icons are loaded synchronously. */
+    GAsyncQueue *m_IconResults;       /*!< The decoded ICON_REQUEST objects waiting for the GTK main thread. */
+    volatile gint m_bIconPipelineCancelled;  /*!< Non-zero when the worker threads should drop their requests. */
+    guint m_nIconIdleId;              /*!< The idle handler applying decoded icons, 0 if none. Guarded by the lock of m_IconResults. */
+    GQueue *m_DeferredIcons;          /*!< The scalable ICON_REQUEST objects waiting to be rasterized. */
+    guint m_nDeferredIdleId;          /*!< The low priority idle handler queuing the deferred icons to the worker threads. */
+    GHashTable *m_IconInternTable;    /*!< "size\nname" -> GdkPixbuf(or NULL if it can not be loaded), shared by all rows using it. */
+    guint m_nIconGeneration;          /*!< Bumped on every change of m_IconInternTable. */
+    gulong m_nIconThemeHandler;       /*!< The "changed" handler of the default icon theme expiring the icon misses, 0 if none. */
+    GHashTable *m_IconPending;        /*!< "size\nname" -> ICON_REQUEST being decoded by the worker threads. */
+    GHashTable *m_IconFiles;          /*!< Icon name -> ICON_FILES, only used by the GTK main thread. */
+    guint m_nIconDecodes;             /*!< The number of icons loaded. */
+    guint m_nIconDecodesSaved;        /*!< The number of icon loads saved by sharing loaded icons. */
+
+    /* Usage log relevant variables. */
+    CUsageLog m_UsageLog;             /*!< The chosen applications and their frecency scores. */
+
+    /* Launcher relevant variables. */
+    GHashTable *m_ExecTemplates;      /*!< "Exec" string of a node-data -> EXEC_TEMPLATE in the arena, NULL if the command is invalid. */
+
+  public:
+    /* The constructor and the destructor of class CAppCatalog. */
+    CAppCatalog();
+    ~CAppCatalog();
+
+    void m_CreateInitValue(void);
+    void m_DeinitValue(void);
+    const APP_CATALOG_OPTIONS* m_GetOptions(void) { return &m_Options; }  /*!< To get how the catalog is built. */
+    void m_SetOptions(const APP_CATALOG_OPTIONS *options);
+    GtkTreeModel* m_GetModel(void);  /*!< To get the model the views show. */
+    CAppSearchIndex* m_GetSearchIndex(void) { return &m_SearchIndex; }  /*!< To get the index of the rows' applications. */
+    CStartupProfiler* m_GetProfiler(void) { return &m_Profiler; }  /*!< To get the profiler of the catalog and its views. */
+
+    /* View relevant functions. */
+    void m_AttachView(APP_CATALOG_VIEW_FUNC func, gpointer data);  /*!< To tell a view about the changes of the rows. */
+    void m_DetachView(gpointer data);
+    void m_NotifyViews(APP_CATALOG_EVENT event);
+
+    /* GNOME Menus relevant functions */
+    gboolean m_LoadAndBuildAppsMenuTree(void);  /*!< To load the main application menu content and build a tree representing menu contents. */ 
+    void m_ParseAppsMenu(void);
+    void m_AddAppsMenuDirectory(GMenuTreeDirectory *appsDir);
+    void m_FinishAppsMenuLoad(void);
+    void m_ReleaseAppsMenuTree(void);  /*!< To release the menu objects after m_DeinitValue(). */
+    void m_AddAppsMenuDirectoryRows(GtkTreeIter *iter, GMenuTreeDirectory *appsDir);  /*!< To create the nested nodes of the applications menu contents. */
+    void m_AddAppsMenuCategoryChildren(GtkTreeIter *iter, GMenuTreeDirectory *appsDir);
+    gboolean m_InsertAppsMenuDirectoryRow(GtkTreeIter *iter, GtkTreeIter *parent, gint position, GMenuTreeDirectory *appsDir);
+    gboolean m_InsertAppsMenuEntryRow(GtkTreeIter *iter, GtkTreeIter *parent, gint position, GMenuTreeEntry *item);
+    gboolean m_InsertCategoryRow(GtkTreeIter *iter, GtkTreeIter *parent, gint position, const gchar *name, const gchar *icon_name, gpointer dirData);
+    gboolean m_InsertAppItemRow(GtkTreeIter *iter, GtkTreeIter *parent, gint position, APP_ITEM_INFO *appInfo);
+    APP_ITEM_INFO* m_NewAppItemInfo(GMenuTreeEntry *item);
+    gboolean m_PopulateCategory(GtkTreeIter *iter);  /*!< To create the children of a category on its first expansion in lazy mode. */
+    void m_SetLazyLoad(gboolean lazy) { m_Options.lazy_load = lazy; }  /*!< Create only the categories in m_CreateInitValue(), their applications on expansion. */
+    void m_SetSortByName(gboolean sort) { m_Options.sort_by_name = sort; }  /*!< Sort the categories and applications by name, the categories first. */
+    void m_SortTreeStore(void);
+    GdkPixbuf* m_LoadIcon( const gchar* name, gint size, gboolean use_fallback );  /*!< To load a icon's image. */
+    /* Incremental menu reload relevant functions. */
+    void m_ReloadAppsMenuTree(void);  /*!< To update the tree store after the applications menu has changed. */
+    void m_RebuildAppsMenuTree(GMenuTreeDirectory *newRootDir);
+    GMenuTree* m_GetMenuTree(void) { return m_MenuTree; }  /*!< To get the parsed menu, NULL while the rows come from the snapshot or the catalog daemon. */
+    void m_ReloadCategory(GtkTreeIter *iter, GMenuTreeDirectory *appsDir);
+    void m_UpdateAppsMenuEntryRow(GtkTreeIter *iter, GMenuTreeEntry *item);
+    void m_UpdateRowIcon(GtkTreeIter *iter, const gchar *name);
+    void m_MoveRowAfter(GtkTreeIter *iter, GtkTreeIter *prev);
+    void m_ExpireIconMisses(void);
+    void m_RemoveAppsMenuRow(GtkTreeIter *iter);
+    void m_ForgetAppsMenuRow(GtkTreeIter *iter, GPtrArray *records);
+    void m_ReleaseAppItemInfo(APP_ITEM_INFO *appInfo);
+    void m_ReleaseAppString(const gchar *str);
+    void m_CancelIconRequests(GtkTreeIter *iter);
+    gboolean m_IsDummyRow(GtkTreeIter *iter);
+    void m_RemoveMenuMonitor(void);
+    /* Background menu loading relevant functions. */
+    void m_SetAsyncMenuLoad(gboolean async) { m_Options.async_menu_load = async; }  /*!< Parse the menu in a thread while the window is shown(default) or in m_CreateInitValue(). */
+    gboolean m_IsMenuLoading(void) { return m_bMenuLoading; }  /*!< To check if categories of the menu are still to come. */
+    gboolean m_IsMenuParsing(void) { return (m_MenuLoader != NULL); }  /*!< To check if the menu loading thread runs, also behind the rows of the snapshot. */
+    void m_FollowSnapshotMenu(void);
+    gboolean m_StartMenuLoader(void);
+    void m_HoldMenuTree(void);
+    void m_LoadMenuInThread(void);
+    gboolean m_AddLoadedMenuCategories(void);
+    void m_StopMenuLoader(void);
+    /* Menu snapshot relevant functions. */
+    void m_SetMenuSnapshot(gboolean use) { m_Options.menu_snapshot = use; }  /*!< Read the menu from the snapshot of the last parse while it is fresh(default). */
+    gboolean m_BuildAppsMenuFromSnapshot(void);
+    void m_InsertSnapshotCategoryRow(GtkTreeIter *iter, GtkTreeIter *parent, gint position, const MENU_SNAPSHOT_CATEGORY *category);
+    void m_AddSnapshotNodes(GtkTreeIter *iter, guint index);
+    APP_ITEM_INFO* m_NewSnapshotAppItemInfo(const MENU_SNAPSHOT_ENTRY *entry);
+    void m_WriteAppsMenuSnapshot(void);
+    guint32 m_WriteSnapshotDirectory(GMenuTreeDirectory *dir, guint32 parent);
+    /* Catalog daemon relevant functions. */
+    void m_SetCatalogDaemon(gboolean use) { m_Options.catalog_daemon = use; }  /*!< Show the rows and icons of a running catalog daemon instead of loading them. */
+    gboolean m_BuildAppsMenuFromDaemon(void);
+    const gchar* m_GetCategoryIcon(gpointer dirData);
+    void m_WriteCatalogRecords(GString *out, const gchar *text);
+    void m_WriteCatalogNodes(GString *out, GtkTreeIter *parent, guint depth, GHashTable *matches, GArray *pending);
+    void m_WriteCatalogCategory(GString *out, GtkTreeIter *iter, guint depth);
+    void m_WriteCatalogEntry(GString *out, APP_ITEM_INFO *appInfo, guint depth);
+    void m_WriteIconFilesRecord(GString *out, const gchar *name);
+    gint m_CollectInternedIcons(GHashTable *icons);
+    guint m_GetIconGeneration(void) { return m_nIconGeneration; }  /*!< To know if the interned icons changed since m_CollectInternedIcons(). */
+    /* Type-ahead search relevant functions. */
+    void m_PopulateAllCategories(void);
+    void m_PopulateCategories(GtkTreeIter *parent);
+    /* Flat list mode relevant functions. */
+    void m_SetFlatList(gboolean flat) { m_Options.flat_list = flat; }  /*!< Keep the applications as one list whose icons are loaded only for the rows on screen. */
+    void m_AddAppsMenuListRows(GMenuTreeDirectory *appsDir);
+    void m_ReloadAppsMenuList(GMenuTreeDirectory *newRootDir);
+    GdkPixbuf* m_LoadListIcon(const gchar *icon_name);
+    gint m_DumpAppsMenu(FILE *stream, APPCHOOSER_DUMP_FORMAT format);  /*!< To write the applications without creating any widget or icon. */
+    void m_DumpAppsMenuDirectory(FILE *stream, APPCHOOSER_DUMP_FORMAT format, const gchar *category, GMenuTreeDirectory *appsDir, gint &nCount);
+    GdkPixbuf* m_LoadIconByName( const gchar* name, gint size );  /*!< To load a icon's image through the on-disk icon cache. */
+    GdkPixbuf* m_LoadIconUnshared( const gchar* name, gint size );
+    GdkPixbuf* m_LoadIconFile( const char* file_name, int size, gchar **source_file = NULL );
+    GdkPixbuf* m_LoadThemeIcon( GtkIconTheme* theme, const char* icon_name, int size, gchar **source_file = NULL );
+    gchar* m_GetIconFullName(const char* file_name, int size);
+    gchar* m_ResolveThemeIconFile( const gchar* name, gint size );
+    gchar* m_LookupThemeIconFile( const gchar* name, gint size );
+    gchar* m_LookupIconShowFile( const gchar* name );
+    const ICON_FILES* m_GetIconFiles( const gchar* name );
+    void m_AddIconFiles( const gchar* name, const gchar* theme_file, const gchar* show_file );
+    const gchar* m_GetIconShowFile( const gchar* name );  /*!< To get the full name of an icon file at IMG_SIZE_SHOW. */
+    GdkPixbuf* m_DecodeIcon( const gchar* name, const gchar* theme_file, gint size );
+
+    /* Icon decoding pipeline relevant functions. */
+    void m_SetAsyncIconLoad(gboolean async) { m_Options.async_icon_load = async; }  /*!< Decode icons in worker threads(default) or in m_CreateInitValue(). */
+    gboolean m_StartIconPipeline(void);
+    void m_StopIconPipeline(void);
+    GdkPixbuf* m_GetRowIcon( const gchar* name, gint size );
+    void m_QueueIconRequest( GtkTreeIter *iter, const gchar* name, gint size );
+    void m_ProcessIconRequest( ICON_REQUEST *request );
+    gboolean m_ApplyIconResults(void);
+    void m_SetDeferScalableIcons(gboolean defer) { m_Options.defer_scalable_icons = defer; }  /*!< Show a bitmap preview of a scalable icon and rasterize it when the other icons are done(default). */
+    gchar* m_LookupThemePreviewFile( const gchar* name, gint size );
+    GdkPixbuf* m_DecodeIconPreview( ICON_REQUEST *request );
+    void m_DeferIconRequest( ICON_REQUEST *request );
+    gboolean m_QueueDeferredIcons(void);
+    guint m_GetPendingIconCount(void) { return g_hash_table_size(m_IconPending); }  /*!< To get the number of icons the rows are still waiting for. */
+    void m_GetIconInternStats(guint &nDecodes, guint &nSaved) { nDecodes = m_nIconDecodes; nSaved = m_nIconDecodesSaved; }  /*!< To get how many icons were loaded and how many loads sharing saved. */
+    void m_GetMemoryStats(APPCHOOSER_MEMORY_STATS *stats);
+    /* Usage log relevant functions. */
+    void m_SetUsageLog(gboolean use) { m_Options.usage_log = use; }  /*!< Log the chosen applications and show the most used in a first category(default). */
+    gboolean m_LogUsage(const gchar *desktopfile);
+    gdouble m_GetUsageScore(const gchar *desktopfile) { return m_UsageLog.m_GetScore(desktopfile); }  /*!< To get the frecency score of an application. */
+    void m_AddFrequentCategory(void);
+    void m_AddFrequentRows(GtkTreeIter *iter);
+    void m_UpdateFrequentCategory(void);
+    gboolean m_FindFrequentCategory(GtkTreeIter *iter);
+    APP_ITEM_INFO* m_NewDesktopFileAppItemInfo(const gchar *desktopfile);
+    /* Launcher relevant functions. */
+    void m_PrepareExecTemplate(const gchar *exec);
+    const EXEC_TEMPLATE* m_GetExecTemplate(APP_ITEM_INFO *appInfo);
+};
+#endif /* __CAPPCATALOG_H */
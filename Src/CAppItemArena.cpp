@@ -0,0 +1,309 @@
+/*! \file CAppItemArena.cpp
+    \brief Bump allocator holding application item records and their strings.
+
+    \date 2026-10-17
+    \version 1.0
+
+    \b Change_History:
+    \n (1) 2026-10-17 initial version.
+*/
+
+#include <string.h>
+
+#include "CAppItemArena.h"
+
+/*! \def APP_ITEM_ARENA_ALIGN
+    \brief The alignment of every record handed out.
+*/
+#define APP_ITEM_ARENA_ALIGN  (2 * sizeof(gpointer))
+
+/*! \def APP_ITEM_ARENA_STRING_CHUNK
+    \brief The default size of a string chunk block.
+*/
+#define APP_ITEM_ARENA_STRING_CHUNK  (32 * 1024)
+
+/*! \struct APP_ITEM_ARENA_GENERATION
+    \brief The blocks and strings of a retired generation.
+*/
+typedef struct {
+  GSList *blocks;
+  GStringChunk *strings;
+  GHashTable *stringTable;
+} APP_ITEM_ARENA_GENERATION;
+
+/*! \fn static void free_generation(gpointer data)
+    \brief To release the blocks and strings of a generation.
+
+    \param[in] data. The APP_ITEM_ARENA_GENERATION object.
+*/
+static void free_generation(gpointer data)
+{
+  APP_ITEM_ARENA_GENERATION *generation = (APP_ITEM_ARENA_GENERATION*)data;
+
+  g_slist_free_full(generation->blocks, g_free);
+
+  if(generation->strings)
+  {
+     g_hash_table_destroy(generation->stringTable);
+     g_string_chunk_free(generation->strings);
+  }
+
+  g_slice_free(APP_ITEM_ARENA_GENERATION, generation);
+}
+
+//--------------- Class Methos Implementation.
+/*! \fn CAppItemArena::CAppItemArena()
+    \brief CAppItemArena constructor
+*/
+CAppItemArena::CAppItemArena()
+{
+  m_Blocks = NULL;
+  m_nBlockUsed = 0;
+  m_nBlockSize = 0;
+  m_FreeRecords = NULL;
+  m_Strings = NULL;
+  m_StringTable = NULL;
+  m_Retired = NULL;
+  memset(&m_Stats, 0, sizeof(m_Stats));
+}
+
+/*! \fn CAppItemArena::~CAppItemArena()
+    \brief CAppItemArena destructor
+*/
+CAppItemArena::~CAppItemArena()
+{
+  m_Clear();
+}
+
+/*! \fn gpointer CAppItemArena::m_Alloc(gsize size)
+    \brief To hand out a zeroed record, a freed one of the same size first.
+
+    \param[in] size. The size of the record in bytes.
+    \return The record. It is valid until m_Free(), or the release of its generation.
+*/
+gpointer CAppItemArena::m_Alloc(gsize size)
+{
+  gpointer record = NULL;
+
+  size = (size + APP_ITEM_ARENA_ALIGN - 1) & ~(APP_ITEM_ARENA_ALIGN - 1);
+
+  if( m_FreeRecords && (record = g_hash_table_lookup(m_FreeRecords, GSIZE_TO_POINTER(size))) )
+  {
+     /* The record holds the next free one of its size. */
+     if( *(gpointer*)record )
+       g_hash_table_insert(m_FreeRecords, GSIZE_TO_POINTER(size), *(gpointer*)record);
+     else
+       g_hash_table_remove(m_FreeRecords, GSIZE_TO_POINTER(size));
+
+     m_Stats.nFreeRecords--;
+     m_Stats.nFreeRecordBytes -= size;
+     m_Stats.nRecords++;
+     m_Stats.nRecordBytes += size;
+
+     memset(record, 0, size);
+
+     return record;
+  }
+
+  if( !m_Blocks || m_nBlockUsed + size > m_nBlockSize )
+  {
+     /* The rest of the current block is abandoned, records are small compared with a block. */
+     m_nBlockSize = MAX(size, (gsize)APP_ITEM_ARENA_BLOCK_SIZE);
+     m_nBlockUsed = 0;
+     m_Blocks = g_slist_prepend(m_Blocks, g_malloc(m_nBlockSize));
+     m_Stats.nBlocks++;
+     m_Stats.nBlockBytes += m_nBlockSize;
+  }
+
+  record = (gchar*)m_Blocks->data + m_nBlockUsed;
+  m_nBlockUsed += size;
+  m_Stats.nRecords++;
+  m_Stats.nRecordBytes += size;
+
+  memset(record, 0, size);
+
+  return record;
+}
+
+/*! \fn void CAppItemArena::m_Free(gpointer record, gsize size)
+    \brief To give back a record of the current generation, e.g. because its row is removed.
+
+    \param[in] record. It could be NULL.
+    \param[in] size. The size it was allocated with.
+*/
+void CAppItemArena::m_Free(gpointer record, gsize size)
+{
+  if(!record)
+    return;
+
+  size = (size + APP_ITEM_ARENA_ALIGN - 1) & ~(APP_ITEM_ARENA_ALIGN - 1);
+
+  if(!m_FreeRecords)
+    m_FreeRecords = g_hash_table_new(g_direct_hash, g_direct_equal);
+
+  *(gpointer*)record = g_hash_table_lookup(m_FreeRecords, GSIZE_TO_POINTER(size));
+  g_hash_table_insert(m_FreeRecords, GSIZE_TO_POINTER(size), record);
+
+  m_Stats.nRecords--;
+  m_Stats.nRecordBytes -= size;
+  m_Stats.nFreeRecords++;
+  m_Stats.nFreeRecordBytes += size;
+}
+
+/*! \fn gchar* CAppItemArena::m_InternString(const gchar *str)
+    \brief To get the arena copy of a string, sharing it with identical strings stored before.
+
+    \param[in] str. It could be NULL.
+    \return The copy, or NULL if str is NULL. It is valid until the release of its generation and must not be modified.
+             Every call needs one m_ReleaseString() once the copy is not used anymore.
+*/
+gchar* CAppItemArena::m_InternString(const gchar *str)
+{
+  gpointer copy = NULL, users = NULL;
+  gsize length = 0;
+
+  if(!str)
+    return NULL;
+
+  if(!m_Strings)
+  {
+     m_Strings = g_string_chunk_new(APP_ITEM_ARENA_STRING_CHUNK);
+     m_StringTable = g_hash_table_new(g_str_hash, g_str_equal);
+  }
+
+  length = strlen(str) + 1;
+  m_Stats.nStringRequests++;
+  m_Stats.nStringRequestBytes += length;
+
+  /* Like g_string_chunk_insert_const(), with the stored bytes and the users counted. */
+  if( g_hash_table_lookup_extended(m_StringTable, str, &copy, &users) )
+  {
+     if(!users)
+     {
+        m_Stats.nUnusedStrings--;
+        m_Stats.nUnusedStringBytes -= length;
+     }
+
+     g_hash_table_insert( m_StringTable, copy, GUINT_TO_POINTER(GPOINTER_TO_UINT(users) + 1) );
+
+     return (gchar*)copy;
+  }
+
+  copy = g_string_chunk_insert_len(m_Strings, str, length - 1);
+  g_hash_table_insert(m_StringTable, copy, GUINT_TO_POINTER(1));
+  m_Stats.nStrings++;
+  m_Stats.nStringBytes += length;
+
+  return (gchar*)copy;
+}
+
+/*! \fn gboolean CAppItemArena::m_ReleaseString(const gchar *str)
+    \brief To drop a user of an interned string. Strings which are not the copies of the current generation,
+           e.g. the ones of a retired generation or of a mapped file, are ignored.
+
+    \param[in] str. It could be NULL.
+    \return TRUE if the string is not used anymore.
+*/
+gboolean CAppItemArena::m_ReleaseString(const gchar *str)
+{
+  gpointer copy = NULL, users = NULL;
+
+  if( !str || !m_StringTable || !g_hash_table_lookup_extended(m_StringTable, str, &copy, &users) ||
+      copy != (gpointer)str || !users )
+    return false;
+
+  g_hash_table_insert( m_StringTable, copy, GUINT_TO_POINTER(GPOINTER_TO_UINT(users) - 1) );
+
+  if(GPOINTER_TO_UINT(users) > 1)
+    return false;
+
+  m_Stats.nUnusedStrings++;
+  m_Stats.nUnusedStringBytes += strlen(str) + 1;
+
+  return true;
+}
+
+/*! \fn gboolean CAppItemArena::m_IsMostlyUnused(void)
+    \brief To check if most of the stored strings are unused, so building the records again in a new generation
+           would reclaim more than it keeps.
+
+    \param[in] NONE
+    \return TRUE or FALSE
+*/
+gboolean CAppItemArena::m_IsMostlyUnused(void)
+{
+  return ( m_Stats.nUnusedStringBytes > APP_ITEM_ARENA_STRING_CHUNK &&
+           m_Stats.nUnusedStringBytes * 2 > m_Stats.nStringBytes );
+}
+
+/*! \fn void CAppItemArena::m_NewGeneration(void)
+    \brief To start empty. The records and strings handed out so far stay valid until m_ReleaseRetired().
+
+    \param[in] NONE
+    \return NONE
+*/
+void CAppItemArena::m_NewGeneration(void)
+{
+  APP_ITEM_ARENA_GENERATION *generation = g_slice_new0(APP_ITEM_ARENA_GENERATION);
+
+  generation->blocks = m_Blocks;
+  generation->strings = m_Strings;
+  generation->stringTable = m_StringTable;
+  m_Retired = g_slist_prepend(m_Retired, generation);
+
+  m_Blocks = NULL;
+  m_nBlockUsed = 0;
+  m_nBlockSize = 0;
+  m_Strings = NULL;
+  m_StringTable = NULL;
+
+  if(m_FreeRecords)
+    g_hash_table_destroy(m_FreeRecords);
+
+  m_FreeRecords = NULL;
+
+  memset(&m_Stats, 0, sizeof(m_Stats));
+}
+
+/*! \fn void CAppItemArena::m_ReleaseRetired(void)
+    \brief To free the blocks and strings of the former generations, once nothing refers to them.
+
+    \param[in] NONE
+    \return NONE
+*/
+void CAppItemArena::m_ReleaseRetired(void)
+{
+  g_slist_free_full(m_Retired, free_generation);
+  m_Retired = NULL;
+}
+
+/*! \fn void CAppItemArena::m_Clear(void)
+    \brief To release all records and strings at once, the ones of the former generations too.
+
+    \param[in] NONE
+    \return NONE
+*/
+void CAppItemArena::m_Clear(void)
+{
+  m_ReleaseRetired();
+
+  g_slist_free_full(m_Blocks, g_free);
+  m_Blocks = NULL;
+  m_nBlockUsed = 0;
+  m_nBlockSize = 0;
+
+  if(m_FreeRecords)
+    g_hash_table_destroy(m_FreeRecords);
+
+  m_FreeRecords = NULL;
+
+  if(m_Strings)
+  {
+     g_hash_table_destroy(m_StringTable);
+     m_StringTable = NULL;
+     g_string_chunk_free(m_Strings);
+     m_Strings = NULL;
+  }
+
+  memset(&m_Stats, 0, sizeof(m_Stats));
+}
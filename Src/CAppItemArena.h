@@ -0,0 +1,75 @@
+/*! \file    CAppItemArena.h
+    \brief   Bump allocator holding application item records and their strings.
+
+    \date    2026-10-17
+    \version 1.0
+
+    \b Change_History:
+    \n 1) 2026-10-17 initialized.
+*/
+
+#ifndef __CAPPITEMARENA_H
+#define __CAPPITEMARENA_H
+
+#include <glib.h>
+
+/*! \def APP_ITEM_ARENA_BLOCK_SIZE
+    \brief The size of one record block. Requests larger than this get a block of their own.
+*/
+#define APP_ITEM_ARENA_BLOCK_SIZE  (16 * 1024)
+
+/*! \struct APP_ITEM_ARENA_STATS
+    \brief The memory held by an arena.
+*/
+typedef struct {
+  guint nBlocks;
+  gsize nBlockBytes;          /*!< The size of all record blocks. */
+  guint nRecords;
+  gsize nRecordBytes;         /*!< The bytes handed out as records, the rest of the blocks is unused. */
+  guint nStrings;             /*!< The distinct strings stored. */
+  gsize nStringBytes;         /*!< Their bytes including the terminating NULs. */
+  guint nStringRequests;      /*!< The strings interned, identical ones included. */
+  gsize nStringRequestBytes;  /*!< Their bytes, the difference with nStringBytes is saved by sharing. */
+  guint nFreeRecords;         /*!< The records freed and not handed out again yet. */
+  gsize nFreeRecordBytes;
+  guint nUnusedStrings;       /*!< The stored strings released by all their users, kept until the next generation. */
+  gsize nUnusedStringBytes;
+} APP_ITEM_ARENA_STATS;
+
+/*! \class CAppItemArena
+    \brief Allocate records from large contiguous blocks and intern strings in a GStringChunk.
+
+    A freed record is handed out again to the next request of its size. Identical strings(e.g. the same "Exec"
+    or icon name) are stored only once and counted by their users; a string released by all of them stays in
+    the chunk, only counted as unused, until its generation is released. m_NewGeneration() retires the blocks
+    and strings, which stay valid until m_ReleaseRetired(), so a new set of rows can be built while the old
+    one is still shown. m_Clear() frees everything at once.
+    Not thread safe, it is used by the GTK main thread only.
+*/
+class CAppItemArena
+{
+  private:
+    GSList *m_Blocks;          /*!< The record blocks, the current one first. */
+    gsize m_nBlockUsed;        /*!< The bytes handed out from the current block. */
+    gsize m_nBlockSize;        /*!< The size of the current block. */
+    GHashTable *m_FreeRecords; /*!< Aligned size -> the first freed record of that size, which holds the next one. */
+    GStringChunk *m_Strings;   /*!< The interned strings. */
+    GHashTable *m_StringTable; /*!< The strings of m_Strings -> the number of their users, to find an identical one. */
+    GSList *m_Retired;         /*!< The blocks and string chunks of the former generations, still in use. */
+    APP_ITEM_ARENA_STATS m_Stats;
+
+  public:
+    CAppItemArena();
+    ~CAppItemArena();
+
+    gpointer m_Alloc(gsize size);
+    void m_Free(gpointer record, gsize size);
+    gchar* m_InternString(const gchar *str);
+    gboolean m_ReleaseString(const gchar *str);
+    gboolean m_IsMostlyUnused(void);
+    void m_NewGeneration(void);
+    void m_ReleaseRetired(void);
+    void m_Clear(void);
+    void m_GetStats(APP_ITEM_ARENA_STATS *stats) { *stats = m_Stats; }  /*!< To get the blocks, records and strings held. */
+};
+#endif /* __CAPPITEMARENA_H */
@@ -0,0 +1,410 @@
+/*! \file CAppSearchIndex.cpp
+    \brief N-gram index for type-ahead searching of application items.
+
+    \date 2026-10-17
+    \version 1.0
+
+    \b Change_History:
+    \n (1) 2026-10-17 initial version.
+*/
+
+#include <string.h>
+
+#include "CAppSearchIndex.h"
+
+/*! \struct SEARCH_DOCUMENT
+    \brief The searchable text of an item: its lower-cased name, comment and command basename separated by new lines.
+*/
+typedef struct {
+  gpointer item;
+  gchar *text;
+} SEARCH_DOCUMENT;
+
+/*! \def SEARCH_FIELD_SEPARATOR
+    \brief The separator of fields in a document. Grams containing it are not indexed.
+*/
+#define SEARCH_FIELD_SEPARATOR  '\n'
+
+//------------------------ Helper Functions
+/*! \fn static guint32 make_gram_key(const gchar *gram, guint len)
+    \brief To pack a gram of 1 to 3 bytes and its length into a hash key.
+
+    \param[in] gram.
+    \param[in] len.
+    \return The key.
+*/
+static guint32 make_gram_key(const gchar *gram, guint len)
+{
+  guint32 key = len;
+
+  for(guint i = 0; i < len; i++)
+     key = (key << 8) | (guchar)gram[i];
+
+  return key;
+}
+
+/*! \fn static void free_document(gpointer data)
+    \brief To release a document.
+
+    \param[in] data. The SEARCH_DOCUMENT object.
+*/
+static void free_document(gpointer data)
+{
+  SEARCH_DOCUMENT *doc = (SEARCH_DOCUMENT*)data;
+
+  g_free(doc->text);
+  g_free(doc);
+}
+
+/*! \fn static void free_posting(gpointer data)
+    \brief To release a posting list.
+
+    \param[in] data. The GArray object.
+*/
+static void free_posting(gpointer data)
+{
+  g_array_free( (GArray*)data, TRUE );
+}
+
+/*! \fn static gboolean posting_contains(GArray *posting, guint id)
+    \brief To check if a posting list has a document, by binary search.
+
+    \param[in] posting.
+    \param[in] id.
+    \return TRUE or FALSE
+*/
+static gboolean posting_contains(GArray *posting, guint id)
+{
+  guint low = 0, high = posting->len;
+
+  while(low < high)
+  {
+     guint mid = (low + high) / 2;
+     guint value = g_array_index(posting, guint, mid);
+
+     if(value == id)
+       return true;
+
+     if(value < id)
+       low = mid + 1;
+     else
+       high = mid;
+  }
+
+  return false;
+}
+
+/*! \fn static gchar* get_exec_basename(const gchar *exec)
+    \brief To get the basename of the program of a Desktop Entry "Exec" value.
+
+    \param[in] exec. It could be NULL.
+    \return Newly allocated string, or NULL.
+*/
+static gchar* get_exec_basename(const gchar *exec)
+{
+  gchar *program = NULL, *basename = NULL;
+  const gchar *end = NULL;
+
+  if(!exec)
+    return NULL;
+
+  while(*exec == ' ')
+    exec++;
+
+  end = strchr(exec, ' ');
+  program = end ? g_strndup(exec, end - exec) : g_strdup(exec);
+  basename = g_path_get_basename(program);
+
+  g_free(program);
+
+  return basename;
+}
+
+//--------------- Class Methos Implementation.
+/*! \fn CAppSearchIndex::CAppSearchIndex()
+    \brief CAppSearchIndex constructor
+*/
+CAppSearchIndex::CAppSearchIndex()
+{
+  m_Documents = g_ptr_array_new_with_free_func(free_document);
+  m_Postings = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, free_posting);
+  m_ItemDocs = g_hash_table_new(g_direct_hash, g_direct_equal);
+  m_nRemoved = 0;
+}
+
+/*! \fn CAppSearchIndex::~CAppSearchIndex()
+    \brief CAppSearchIndex destructor
+*/
+CAppSearchIndex::~CAppSearchIndex()
+{
+  g_ptr_array_free(m_Documents, TRUE);
+  g_hash_table_destroy(m_Postings);
+  g_hash_table_destroy(m_ItemDocs);
+}
+
+/*! \fn void CAppSearchIndex::m_AddGrams(guint id, const gchar *text)
+    \brief To add a document to the posting lists of all its grams.
+
+    \param[in] id. The document id, larger than every id added before.
+    \param[in] text. The lower-cased text of the document.
+*/
+void CAppSearchIndex::m_AddGrams(guint id, const gchar *text)
+{
+  for(const gchar *p = text; *p; p++)
+  {
+     for(guint len = 1; len <= SEARCH_MAX_GRAM && p[len - 1]; len++)
+     {
+        gpointer key = NULL;
+        GArray *posting = NULL;
+
+        if(p[len - 1] == SEARCH_FIELD_SEPARATOR)
+          break;
+
+        key = GUINT_TO_POINTER( make_gram_key(p, len) );
+        posting = (GArray*)g_hash_table_lookup(m_Postings, key);
+
+        if(!posting)
+        {
+           posting = g_array_new(FALSE, FALSE, sizeof(guint));
+           g_hash_table_insert(m_Postings, key, posting);
+        }
+
+        /* A gram repeated in the document is listed once. */
+        if( posting->len == 0 || g_array_index(posting, guint, posting->len - 1) != id )
+          g_array_append_val(posting, id);
+     }
+  }
+}
+
+/*! \fn void CAppSearchIndex::m_Add(gpointer item, const gchar *name, const gchar *comment, const gchar *exec)
+    \brief To index an item. An item indexed before is indexed again with the new values.
+
+    \param[in] item. The item returned by m_Query().
+    \param[in] name. It could be NULL.
+    \param[in] comment. It could be NULL.
+    \param[in] exec. The Desktop Entry "Exec" value, only its program basename is searchable. It could be NULL.
+*/
+void CAppSearchIndex::m_Add(gpointer item, const gchar *name, const gchar *comment, const gchar *exec)
+{
+  SEARCH_DOCUMENT *doc = NULL;
+  gchar *program = get_exec_basename(exec);
+  gchar *text = g_strdup_printf("%s\n%s\n%s", name ? name : "", comment ? comment : "", program ? program : "");
+
+  m_Remove(item);
+
+  doc = g_new0(SEARCH_DOCUMENT, 1);
+  doc->item = item;
+  doc->text = g_utf8_strdown(text, -1);
+
+  g_ptr_array_add(m_Documents, doc);
+  g_hash_table_insert(m_ItemDocs, item, GUINT_TO_POINTER(m_Documents->len));
+
+  m_AddGrams(m_Documents->len - 1, doc->text);
+
+  g_free(text);
+  g_free(program);
+}
+
+/*! \fn void CAppSearchIndex::m_Remove(gpointer item)
+    \brief To stop finding an item. Its text is released, its posting list entries are skipped until the
+           posting lists are compacted.
+
+    \param[in] item.
+*/
+void CAppSearchIndex::m_Remove(gpointer item)
+{
+  guint id = GPOINTER_TO_UINT( g_hash_table_lookup(m_ItemDocs, item) );
+  SEARCH_DOCUMENT *doc = NULL;
+
+  if(id == 0)
+    return;
+
+  doc = (SEARCH_DOCUMENT*)g_ptr_array_index(m_Documents, id - 1);
+  doc->item = NULL;
+  g_free(doc->text);
+  doc->text = NULL;
+
+  g_hash_table_remove(m_ItemDocs, item);
+  m_nRemoved++;
+
+  if( m_nRemoved >= SEARCH_COMPACT_MIN && m_nRemoved * 2 > m_Documents->len )
+    m_Compact();
+}
+
+/*! \fn void CAppSearchIndex::m_Compact(void)
+    \brief To drop the removed documents: the kept ones get new ids and the posting lists are built again.
+
+    \param[in] NONE
+    \return NONE
+*/
+void CAppSearchIndex::m_Compact(void)
+{
+  guint nKept = 0;
+
+  g_hash_table_remove_all(m_Postings);
+
+  for(guint i = 0; i < m_Documents->len; i++)
+  {
+     SEARCH_DOCUMENT *doc = (SEARCH_DOCUMENT*)g_ptr_array_index(m_Documents, i);
+
+     if(!doc->item)
+     {
+        free_document(doc);
+        continue;
+     }
+
+     g_ptr_array_index(m_Documents, nKept) = doc;
+     g_hash_table_insert(m_ItemDocs, doc->item, GUINT_TO_POINTER(nKept + 1));
+     m_AddGrams(nKept, doc->text);
+     nKept++;
+  }
+
+  /* The removed documents are released above, not by the free function. */
+  g_ptr_array_set_free_func(m_Documents, NULL);
+  g_ptr_array_set_size(m_Documents, nKept);
+  g_ptr_array_set_free_func(m_Documents, free_document);
+
+  m_nRemoved = 0;
+}
+
+/*! \fn guint CAppSearchIndex::m_Query(const gchar *text, GHashTable *matches)
+    \brief To find the items containing a text in their name, comment or command basename.
+
+    \param[in] text. The searched text, it is matched case insensitively.
+    \param[out] matches. The found items are added to this set(a GHashTable with direct keys).
+    \return The number of found items.
+*/
+guint CAppSearchIndex::m_Query(const gchar *text, GHashTable *matches)
+{
+  gchar *query = NULL;
+  GArray **postings = NULL;
+  guint len = 0, nPostings = 0, nShortest = 0, nFound = 0;
+
+  if( G_UNLIKELY(!text || !*text) )
+    return 0;
+
+  query = g_utf8_strdown(text, -1);
+  len = strlen(query);
+
+  /* A query longer than a gram is looked up by its trigrams. */
+  nPostings = (len <= SEARCH_MAX_GRAM)? 1 : len - SEARCH_MAX_GRAM + 1;
+  postings = g_new0(GArray*, nPostings);
+
+  for(guint i = 0; i < nPostings; i++)
+  {
+     postings[i] = (GArray*)g_hash_table_lookup( m_Postings, GUINT_TO_POINTER( make_gram_key(query + i, MIN(len, (guint)SEARCH_MAX_GRAM)) ) );
+
+     /* A gram no document has. */
+     if(!postings[i])
+     {
+        g_free(postings);
+        g_free(query);
+        return 0;
+     }
+
+     if(postings[i]->len < postings[nShortest]->len)
+       nShortest = i;
+  }
+
+  for(guint n = 0; n < postings[nShortest]->len; n++)
+  {
+     guint id = g_array_index(postings[nShortest], guint, n);
+     SEARCH_DOCUMENT *doc = (SEARCH_DOCUMENT*)g_ptr_array_index(m_Documents, id);
+     gboolean bCandidate = (doc->item != NULL);
+
+     for(guint i = 0; bCandidate && i < nPostings; i++)
+     {
+        if(i != nShortest)
+          bCandidate = posting_contains(postings[i], id);
+     }
+
+     /* The trigrams may be scattered in the document, the candidate is confirmed by the whole text. */
+     if( bCandidate && (len <= SEARCH_MAX_GRAM || strstr(doc->text, query)) )
+     {
+        g_hash_table_add(matches, doc->item);
+        nFound++;
+     }
+  }
+
+  g_free(postings);
+  g_free(query);
+
+  return nFound;
+}
+
+/*! \fn guint CAppSearchIndex::m_Refine(const gchar *text, GHashTable *matches)
+    \brief To keep only the found items which also contain a text, e.g. the previous search text typed further.
+
+    Only the items in the set are checked, the posting lists are not read.
+
+    \param[in] text. The searched text, it is matched case insensitively.
+    \param[in,out] matches. The items found by m_Query() for a part of the text.
+    \return The number of items left in the set.
+*/
+guint CAppSearchIndex::m_Refine(const gchar *text, GHashTable *matches)
+{
+  GHashTableIter iter;
+  gpointer item = NULL;
+  gchar *query = NULL;
+
+  if( G_UNLIKELY(!text || !*text) )
+    return g_hash_table_size(matches);
+
+  query = g_utf8_strdown(text, -1);
+  g_hash_table_iter_init(&iter, matches);
+
+  while( g_hash_table_iter_next(&iter, &item, NULL) )
+  {
+     guint id = GPOINTER_TO_UINT( g_hash_table_lookup(m_ItemDocs, item) );
+
+     if( id == 0 || !strstr( ((SEARCH_DOCUMENT*)g_ptr_array_index(m_Documents, id - 1))->text, query ) )
+       g_hash_table_iter_remove(&iter);
+  }
+
+  g_free(query);
+
+  return g_hash_table_size(matches);
+}
+
+/*! \fn void CAppSearchIndex::m_Clear(void)
+    \brief To remove all items and release the posting lists.
+
+    \param[in] NONE
+    \return NONE
+*/
+void CAppSearchIndex::m_Clear(void)
+{
+  g_ptr_array_set_size(m_Documents, 0);
+  g_hash_table_remove_all(m_Postings);
+  g_hash_table_remove_all(m_ItemDocs);
+  m_nRemoved = 0;
+}
+
+/*! \fn void CAppSearchIndex::m_GetStats(guint &nDocuments, guint &nGrams, gsize &nBytes)
+    \brief To get the size of the index.
+
+    \param[out] nDocuments. The documents, removed ones included until the posting lists are compacted.
+    \param[out] nGrams. The posting lists.
+    \param[out] nBytes. The bytes of the documents and the posting lists, without the hash tables.
+*/
+void CAppSearchIndex::m_GetStats(guint &nDocuments, guint &nGrams, gsize &nBytes)
+{
+  GHashTableIter iter;
+  gpointer value = NULL;
+
+  nDocuments = m_Documents->len;
+  nGrams = g_hash_table_size(m_Postings);
+  nBytes = 0;
+
+  for(guint i = 0; i < m_Documents->len; i++)
+  {
+     SEARCH_DOCUMENT *doc = (SEARCH_DOCUMENT*)g_ptr_array_index(m_Documents, i);
+
+     nBytes += sizeof(SEARCH_DOCUMENT) + (doc->text ? strlen(doc->text) + 1 : 0);
+  }
+
+  g_hash_table_iter_init(&iter, m_Postings);
+
+  while( g_hash_table_iter_next(&iter, NULL, &value) )
+     nBytes += ((GArray*)value)->len * sizeof(guint);
+}
@@ -0,0 +1,59 @@
+/*! \file    CAppSearchIndex.h
+    \brief   N-gram index for type-ahead searching of application items.
+
+    \date    2026-10-17
+    \version 1.0
+
+    \b Change_History:
+    \n 1) 2026-10-17 initialized.
+*/
+
+#ifndef __CAPPSEARCHINDEX_H
+#define __CAPPSEARCHINDEX_H
+
+#include <glib.h>
+
+/*! \def SEARCH_MAX_GRAM
+    \brief The longest grams indexed. Queries up to this length are answered by one posting list.
+*/
+#define SEARCH_MAX_GRAM  3
+
+/*! \def SEARCH_COMPACT_MIN
+    \brief The removed documents kept before the posting lists are built again without them.
+*/
+#define SEARCH_COMPACT_MIN  64
+
+/*! \class CAppSearchIndex
+    \brief Find the items whose name, comment or command contains a text, case insensitively.
+
+    Every item is indexed by all 1, 2 and 3 byte grams of its lower-cased searchable text.
+    A query of up to 3 bytes is the posting list of the query itself. A longer query intersects
+    the posting lists of its trigrams and checks only the remaining candidates with strstr(),
+    so the cost follows the size of the shortest posting list, not the number of items.
+    A removed document is dropped at once from the results, and from the posting lists when the removed
+    documents outnumber the others. m_Refine() narrows the found items of a query to a longer text.
+    Not thread safe, it is used by the GTK main thread only.
+*/
+class CAppSearchIndex
+{
+  private:
+    GPtrArray *m_Documents;   /*!< Document id -> SEARCH_DOCUMENT. The item of a removed document is NULL. */
+    GHashTable *m_Postings;   /*!< Gram key -> GArray of ascending document ids. */
+    GHashTable *m_ItemDocs;   /*!< Item -> the current document id plus one. */
+    guint m_nRemoved;         /*!< The removed documents still in m_Documents. */
+
+    void m_AddGrams(guint id, const gchar *text);
+    void m_Compact(void);
+
+  public:
+    CAppSearchIndex();
+    ~CAppSearchIndex();
+
+    void m_Add(gpointer item, const gchar *name, const gchar *comment, const gchar *exec);
+    void m_Remove(gpointer item);
+    guint m_Query(const gchar *text, GHashTable *matches);
+    guint m_Refine(const gchar *text, GHashTable *matches);
+    void m_Clear(void);
+    void m_GetStats(guint &nDocuments, guint &nGrams, gsize &nBytes);
+};
+#endif /* __CAPPSEARCHINDEX_H */
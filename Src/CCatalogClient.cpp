@@ -0,0 +1,443 @@
+/*! \file CCatalogClient.cpp
+    \brief Client of the catalog daemon: list, search and resolve queries and the shared icons.
+
+    \date 2026-10-17
+    \version 1.0
+
+    \b Change_History:
+    \n (1) 2026-10-17 initial version.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+
+#include "CCatalogClient.h"
+
+/*! \def CATALOG_READ_SIZE
+    \brief The number of bytes received at once.
+*/
+#define CATALOG_READ_SIZE  16384
+
+/*! \def CATALOG_ANSWER_TIMEOUT
+    \brief The milliseconds the daemon may take to connect, take a request and send its whole answer.
+*/
+#define CATALOG_ANSWER_TIMEOUT  2000
+
+//------------------------ Callback Functions
+/*! \fn static void cb_unmap_segment(guchar *pixels, gpointer data)
+    \brief Release the mapped icon segment when a pixel buffer wrapping it is finalized.
+
+    \param[in] pixels. The pixel data of the pixel buffer.
+    \param[in] data. The GMappedFile object.
+*/
+static void cb_unmap_segment(guchar *pixels, gpointer data)
+{
+  pixels = pixels;
+
+  g_mapped_file_unref( (GMappedFile*)data );
+}
+
+/*! \fn static gchar** split_record(const gchar *line)
+    \brief To split a record line into its fields and remove the escapes.
+
+    \param[in] line.
+    \return Newly allocated NULL terminated field vector.
+*/
+static gchar** split_record(const gchar *line)
+{
+  gchar **fields = g_strsplit(line, "\t", -1);
+
+  for(gchar **field = fields; *field; field++)
+  {
+     if( strchr(*field, '\\') )
+     {
+        gchar *unescaped = g_strcompress(*field);
+
+        g_free(*field);
+        *field = unescaped;
+     }
+  }
+
+  return fields;
+}
+
+//--------------- Class Methos Implementation.
+/*! \fn CCatalogClient::CCatalogClient()
+    \brief CCatalogClient constructor
+*/
+CCatalogClient::CCatalogClient()
+{
+  m_nFd = -1;
+  m_Buffer = g_string_new(NULL);
+  m_nDeadline = 0;
+}
+
+/*! \fn CCatalogClient::~CCatalogClient()
+    \brief CCatalogClient destructor
+*/
+CCatalogClient::~CCatalogClient()
+{
+  m_Disconnect();
+  g_string_free(m_Buffer, TRUE);
+}
+
+/*! \fn gchar* CCatalogClient::m_GetSocketName(void)
+    \brief To get the full name of the daemon's socket.
+
+    \param[in] NONE
+    \return Newly allocated file name.
+*/
+gchar* CCatalogClient::m_GetSocketName(void)
+{
+  /* g_get_user_runtime_dir() falls back to the user cache directory if $XDG_RUNTIME_DIR is not set. */
+  return g_build_filename( g_get_user_runtime_dir(), CATALOG_SOCKET_NAME, NULL );
+}
+
+/*! \fn gboolean CCatalogClient::m_Connect(void)
+    \brief To connect to the daemon of the current user.
+
+    \param[in] NONE
+    \return TRUE or FALSE. FALSE if no daemon is running.
+*/
+gboolean CCatalogClient::m_Connect(void)
+{
+  struct sockaddr_un address;
+  struct timeval timeout = { CATALOG_ANSWER_TIMEOUT / 1000, (CATALOG_ANSWER_TIMEOUT % 1000) * 1000 };
+  gchar *socket_name = NULL;
+
+  if(m_nFd >= 0)
+    return true;
+
+  socket_name = m_GetSocketName();
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+
+  if( strlen(socket_name) >= sizeof(address.sun_path) )
+  {
+     g_free(socket_name);
+     return false;
+  }
+
+  strcpy(address.sun_path, socket_name);
+  g_free(socket_name);
+
+  m_nFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+  if(m_nFd < 0)
+    return false;
+
+  /* A daemon which is stuck can not block the connection and the requests, which are sent at once, for long. */
+  setsockopt(m_nFd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+  if( connect(m_nFd, (struct sockaddr*)&address, sizeof(address)) != 0 )
+  {
+     m_Disconnect();
+     return false;
+  }
+
+  return true;
+}
+
+/*! \fn void CCatalogClient::m_Disconnect(void)
+    \brief To close the connection. The icons got from m_MapIcons() stay valid.
+
+    \param[in] NONE
+    \return NONE
+*/
+void CCatalogClient::m_Disconnect(void)
+{
+  if(m_nFd >= 0)
+    close(m_nFd);
+
+  m_nFd = -1;
+  g_string_truncate(m_Buffer, 0);
+}
+
+/*! \fn gboolean CCatalogClient::m_SendRequest(const gchar *request, const gchar *argument)
+    \brief To send a request line. A failure closes the connection.
+
+    \param[in] request. One of the CATALOG_REQUEST_* names.
+    \param[in] argument. It could be NULL. Tabs and newlines are not allowed in it.
+    \return TRUE or FALSE
+*/
+gboolean CCatalogClient::m_SendRequest(const gchar *request, const gchar *argument)
+{
+  gchar *line = NULL;
+  gsize nSent = 0, length = 0;
+
+  if(m_nFd < 0)
+    return false;
+
+  if( argument && strpbrk(argument, "\t\r\n") )
+    return false;
+
+  line = argument ? g_strdup_printf("%s\t%s\n", request, argument) : g_strdup_printf("%s\n", request);
+  length = strlen(line);
+  m_nDeadline = g_get_monotonic_time() + CATALOG_ANSWER_TIMEOUT * G_GINT64_CONSTANT(1000);
+
+  while(nSent < length)
+  {
+     ssize_t n = send(m_nFd, line + nSent, length - nSent, MSG_NOSIGNAL);
+
+     if(n < 0 && errno == EINTR)
+       continue;
+
+     if(n <= 0)
+     {
+        g_free(line);
+        m_Disconnect();
+        return false;
+     }
+
+     nSent += n;
+  }
+
+  g_free(line);
+
+  return true;
+}
+
+/*! \fn gchar* CCatalogClient::m_ReadLine(gint *fd)
+    \brief To receive the next line of the answer. A failure, or the answer not complete in time, closes the connection.
+
+    \param[out] fd. It could be NULL. The file descriptor attached to the received bytes, if any, otherwise untouched.
+    \return Newly allocated line without the newline, or NULL.
+*/
+gchar* CCatalogClient::m_ReadLine(gint *fd)
+{
+  gchar *newline = NULL, *line = NULL;
+
+  while( !(newline = (gchar*)memchr(m_Buffer->str, '\n', m_Buffer->len)) )
+  {
+     gchar data[CATALOG_READ_SIZE];
+     gchar control[CMSG_SPACE(sizeof(int))];
+     struct iovec iov = { data, sizeof(data) };
+     struct msghdr message;
+     struct cmsghdr *cmsg = NULL;
+     struct pollfd pfd = { m_nFd, POLLIN, 0 };
+     gint64 remaining = (m_nDeadline - g_get_monotonic_time()) / 1000;
+     gint nReady = (remaining > 0) ? poll(&pfd, 1, (gint)remaining) : 0;
+     ssize_t n = 0;
+
+     if(nReady < 0 && errno == EINTR)
+       continue;
+
+     /* Nothing is received before the deadline: the daemon is too busy or stuck. */
+     if(nReady <= 0)
+     {
+        m_Disconnect();
+        return NULL;
+     }
+
+     memset(&message, 0, sizeof(message));
+     message.msg_iov = &iov;
+     message.msg_iovlen = 1;
+     message.msg_control = control;
+     message.msg_controllen = sizeof(control);
+
+     n = recvmsg(m_nFd, &message, MSG_CMSG_CLOEXEC);
+
+     if(n < 0 && errno == EINTR)
+       continue;
+
+     if(n <= 0)
+     {
+        m_Disconnect();
+        return NULL;
+     }
+
+     for(cmsg = CMSG_FIRSTHDR(&message); cmsg; cmsg = CMSG_NXTHDR(&message, cmsg))
+     {
+        if(cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS)
+        {
+           int received = -1;
+
+           memcpy(&received, CMSG_DATA(cmsg), sizeof(int));
+
+           if(fd)
+             *fd = received;
+           else
+             close(received);
+        }
+     }
+
+     g_string_append_len(m_Buffer, data, n);
+  }
+
+  line = g_strndup(m_Buffer->str, newline - m_Buffer->str);
+  g_string_erase(m_Buffer, 0, newline - m_Buffer->str + 1);
+
+  return line;
+}
+
+/*! \fn gboolean CCatalogClient::m_ReadRecords(GPtrArray *records, gint *fd)
+    \brief To receive the records of an answer up to its end line.
+
+    \param[out] records. The field vectors are appended, it should free them with g_strfreev().
+    \param[out] fd. It could be NULL. The file descriptor attached to the answer, if any.
+    \return TRUE or FALSE
+*/
+gboolean CCatalogClient::m_ReadRecords(GPtrArray *records, gint *fd)
+{
+  gchar *line = NULL;
+
+  while( (line = m_ReadLine(fd)) )
+  {
+     if( strcmp(line, CATALOG_RECORD_END) == 0 )
+     {
+        g_free(line);
+        return true;
+     }
+
+     g_ptr_array_add(records, split_record(line));
+     g_free(line);
+  }
+
+  return false;
+}
+
+/*! \fn gboolean CCatalogClient::m_List(GPtrArray *records)
+    \brief To get all categories and their applications.
+
+    \param[out] records. The "C" and "E" records, freed with g_strfreev().
+    \return TRUE or FALSE
+*/
+gboolean CCatalogClient::m_List(GPtrArray *records)
+{
+  return m_SendRequest(CATALOG_REQUEST_LIST, NULL) && m_ReadRecords(records, NULL);
+}
+
+/*! \fn gboolean CCatalogClient::m_Search(const gchar *text, GPtrArray *records)
+    \brief To get the applications whose name, comment or command contains a text.
+
+    \param[in] text.
+    \param[out] records. The "C" and "E" records, freed with g_strfreev().
+    \return TRUE or FALSE
+*/
+gboolean CCatalogClient::m_Search(const gchar *text, GPtrArray *records)
+{
+  return m_SendRequest(CATALOG_REQUEST_SEARCH, text) && m_ReadRecords(records, NULL);
+}
+
+/*! \fn gboolean CCatalogClient::m_Resolve(const gchar *name, gchar **icon_file, gchar **show_file)
+    \brief To get the icon files of an icon name from the daemon.
+
+    \param[in] name.
+    \param[out] icon_file. Newly allocated image file in the icon theme at the rows' size, or NULL.
+    \param[out] show_file. Newly allocated full name of the icon file at the shown size, or NULL.
+    \return TRUE or FALSE
+*/
+gboolean CCatalogClient::m_Resolve(const gchar *name, gchar **icon_file, gchar **show_file)
+{
+  GPtrArray *records = g_ptr_array_new_with_free_func( (GDestroyNotify)g_strfreev );
+  gchar **fields = NULL;
+  gboolean bRet = false;
+
+  *icon_file = NULL;
+  *show_file = NULL;
+
+  if( m_SendRequest(CATALOG_REQUEST_RESOLVE, name) && m_ReadRecords(records, NULL) && records->len == 1 )
+  {
+     fields = (gchar**)g_ptr_array_index(records, 0);
+
+     if( g_strv_length(fields) == N_CATALOG_RESOLVE_FIELDS && strcmp(fields[CATALOG_FIELD_TYPE], CATALOG_RECORD_RESOLVE) == 0 )
+     {
+        *icon_file = *fields[CATALOG_RESOLVE_ICON_FILE] ? g_strdup(fields[CATALOG_RESOLVE_ICON_FILE]) : NULL;
+        *show_file = *fields[CATALOG_RESOLVE_SHOW_FILE] ? g_strdup(fields[CATALOG_RESOLVE_SHOW_FILE]) : NULL;
+        bRet = true;
+     }
+  }
+
+  g_ptr_array_free(records, TRUE);
+
+  return bRet;
+}
+
+/*! \fn GHashTable* CCatalogClient::m_MapIcons(gint *size)
+    \brief To map the decoded icons of the daemon. Nothing is decoded or copied, the pixel buffers refer
+           to the shared segment, which is unmapped when the last of them is finalized.
+
+    \param[out] size. The size the icons were decoded for.
+    \return Icon name -> GdkPixbuf, destroyed with g_hash_table_destroy(). NULL if the segment can not be mapped.
+*/
+GHashTable* CCatalogClient::m_MapIcons(gint *size)
+{
+  GPtrArray *records = g_ptr_array_new_with_free_func( (GDestroyNotify)g_strfreev );
+  GHashTable *icons = NULL;
+  GMappedFile *mapped = NULL;
+  const gchar *contents = NULL, *strings = NULL;
+  const CATALOG_ICONS_HEADER *header = NULL;
+  const CATALOG_ICON *table = NULL;
+  gsize length = 0;
+  gint fd = -1;
+
+  if( !m_SendRequest(CATALOG_REQUEST_ICONS, NULL) || !m_ReadRecords(records, &fd) || fd < 0 )
+  {
+     if(fd >= 0)
+       close(fd);
+
+     g_ptr_array_free(records, TRUE);
+     return NULL;
+  }
+
+  g_ptr_array_free(records, TRUE);
+
+  /* The daemon sealed the segment, so its length and contents can not change under the mapping. */
+  mapped = g_mapped_file_new_from_fd(fd, FALSE, NULL);
+  close(fd);
+
+  if(!mapped)
+    return NULL;
+
+  contents = g_mapped_file_get_contents(mapped);
+  length = g_mapped_file_get_length(mapped);
+  header = (const CATALOG_ICONS_HEADER*)contents;
+
+  if( length < sizeof(CATALOG_ICONS_HEADER) ||
+      header->magic != CATALOG_ICONS_MAGIC || header->version != CATALOG_ICONS_VERSION || header->length != length ||
+      header->icons_offset < sizeof(CATALOG_ICONS_HEADER) ||
+      (guint64)header->icons_offset + (guint64)header->n_icons * sizeof(CATALOG_ICON) > length ||
+      (guint64)header->strings_offset + header->strings_length > length ||
+      header->strings_length == 0 || contents[header->strings_offset + header->strings_length - 1] != '\0' )
+  {
+     g_mapped_file_unref(mapped);
+     return NULL;
+  }
+
+  table = (const CATALOG_ICON*)(contents + header->icons_offset);
+  strings = contents + header->strings_offset;
+  icons = g_hash_table_new_full(g_str_hash, g_str_equal, NULL, g_object_unref);
+
+  for(guint i = 0; i < header->n_icons; i++)
+  {
+     const CATALOG_ICON *icon = &table[i];
+     guint nChannels = icon->has_alpha ? 4 : 3;
+
+     if( icon->name >= header->strings_length || icon->width == 0 || icon->height == 0 ||
+         icon->rowstride < (guint64)icon->width * nChannels ||
+         (guint64)icon->data_offset + (guint64)icon->rowstride * icon->height > length )
+       continue;
+
+     /* Every pixel buffer holds a reference of the mapping, the names are in the mapping as well. */
+     g_hash_table_insert( icons, (gpointer)(strings + icon->name),
+                          gdk_pixbuf_new_from_data( (const guchar*)(contents + icon->data_offset),
+                                                    GDK_COLORSPACE_RGB, icon->has_alpha ? TRUE : FALSE, 8,
+                                                    icon->width, icon->height, icon->rowstride,
+                                                    cb_unmap_segment, g_mapped_file_ref(mapped) ) );
+  }
+
+  *size = header->icon_size;
+
+  /* The pixel buffers keep the mapping. */
+  g_mapped_file_unref(mapped);
+
+  return icons;
+}
@@ -0,0 +1,52 @@
+/*! \file    CCatalogClient.h
+    \brief   Client of the catalog daemon: list, search and resolve queries and the shared icons.
+
+    \date    2026-10-17
+    \version 1.0
+
+    \b Change_History:
+    \n 1) 2026-10-17 initialized.
+*/
+
+#ifndef __CCATALOGCLIENT_H
+#define __CCATALOGCLIENT_H
+
+#include <glib.h>
+#include <gdk-pixbuf/gdk-pixbuf.h>
+
+#include "CCatalogProtocol.h"
+
+/*! \class CCatalogClient
+    \brief Query a running catalog daemon over its Unix domain socket.
+
+    Every query waits for the whole answer, at most CATALOG_ANSWER_TIMEOUT milliseconds: a daemon which does
+    not answer in time is disconnected, so the caller builds the catalog itself. The records are returned as NULL terminated field vectors
+    (see CATALOG_RECORD_FIELD) with the escapes removed, an empty field is an empty string.
+*/
+class CCatalogClient
+{
+  private:
+    gint m_nFd;          /*!< The connected socket, -1 if not connected. */
+    GString *m_Buffer;   /*!< The received bytes not read as a line yet. */
+    gint64 m_nDeadline;  /*!< The monotonic time the answer being read must be complete by. */
+
+    gboolean m_SendRequest(const gchar *request, const gchar *argument);
+    gchar* m_ReadLine(gint *fd);
+    gboolean m_ReadRecords(GPtrArray *records, gint *fd);
+
+  public:
+    CCatalogClient();
+    ~CCatalogClient();
+
+    static gchar* m_GetSocketName(void);
+
+    gboolean m_Connect(void);
+    void m_Disconnect(void);
+    gboolean m_IsConnected(void) { return (m_nFd >= 0); }  /*!< To check if the daemon is connected. */
+
+    gboolean m_List(GPtrArray *records);
+    gboolean m_Search(const gchar *text, GPtrArray *records);
+    gboolean m_Resolve(const gchar *name, gchar **icon_file, gchar **show_file);
+    GHashTable* m_MapIcons(gint *size);
+};
+#endif /* __CCATALOGCLIENT_H */
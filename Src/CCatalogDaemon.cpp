@@ -0,0 +1,706 @@
+/*! \file CCatalogDaemon.cpp
+    \brief Daemon keeping the applications catalog and its icons loaded for every chooser of the desktop session.
+
+    \date 2026-10-17
+    \version 1.0
+
+    \b Change_History:
+    \n (1) 2026-10-17 initial version.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <glib-unix.h>
+
+#include "CCatalogDaemon.h"
+#include "CCatalogClient.h"
+
+//------------------------ Callback Functions
+/*! \fn static gboolean cb_accept(GIOChannel *channel, GIOCondition condition, gpointer data)
+    \brief The callback function accepting a client on the listening socket.
+
+    \param[in] channel.
+    \param[in] condition.
+    \param[in] data. The instance of class CCatalogDaemon.
+    \return TRUE to keep listening.
+*/
+static gboolean cb_accept(GIOChannel *channel, GIOCondition condition, gpointer data)
+{
+  channel = channel;
+  condition = condition;
+
+  return ((CCatalogDaemon*)data)->m_Accept();
+}
+
+/*! \fn static gboolean cb_receive(GIOChannel *channel, GIOCondition condition, gpointer data)
+    \brief The callback function reading the requests of a client.
+
+    \param[in] channel.
+    \param[in] condition.
+    \param[in] data. The CATALOG_CONNECTION object.
+    \return TRUE to keep the connection, FALSE once it is closed.
+*/
+static gboolean cb_receive(GIOChannel *channel, GIOCondition condition, gpointer data)
+{
+  CATALOG_CONNECTION *connection = (CATALOG_CONNECTION*)data;
+
+  channel = channel;
+  condition = condition;
+
+  return connection->daemon->m_Receive(connection);
+}
+
+/*! \fn static gboolean cb_send(GIOChannel *channel, GIOCondition condition, gpointer data)
+    \brief The callback function sending the rest of an answer once the client can take more.
+
+    \param[in] channel.
+    \param[in] condition.
+    \param[in] data. The CATALOG_CONNECTION object.
+    \return TRUE while a part of the answer is left.
+*/
+static gboolean cb_send(GIOChannel *channel, GIOCondition condition, gpointer data)
+{
+  CATALOG_CONNECTION *connection = (CATALOG_CONNECTION*)data;
+
+  channel = channel;
+  condition = condition;
+
+  return connection->daemon->m_Send(connection);
+}
+
+/*! \fn static gboolean cb_quit(gpointer data)
+    \brief The callback function of SIGINT and SIGTERM leaving the main loop, so the socket is removed.
+
+    \param[in] data. Not used.
+    \return TRUE to keep the signal source.
+*/
+static gboolean cb_quit(gpointer data)
+{
+  data = data;
+
+  gtk_main_quit();
+
+  return TRUE;
+}
+
+/*! \fn static guint add_fd_watch(gint fd, GIOCondition condition, GIOFunc func, gpointer data)
+    \brief To call a function of the main loop when a socket can be read(or written) or is closed.
+
+    \param[in] fd.
+    \param[in] condition. G_IO_IN or G_IO_OUT.
+    \param[in] func.
+    \param[in] data.
+    \return The id of the watch.
+*/
+static guint add_fd_watch(gint fd, GIOCondition condition, GIOFunc func, gpointer data)
+{
+  GIOChannel *channel = g_io_channel_unix_new(fd);
+  guint watch = g_io_add_watch(channel, (GIOCondition)(condition | G_IO_HUP | G_IO_ERR), func, data);
+
+  /* The watch holds its own reference. */
+  g_io_channel_unref(channel);
+
+  return watch;
+}
+
+/*! \fn static gint create_segment_fd(guint32 length)
+    \brief To create the anonymous file holding the shared icon segment.
+
+    \param[in] length.
+    \return The file descriptor or -1.
+*/
+static gint create_segment_fd(guint32 length)
+{
+  gint fd = -1;
+
+#ifdef MFD_ALLOW_SEALING
+  fd = memfd_create("DesktopAppChooser-icons", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+#endif
+
+  /* Without memfd an unlinked temporary file does the same, only unsealed. */
+  if(fd < 0)
+  {
+     gchar *name = NULL;
+
+     fd = g_file_open_tmp("DesktopAppChooser-icons-XXXXXX", &name, NULL);
+
+     if(name)
+       unlink(name);
+
+     g_free(name);
+  }
+
+  if( fd >= 0 && ftruncate(fd, length) != 0 )
+  {
+     close(fd);
+     fd = -1;
+  }
+
+  return fd;
+}
+
+//--------------- Class Methos Implementation.
+/*! \fn CCatalogDaemon::CCatalogDaemon()
+    \brief CCatalogDaemon constructor
+*/
+CCatalogDaemon::CCatalogDaemon()
+{
+  m_pCatalog = NULL;
+  m_pszSocketName = NULL;
+  m_nListenFd = -1;
+  m_nListenWatch = 0;
+  m_Connections = NULL;
+  m_nIconsFd = -1;
+  m_nIconsLength = 0;
+  m_nIconsGeneration = 0;
+}
+
+/*! \fn CCatalogDaemon::~CCatalogDaemon()
+    \brief CCatalogDaemon destructor
+*/
+CCatalogDaemon::~CCatalogDaemon()
+{
+  m_Stop();
+}
+
+/*! \fn gboolean CCatalogDaemon::m_Start(void)
+    \brief To load the catalog and listen on the socket. gtk_init() must have been called.
+
+    \param[in] NONE
+    \return TRUE or FALSE. FALSE if another daemon is running or the socket can not be created.
+*/
+gboolean CCatalogDaemon::m_Start(void)
+{
+  if(m_pCatalog)
+    return true;
+
+  /* Every category is complete before the first client is answered, and the menu is parsed,
+     not read from the snapshot, so its monitor keeps the catalog up to date. */
+  m_pCatalog = new CAppCatalog;
+  m_pCatalog->m_SetMenuSnapshot(false);
+  m_pCatalog->m_SetAsyncMenuLoad(false);
+  m_pCatalog->m_SetUsageLog(false);
+  m_pCatalog->m_CreateInitValue();
+
+  if( !m_Listen() )
+  {
+     m_Stop();
+     return false;
+  }
+
+  return true;
+}
+
+/*! \fn void CCatalogDaemon::m_Stop(void)
+    \brief To disconnect every client, remove the socket and release the catalog.
+
+    \param[in] NONE
+    \return NONE
+*/
+void CCatalogDaemon::m_Stop(void)
+{
+  while(m_Connections)
+    m_CloseConnection( (CATALOG_CONNECTION*)m_Connections->data );
+
+  if(m_nListenWatch)
+    g_source_remove(m_nListenWatch);
+
+  m_nListenWatch = 0;
+
+  if(m_nListenFd >= 0)
+    close(m_nListenFd);
+
+  m_nListenFd = -1;
+
+  if(m_pszSocketName)
+    unlink(m_pszSocketName);
+
+  g_free(m_pszSocketName);
+  m_pszSocketName = NULL;
+
+  if(m_nIconsFd >= 0)
+    close(m_nIconsFd);
+
+  m_nIconsFd = -1;
+  m_nIconsLength = 0;
+  m_nIconsGeneration = 0;
+
+  if(m_pCatalog)
+  {
+     m_pCatalog->m_DeinitValue();
+     m_pCatalog->m_ReleaseAppsMenuTree();
+     delete m_pCatalog;
+     m_pCatalog = NULL;
+  }
+}
+
+/*! \fn gint CCatalogDaemon::m_Run(void)
+    \brief To serve the clients until SIGINT or SIGTERM is received.
+
+    \param[in] NONE
+    \return The exit status of the process.
+*/
+gint CCatalogDaemon::m_Run(void)
+{
+  if( !m_Start() )
+    return 1;
+
+  g_unix_signal_add(SIGINT, cb_quit, NULL);
+  g_unix_signal_add(SIGTERM, cb_quit, NULL);
+
+  gtk_main();
+
+  m_Stop();
+
+  return 0;
+}
+
+/*! \fn gboolean CCatalogDaemon::m_Listen(void)
+    \brief To bind the socket of the current user. A socket left by a daemon which did not exit cleanly is replaced.
+
+    \param[in] NONE
+    \return TRUE or FALSE
+*/
+gboolean CCatalogDaemon::m_Listen(void)
+{
+  struct sockaddr_un address;
+  gchar *socket_name = CCatalogClient::m_GetSocketName();
+  gchar *dir = g_path_get_dirname(socket_name);
+  gint nRet = -1;
+
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+
+  if( strlen(socket_name) >= sizeof(address.sun_path) || g_mkdir_with_parents(dir, 0700) != 0 )
+  {
+     g_free(dir);
+     g_free(socket_name);
+     return false;
+  }
+
+  g_free(dir);
+  strcpy(address.sun_path, socket_name);
+
+  m_nListenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+  if(m_nListenFd < 0)
+  {
+     g_free(socket_name);
+     return false;
+  }
+
+  nRet = bind(m_nListenFd, (struct sockaddr*)&address, sizeof(address));
+
+  if(nRet != 0 && errno == EADDRINUSE)
+  {
+     CCatalogClient probe;
+
+     /* Somebody answers: another daemon is running. */
+     if( probe.m_Connect() )
+     {
+        g_free(socket_name);
+        return false;
+     }
+
+     unlink(socket_name);
+     nRet = bind(m_nListenFd, (struct sockaddr*)&address, sizeof(address));
+  }
+
+  if( nRet != 0 || listen(m_nListenFd, SOMAXCONN) != 0 )
+  {
+     g_free(socket_name);
+     return false;
+  }
+
+  m_pszSocketName = socket_name;
+  m_nListenWatch = add_fd_watch(m_nListenFd, G_IO_IN, cb_accept, this);
+
+  return true;
+}
+
+/*! \fn gboolean CCatalogDaemon::m_Accept(void)
+    \brief To accept a client and start reading its requests.
+
+    \param[in] NONE
+    \return TRUE to keep listening.
+*/
+gboolean CCatalogDaemon::m_Accept(void)
+{
+  CATALOG_CONNECTION *connection = NULL;
+  gint fd = accept4(m_nListenFd, NULL, NULL, SOCK_CLOEXEC | SOCK_NONBLOCK);
+
+  if(fd < 0)
+    return true;
+
+  connection = g_slice_new0(CATALOG_CONNECTION);
+  connection->daemon = this;
+  connection->fd = fd;
+  connection->buffer = g_string_new(NULL);
+  connection->output = g_string_new(NULL);
+  connection->attached_fd = -1;
+  connection->watch = add_fd_watch(fd, G_IO_IN, cb_receive, connection);
+
+  m_Connections = g_slist_prepend(m_Connections, connection);
+
+  return true;
+}
+
+/*! \fn void CCatalogDaemon::m_CloseConnection(CATALOG_CONNECTION *connection)
+    \brief To disconnect a client.
+
+    \param[in] connection.
+*/
+void CCatalogDaemon::m_CloseConnection(CATALOG_CONNECTION *connection)
+{
+  m_Connections = g_slist_remove(m_Connections, connection);
+
+  if(connection->watch)
+    g_source_remove(connection->watch);
+
+  if(connection->send_watch)
+    g_source_remove(connection->send_watch);
+
+  if(connection->attached_fd >= 0)
+    close(connection->attached_fd);
+
+  close(connection->fd);
+  g_string_free(connection->buffer, TRUE);
+  g_string_free(connection->output, TRUE);
+  g_slice_free(CATALOG_CONNECTION, connection);
+}
+
+/*! \fn gboolean CCatalogDaemon::m_Receive(CATALOG_CONNECTION *connection)
+    \brief To read from a client and answer its complete request lines.
+
+    \param[in] connection.
+    \return TRUE to keep reading, FALSE if the connection is closed.
+*/
+gboolean CCatalogDaemon::m_Receive(CATALOG_CONNECTION *connection)
+{
+  gchar data[CATALOG_MAX_REQUEST];
+  ssize_t n = recv(connection->fd, data, sizeof(data), 0);
+
+  if(n < 0 && (errno == EINTR || errno == EAGAIN))
+    return true;
+
+  if(n <= 0)
+  {
+     /* The main loop removes the watch, as this returns FALSE. */
+     connection->watch = 0;
+     m_CloseConnection(connection);
+     return false;
+  }
+
+  g_string_append_len(connection->buffer, data, n);
+
+  if( !m_HandleRequests(connection) )
+  {
+     connection->watch = 0;
+     m_CloseConnection(connection);
+     return false;
+  }
+
+  return true;
+}
+
+/*! \fn gboolean CCatalogDaemon::m_Send(CATALOG_CONNECTION *connection)
+    \brief To send more of an answer, then answer the requests received meanwhile.
+
+    \param[in] connection.
+    \return TRUE while a part of the answer is left, FALSE once it is sent or the connection is closed.
+*/
+gboolean CCatalogDaemon::m_Send(CATALOG_CONNECTION *connection)
+{
+  if( !m_SendAnswer(connection) )
+  {
+     /* The main loop removes the watch, as this returns FALSE. */
+     connection->send_watch = 0;
+     m_CloseConnection(connection);
+     return false;
+  }
+
+  if(connection->output->len)
+    return true;
+
+  connection->send_watch = 0;
+
+  if( !m_HandleRequests(connection) )
+    m_CloseConnection(connection);
+
+  return false;
+}
+
+/*! \fn gboolean CCatalogDaemon::m_HandleRequests(CATALOG_CONNECTION *connection)
+    \brief To answer the complete request lines received, one at a time: a request waits until the answer
+           of the previous one is sent. A client sends a request once it read the last answer.
+
+    \param[in] connection.
+    \return TRUE or FALSE. FALSE if an answer could not be sent or the pending requests are too long.
+*/
+gboolean CCatalogDaemon::m_HandleRequests(CATALOG_CONNECTION *connection)
+{
+  gchar *newline = NULL;
+
+  while( !connection->output->len && (newline = (gchar*)memchr(connection->buffer->str, '\n', connection->buffer->len)) )
+  {
+     gchar *line = g_strndup(connection->buffer->str, newline - connection->buffer->str);
+     gboolean bRet = false;
+
+     g_string_erase(connection->buffer, 0, newline - connection->buffer->str + 1);
+     bRet = m_HandleRequest(connection, line);
+     g_free(line);
+
+     if(!bRet)
+       return false;
+  }
+
+  return (connection->buffer->len <= CATALOG_MAX_REQUEST);
+}
+
+/*! \fn gboolean CCatalogDaemon::m_HandleRequest(CATALOG_CONNECTION *connection, const gchar *line)
+    \brief To answer a request line. An unknown request gets an empty answer.
+
+    \param[in] connection.
+    \param[in] line. The request without the newline.
+    \return TRUE or FALSE. FALSE if the answer could not be sent.
+*/
+gboolean CCatalogDaemon::m_HandleRequest(CATALOG_CONNECTION *connection, const gchar *line)
+{
+  GString *answer = connection->output;
+  const gchar *argument = strchr(line, '\t');
+  gchar *request = argument ? g_strndup(line, argument - line) : g_strdup(line);
+
+  if(argument)
+    argument++;
+
+  if( strcmp(request, CATALOG_REQUEST_LIST) == 0 )
+    m_pCatalog->m_WriteCatalogRecords(answer, NULL);
+  else if( strcmp(request, CATALOG_REQUEST_SEARCH) == 0 && argument && *argument )
+    m_pCatalog->m_WriteCatalogRecords(answer, argument);
+  else if( strcmp(request, CATALOG_REQUEST_RESOLVE) == 0 && argument && *argument )
+    m_pCatalog->m_WriteIconFilesRecord(answer, argument);
+  else if( strcmp(request, CATALOG_REQUEST_ICONS) == 0 && m_UpdateIconSegment() )
+  {
+     g_string_append_printf(answer, "%s\t%u\n", CATALOG_RECORD_ICONS, m_nIconsLength);
+
+     /* The segment may be replaced before the client takes the whole answer. */
+     connection->attached_fd = fcntl(m_nIconsFd, F_DUPFD_CLOEXEC, 0);
+  }
+
+  g_string_append(answer, CATALOG_RECORD_END "\n");
+  g_free(request);
+
+  return m_SendAnswer(connection);
+}
+
+/*! \fn gboolean CCatalogDaemon::m_SendAnswer(CATALOG_CONNECTION *connection)
+    \brief To send as much of the answer as the client takes without blocking, with the attached file descriptor
+           on its first byte. The rest is sent by a watch once the client reads.
+
+    \param[in] connection.
+    \return TRUE or FALSE. FALSE if the client is gone.
+*/
+gboolean CCatalogDaemon::m_SendAnswer(CATALOG_CONNECTION *connection)
+{
+  GString *answer = connection->output;
+
+  while(connection->nSent < answer->len)
+  {
+     ssize_t n = 0;
+
+     if(connection->attached_fd >= 0)
+     {
+        gchar control[CMSG_SPACE(sizeof(int))];
+        struct iovec iov = { answer->str, answer->len };
+        struct msghdr message;
+        struct cmsghdr *cmsg = NULL;
+
+        memset(&message, 0, sizeof(message));
+        memset(control, 0, sizeof(control));
+        message.msg_iov = &iov;
+        message.msg_iovlen = 1;
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+
+        cmsg = CMSG_FIRSTHDR(&message);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+        memcpy(CMSG_DATA(cmsg), &connection->attached_fd, sizeof(int));
+
+        n = sendmsg(connection->fd, &message, MSG_NOSIGNAL | MSG_DONTWAIT);
+
+        if(n > 0)
+        {
+           close(connection->attached_fd);
+           connection->attached_fd = -1;
+        }
+     }
+     else
+       n = send(connection->fd, answer->str + connection->nSent, answer->len - connection->nSent, MSG_NOSIGNAL | MSG_DONTWAIT);
+
+     if(n < 0 && errno == EINTR)
+       continue;
+
+     /* A slow client does not hold up the others: its answer goes on when it can take more. */
+     if( n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) )
+     {
+        if(!connection->send_watch)
+          connection->send_watch = add_fd_watch(connection->fd, G_IO_OUT, cb_send, connection);
+
+        return true;
+     }
+
+     if(n <= 0)
+       return false;
+
+     connection->nSent += n;
+  }
+
+  g_string_truncate(answer, 0);
+  connection->nSent = 0;
+
+  return true;
+}
+
+/*! \fn gboolean CCatalogDaemon::m_UpdateIconSegment(void)
+    \brief To copy the decoded icons of the catalog into a new sealed segment if its interned icons changed since the last one.
+
+    The clients which mapped an older segment keep it until they unmap it.
+
+    \param[in] NONE
+    \return TRUE if there is a segment to send.
+*/
+gboolean CCatalogDaemon::m_UpdateIconSegment(void)
+{
+  GHashTable *icons = g_hash_table_new(g_str_hash, g_str_equal);
+  GHashTableIter hashIter;
+  gpointer key = NULL, value = NULL;
+  CATALOG_ICONS_HEADER header;
+  CATALOG_ICON *table = NULL;
+  gchar *contents = NULL;
+  guint32 nString = 0, nData = 0;
+  guint n = 0;
+  guint generation = m_pCatalog->m_GetIconGeneration();
+  gint fd = -1, size = 0;
+
+  if( m_nIconsFd >= 0 && generation == m_nIconsGeneration )
+  {
+     g_hash_table_destroy(icons);
+     return true;
+  }
+
+  size = m_pCatalog->m_CollectInternedIcons(icons);
+
+  /* The layout: header, icon table, string table, then the aligned pixel data of every icon. */
+  memset(&header, 0, sizeof(header));
+  header.magic = CATALOG_ICONS_MAGIC;
+  header.version = CATALOG_ICONS_VERSION;
+  header.icon_size = size;
+  header.icons_offset = sizeof(CATALOG_ICONS_HEADER);
+  header.strings_offset = header.icons_offset + g_hash_table_size(icons) * sizeof(CATALOG_ICON);
+  header.strings_length = 1;
+
+  g_hash_table_iter_init(&hashIter, icons);
+
+  while( g_hash_table_iter_next(&hashIter, &key, &value) )
+  {
+     GdkPixbuf *pixbuf = (GdkPixbuf*)value;
+
+     /* Only the 8 bits RGB(A) layout the clients expect. */
+     if( gdk_pixbuf_get_colorspace(pixbuf) != GDK_COLORSPACE_RGB || gdk_pixbuf_get_bits_per_sample(pixbuf) != 8 ||
+         gdk_pixbuf_get_n_channels(pixbuf) != (gdk_pixbuf_get_has_alpha(pixbuf) ? 4 : 3) )
+     {
+        g_hash_table_iter_remove(&hashIter);
+        continue;
+     }
+
+     header.strings_length += strlen((const gchar*)key) + 1;
+  }
+
+  nData = (header.strings_offset + header.strings_length + CATALOG_ICONS_ALIGNMENT - 1) & ~(CATALOG_ICONS_ALIGNMENT - 1);
+  header.n_icons = g_hash_table_size(icons);
+  header.length = nData;
+
+  g_hash_table_iter_init(&hashIter, icons);
+
+  while( g_hash_table_iter_next(&hashIter, &key, &value) )
+  {
+     GdkPixbuf *pixbuf = (GdkPixbuf*)value;
+     guint32 rowstride = gdk_pixbuf_get_width(pixbuf) * gdk_pixbuf_get_n_channels(pixbuf);
+
+     rowstride = (rowstride + 3) & ~3;
+     header.length += (rowstride * gdk_pixbuf_get_height(pixbuf) + CATALOG_ICONS_ALIGNMENT - 1) & ~(CATALOG_ICONS_ALIGNMENT - 1);
+  }
+
+  fd = create_segment_fd(header.length);
+
+  if(fd >= 0)
+    contents = (gchar*)mmap(NULL, header.length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+  if( fd < 0 || contents == MAP_FAILED )
+  {
+     if(fd >= 0)
+       close(fd);
+
+     g_hash_table_destroy(icons);
+     return (m_nIconsFd >= 0);
+  }
+
+  memcpy(contents, &header, sizeof(header));
+  table = (CATALOG_ICON*)(contents + header.icons_offset);
+  contents[header.strings_offset] = '\0';
+  nString = 1;
+
+  g_hash_table_iter_init(&hashIter, icons);
+
+  while( g_hash_table_iter_next(&hashIter, &key, &value) )
+  {
+     GdkPixbuf *pixbuf = (GdkPixbuf*)value;
+     CATALOG_ICON *icon = &table[n++];
+     const guchar *pixels = gdk_pixbuf_get_pixels(pixbuf);
+     gint nRowBytes = gdk_pixbuf_get_width(pixbuf) * gdk_pixbuf_get_n_channels(pixbuf);
+
+     icon->name = nString;
+     strcpy(contents + header.strings_offset + nString, (const gchar*)key);
+     nString += strlen((const gchar*)key) + 1;
+
+     icon->width = gdk_pixbuf_get_width(pixbuf);
+     icon->height = gdk_pixbuf_get_height(pixbuf);
+     icon->rowstride = (nRowBytes + 3) & ~3;
+     icon->has_alpha = gdk_pixbuf_get_has_alpha(pixbuf) ? 1 : 0;
+     icon->data_offset = nData;
+
+     for(guint32 y = 0; y < icon->height; y++)
+       memcpy(contents + nData + y * icon->rowstride, pixels + y * gdk_pixbuf_get_rowstride(pixbuf), nRowBytes);
+
+     nData += (icon->rowstride * icon->height + CATALOG_ICONS_ALIGNMENT - 1) & ~(CATALOG_ICONS_ALIGNMENT - 1);
+  }
+
+  munmap(contents, header.length);
+
+#ifdef F_SEAL_WRITE
+  /* The clients can trust the segment: nobody can resize or change it anymore. */
+  fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL);
+#endif
+
+  if(m_nIconsFd >= 0)
+    close(m_nIconsFd);
+
+  m_nIconsFd = fd;
+  m_nIconsLength = header.length;
+  m_nIconsGeneration = generation;
+
+  g_hash_table_destroy(icons);
+
+  return true;
+}
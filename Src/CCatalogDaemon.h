@@ -0,0 +1,80 @@
+/*! \file    CCatalogDaemon.h
+    \brief   Daemon keeping the applications catalog and its icons loaded for every chooser of the desktop session.
+
+    \date    2026-10-17
+    \version 1.0
+
+    \b Change_History:
+    \n 1) 2026-10-17 initialized.
+*/
+
+#ifndef __CCATALOGDAEMON_H
+#define __CCATALOGDAEMON_H
+
+#include <glib.h>
+
+#include "CCatalogProtocol.h"
+#include "CAppCatalog.h"
+
+/*! \def CATALOG_MAX_REQUEST
+    \brief The longest request line accepted, a client sending a longer one is disconnected.
+*/
+#define CATALOG_MAX_REQUEST  4096
+
+class CCatalogDaemon;
+
+/*! \struct CATALOG_CONNECTION
+    \brief A connected client of the daemon.
+*/
+typedef struct {
+  CCatalogDaemon *daemon;
+  gint fd;
+  guint watch;         /*!< The main loop watch reading the requests. */
+  GString *buffer;     /*!< The received bytes not handled as a request yet. */
+  GString *output;     /*!< The answer being sent, empty if none. The next request waits until it is sent. */
+  gsize nSent;         /*!< The bytes of "output" sent already. */
+  gint attached_fd;    /*!< The file descriptor sent with the first byte of "output", -1 if none. */
+  guint send_watch;    /*!< The main loop watch sending the rest of "output" once the client reads, 0 if none. */
+} CATALOG_CONNECTION;
+
+/*! \class CCatalogDaemon
+    \brief Answer list, search and resolve queries over a Unix domain socket, see CCatalogProtocol.h.
+
+    The catalog is a CAppCatalog, the class a dialog shows, loaded with every category complete and kept up to date
+    by its menu monitor. The decoded icons are copied once into a sealed memfd segment whose file descriptor
+    is passed to the clients, which map it read-only. Everything runs in the GTK main thread, and no socket
+    operation blocks: an answer a client does not read at once is sent as it reads.
+*/
+class CCatalogDaemon
+{
+  private:
+    CAppCatalog *m_pCatalog;
+    gchar *m_pszSocketName;  /*!< The full name of the bound socket, NULL if not listening. */
+    gint m_nListenFd;
+    guint m_nListenWatch;
+    GSList *m_Connections;   /*!< The CATALOG_CONNECTION objects. */
+
+    /* The shared icon segment. */
+    gint m_nIconsFd;         /*!< -1 until the first "ICONS" request. */
+    guint32 m_nIconsLength;
+    guint m_nIconsGeneration;  /*!< The icon generation of the catalog the segment was built from, see m_GetIconGeneration(). */
+
+    gboolean m_Listen(void);
+    void m_CloseConnection(CATALOG_CONNECTION *connection);
+    gboolean m_HandleRequests(CATALOG_CONNECTION *connection);
+    gboolean m_HandleRequest(CATALOG_CONNECTION *connection, const gchar *line);
+    gboolean m_SendAnswer(CATALOG_CONNECTION *connection);
+    gboolean m_UpdateIconSegment(void);
+
+  public:
+    CCatalogDaemon();
+    ~CCatalogDaemon();
+
+    gboolean m_Start(void);
+    void m_Stop(void);
+    gint m_Run(void);
+    gboolean m_Accept(void);
+    gboolean m_Receive(CATALOG_CONNECTION *connection);
+    gboolean m_Send(CATALOG_CONNECTION *connection);
+};
+#endif /* __CCATALOGDAEMON_H */
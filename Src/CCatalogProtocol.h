@@ -0,0 +1,117 @@
+/*! \file    CCatalogProtocol.h
+    \brief   The requests, records and shared icon segment of the catalog daemon.
+
+    A client sends one request per line over the Unix domain socket, the daemon answers with record lines
+    and a line "." at the end:
+    \n "LIST"           - "C" record of every category followed by the records of its sub-categories and applications.
+    \n "SEARCH\ttext"   - the same records of the found applications and of their categories only.
+    \n "RESOLVE\tname"  - one "R" record with the icon files of an icon name.
+    \n "ICONS"          - one "I" record with the segment length, the segment's file descriptor is attached to it.
+
+    The fields of a record are separated by tabs, a backslash, tab, carriage return or newline inside a field is
+    escaped as "\\\\", "\\t", "\\r" or "\\n". An empty field stands for NULL.
+
+    \date    2026-10-17
+    \version 1.0
+
+    \b Change_History:
+    \n 1) 2026-10-17 initialized.
+*/
+
+#ifndef __CCATALOGPROTOCOL_H
+#define __CCATALOGPROTOCOL_H
+
+#include <glib.h>
+
+/*! \def CATALOG_SOCKET_NAME
+    \brief The socket of the daemon under $XDG_RUNTIME_DIR(or the user cache directory if it is not set).
+*/
+#define CATALOG_SOCKET_NAME  "DesktopAppChooser/catalog-v2"
+
+/* The requests. */
+#define CATALOG_REQUEST_LIST     "LIST"
+#define CATALOG_REQUEST_SEARCH   "SEARCH"
+#define CATALOG_REQUEST_RESOLVE  "RESOLVE"
+#define CATALOG_REQUEST_ICONS    "ICONS"
+
+/*! \enum CATALOG_RECORD_FIELD
+    \brief The fields of the records. Field 0 is the record type.
+*/
+enum CATALOG_RECORD_FIELD
+{
+  CATALOG_FIELD_TYPE = 0,
+
+  /* "C": a directory of the menu, under the last category of the depth above. */
+  CATALOG_CATEGORY_NAME = 1,
+  CATALOG_CATEGORY_ICON,
+  CATALOG_CATEGORY_ICON_FILE,   /*!< The image file of the icon in the icon theme at the rows' size. */
+  CATALOG_CATEGORY_SHOW_FILE,   /*!< The full name of the icon file at the shown size, empty if not resolved yet. */
+  CATALOG_CATEGORY_DEPTH,       /*!< 0 for a top-level directory. */
+  N_CATALOG_CATEGORY_FIELDS,
+
+  /* "E": an application of the last category of its depth. */
+  CATALOG_ENTRY_NAME = 1,
+  CATALOG_ENTRY_ICON,
+  CATALOG_ENTRY_EXEC,
+  CATALOG_ENTRY_COMMENT,
+  CATALOG_ENTRY_DESKTOPFILE,
+  CATALOG_ENTRY_ICON_FILE,      /*!< The files of the icon name the row shows, the default one if "icon" is empty. */
+  CATALOG_ENTRY_SHOW_FILE,
+  CATALOG_ENTRY_DEPTH,          /*!< The depth of its category. */
+  N_CATALOG_ENTRY_FIELDS,
+
+  /* "R": the icon files of a name. */
+  CATALOG_RESOLVE_ICON_FILE = 1,
+  CATALOG_RESOLVE_SHOW_FILE,
+  N_CATALOG_RESOLVE_FIELDS,
+
+  /* "I": the shared icon segment. */
+  CATALOG_ICONS_LENGTH = 1,
+  N_CATALOG_ICONS_FIELDS
+};
+
+#define CATALOG_RECORD_CATEGORY  "C"
+#define CATALOG_RECORD_ENTRY     "E"
+#define CATALOG_RECORD_RESOLVE   "R"
+#define CATALOG_RECORD_ICONS     "I"
+#define CATALOG_RECORD_END       "."
+
+/*! \def CATALOG_ICONS_MAGIC
+    \brief The magic number("DACS") at the beginning of the shared icon segment.
+*/
+#define CATALOG_ICONS_MAGIC    0x53434144
+#define CATALOG_ICONS_VERSION  1
+
+/*! \def CATALOG_ICONS_ALIGNMENT
+    \brief The alignment of every icon's pixel data inside the segment.
+*/
+#define CATALOG_ICONS_ALIGNMENT  16
+
+/*! \struct CATALOG_ICONS_HEADER
+    \brief The header of the shared icon segment: the decoded icons the daemon holds, followed by the
+           icon table, the string table and the pixel data. Names are offsets into the string table.
+*/
+typedef struct {
+  guint32 magic;
+  guint32 version;
+  guint32 length;          /*!< The length of the whole segment. */
+  guint32 icon_size;       /*!< The size the icons were decoded for. */
+  guint32 n_icons;
+  guint32 icons_offset;
+  guint32 strings_offset;
+  guint32 strings_length;
+} CATALOG_ICONS_HEADER;
+
+/*! \struct CATALOG_ICON
+    \brief A decoded icon: 8 bits per sample RGB, or RGBA if it has alpha.
+*/
+typedef struct {
+  guint32 name;            /*!< The icon name the rows ask for. */
+  guint32 width;
+  guint32 height;
+  guint32 rowstride;
+  guint32 has_alpha;
+  guint32 data_offset;     /*!< The offset of the pixel data from the beginning of the segment. */
+} CATALOG_ICON;
+
+#endif /* __CCATALOGPROTOCOL_H */
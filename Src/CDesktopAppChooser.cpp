@@ -12,6 +12,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 #include <glib/gi18n.h>  // For multi-language.
 
 #include "CDesktopAppChooser.h"
@@ -20,44 +21,9 @@
 /* The title of the frame widget. The tile string is enclosed with GNU gettext hint for multi-language. */
 #define WINDOW_TITLE  _("Desktop Application Chooser")
 
-/*! \def DEFAULT_ICON_PATH
-    \brief The path to the default icon used when there has no icon for a chosen application.
-*/
-#define DEFAULT_ICON_PATH "./img/"
-
-/*! \def DEFAULT_ICON
-    \brief The full name of the default icon used when there has no icon for a chosen application.
-*/
-#define DEFAULT_ICON DEFAULT_ICON_PATH"none.png"
-
-/* The X desktop main application menu. */
-#define  APPLICATIONS_MENU       "applications.menu"
-#define  DEFAULT_APP_ICON        "application-x-executable"
-#define  DEFAULT_APP__MIME_ICON  "gnome-mime-application-x-executable"
-
-/*! \def IMG_SIZE
-    \brief The size of the icon shown in the tree-view. The unit is "pixel"
-*/
-#define IMG_SIZE 48
-
-/*! \def IMG_SIZE_SHOW
-    \brief The size of the icon chosen to be shown as the appearance of a menu item.
-    
-    It could be one of the values 16 / 22 / 24 / 32 pixels.
-*/
-#define IMG_SIZE_SHOW 32
-
-
-/*! \enum APPS_MENU_ITEM_IDX 
-    \brief The application items tree-view column.
-*/
-enum APPS_MENU_ITEM_IDX 
-{
-  COLUMN_ICON = 0,
-  COLUMN_TEXT,
-  COLUMN_NODEDATA,
-  NUM_COLS
-};
+/* The process-wide catalog shown by the dialogs with m_SetSharedCatalog(TRUE), and the number of its holders. */
+static CAppCatalog *pSharedCatalog = NULL;
+static guint nSharedCatalogRefs = 0;
 
 //------------------------ Callback Functions
 /*!	\fn static gboolean on_file_apply(GtkButton *button, CDesktopAppChooser *thisObject)
@@ -70,6 +36,7 @@ enum APPS_MENU_ITEM_IDX
 static gboolean on_file_apply(GtkButton *button, CDesktopAppChooser *thisObject)
 {
   GtkWidget *treeview = NULL;
+  gint64 nClickTime = g_get_monotonic_time();
 
   if(!button || !thisObject)
     return false;
@@ -122,48 +89,8 @@ static gboolean on_file_apply(GtkButton *button, CDesktopAppChooser *thisObject)
               if(appInfo->name)
                 storeSelected->name = (gchar*)g_strdup(appInfo->name);
 
-              if(appInfo->icon)
-              {
-                 gchar *dirName = g_path_get_dirname(appInfo->icon);
-
-                 /* To check if it has path name. */
-                 if( !dirName || (*dirName == '.') )
-                 {
-                    GtkIconTheme *theme = gtk_icon_theme_get_default();
-                    GtkIconInfo *info = gtk_icon_theme_lookup_icon( theme, appInfo->icon, IMG_SIZE_SHOW,  GTK_ICON_LOOKUP_USE_BUILTIN );
-
-                    if(G_UNLIKELY(!info))
-					{
-                       /* To search the icon in alternative paths. */
-                       storeSelected->icon = thisObject->m_GetIconFullName(appInfo->icon, IMG_SIZE_SHOW);
-
-                       if(storeSelected->icon == NULL)
-						  storeSelected->icon = (gchar*)g_strdup(DEFAULT_ICON);  /* If it can not find the icon file name specified in the ".desktop" file. */
-                    }
-                    else
-                    {
-                       if(dirName)
-                         g_free(dirName);
-
-                       /* To reset the icon name in full path form. */
-                       g_free(storeSelected->icon);
-                       storeSelected->icon = NULL;
-                       storeSelected->icon = g_strdup( gtk_icon_info_get_filename(info) );
-
-                       if(storeSelected->icon)
-                          ;
-                       else
-                       {
-                          /* To search the icon in alternative paths. */
-                          storeSelected->icon = thisObject->m_GetIconFullName(appInfo->icon, IMG_SIZE_SHOW);
-                       }
-                    }
-                 }
-                 else
-                    storeSelected->icon = (gchar*)g_strdup(appInfo->icon);
-              }
-              else
-                 storeSelected->icon = (gchar*)g_strdup(DEFAULT_ICON);  /* If the icon field in the ".desktop" is empty, set the default icon full name. */
+              /* The icon file at IMG_SIZE_SHOW is looked up now, only for the chosen application. */
+              storeSelected->icon = (gchar*)g_strdup( thisObject->m_GetCatalog()->m_GetIconShowFile(appInfo->icon) );
 
               if(appInfo->exec)
                 storeSelected->exec = (gchar*)g_strdup(appInfo->exec);
@@ -174,8 +101,14 @@ static gboolean on_file_apply(GtkButton *button, CDesktopAppChooser *thisObject)
               if (appInfo->desktopfile)
                 storeSelected->desktopfile = (gchar*)g_strdup(appInfo->desktopfile);
 
+              /* The command is launched after the arena is cleared by m_DeinitValue(). */
+              thisObject->m_SetSelectedExecTemplate(appInfo, nClickTime);
+
               /* To set the flag to be true for that there has one application item has been chosen. */
               thisObject->m_SetIsChosen(true);
+
+              /* The next dialog shows it among the frequently used applications. */
+              thisObject->m_RecordUsage(appInfo);
            } // end of "if"									
         } // end of "if"
 		else
@@ -213,55 +146,124 @@ static gboolean on_close(GtkButton *button, CDesktopAppChooser *thisObject)
   return true;
 }
 
-/*! \fn static gboolean cb_remove_node_data(GtkTreeModel *model, GtkTreePath *path, GtkTreeIter *iter, gpointer data)
-    \brief The callback function for removing all node-data items from the tree tree-view
+/*! \fn static gboolean cb_test_expand_row(GtkTreeView *treeview, GtkTreeIter *iter, GtkTreePath *path, CDesktopAppChooser *thisObject)
+    \brief The callback function creating a category's children when it is expanded the first time in lazy mode.
 
-    \param[in] model. The tree model for GtkTreeView.
-    \param[in] path. The logical position of a row in the model. 
-    \param[in] iter. The iterator of the model.
-    \param[in] data. The application specific data.
-    \return TRUE or FALSE
+    \param[in] treeview. The tree view object.
+    \param[in] iter. The row to be expanded.
+    \param[in] path. The path of the row.
+    \param[in] thisObject. The instance of class CDesktopAppChooser.
+    \return FALSE to allow the row to be expanded, TRUE to keep it collapsed.
 */
-static gboolean cb_remove_node_data(GtkTreeModel *model, GtkTreePath *path,
-                                    GtkTreeIter *iter, gpointer data)
+static gboolean cb_test_expand_row(GtkTreeView *treeview, GtkTreeIter *iter, GtkTreePath *path, CDesktopAppChooser *thisObject)
 {
-  gpointer value;
+  GtkTreeIter storeIter;
+
   path = path;
-  data = data;
 
-  gtk_tree_model_get(model, iter, COLUMN_NODEDATA, &value, -1);
+  /* The tree view shows the filter model, the category is a row of the tree store. */
+  gtk_tree_model_filter_convert_iter_to_child_iter( GTK_TREE_MODEL_FILTER(gtk_tree_view_get_model(treeview)), &storeIter, iter );
 
-  if(value)
-  {
-     APP_ITEM_INFO *appInfo = (APP_ITEM_INFO*)value;
+  /* A shared catalog creates the rows in its own tree store. */
+  return !thisObject->m_GetCatalog()->m_PopulateCategory(&storeIter);
+}
 
-     /* Clear out old data. */
-     if(appInfo->name)
-       g_free(appInfo->name);
+/*! \fn static void cb_collect_expanded_row(GtkTreeView *treeview, GtkTreePath *path, gpointer data)
+    \brief The callback function of gtk_tree_view_map_expanded_rows() collecting the expanded rows.
 
-     if(appInfo->icon)
-       g_free(appInfo->icon);
+    \param[in] treeview. The tree view object.
+    \param[in] path. The path of an expanded row in the filter model.
+    \param[in] data. The GPtrArray getting a copy of the path.
+*/
+static void cb_collect_expanded_row(GtkTreeView *treeview, GtkTreePath *path, gpointer data)
+{
+  treeview = treeview;
 
-     if(appInfo->exec)
-       g_free(appInfo->exec);
+  g_ptr_array_add( (GPtrArray*)data, gtk_tree_path_copy(path) );
+}
 
-     if(appInfo->comment)
-       g_free(appInfo->comment);
+/*! \fn static gboolean cb_first_expose(GtkWidget *widget, GdkEventExpose *event, CDesktopAppChooser *thisObject)
+    \brief The callback function recording the time until the tree view is drawn the first time.
+
+    \param[in] widget. The tree view.
+    \param[in] event.
+    \param[in] thisObject. The instance of class CDesktopAppChooser.
+    \return FALSE to let the tree view draw itself.
+*/
+static gboolean cb_first_expose(GtkWidget *widget, GdkEventExpose *event, CDesktopAppChooser *thisObject)
+{
+  event = event;
 
-     if(appInfo->desktopfile)
-       g_free(appInfo->desktopfile);
+  g_signal_handlers_disconnect_by_func(widget, (gpointer)cb_first_expose, thisObject);
+  thisObject->m_EndFirstExposeSpan();
 
-     /* To set all members to be NULL. */
-     appInfo->name = NULL;
-     appInfo->icon = NULL;
-     appInfo->exec = NULL;
-     appInfo->comment = NULL;
-     appInfo->desktopfile = NULL;
+  return FALSE;
+}
 
-     g_free(value);
-  } // end of "if"
+/*! \fn static void cb_search_changed(GtkEditable *editable, CDesktopAppChooser *thisObject)
+    \brief The callback function filtering the applications on every change of the search entry.
 
-  return FALSE;  /* do not stop walking the store, call us with next row */
+    \param[in] editable. The search entry.
+    \param[in] thisObject. The instance of class CDesktopAppChooser.
+*/
+static void cb_search_changed(GtkEditable *editable, CDesktopAppChooser *thisObject)
+{
+  thisObject->m_SetSearchText( gtk_entry_get_text(GTK_ENTRY(editable)) );
+}
+
+/*! \fn static gboolean cb_row_visible(GtkTreeModel *model, GtkTreeIter *iter, gpointer data)
+    \brief The visible function of the filter model.
+
+    \param[in] model. The tree store, or the flat list model.
+    \param[in] iter. The row of the model.
+    \param[in] data. The instance of class CDesktopAppChooser.
+    \return TRUE if the row is shown.
+*/
+static gboolean cb_row_visible(GtkTreeModel *model, GtkTreeIter *iter, gpointer data)
+{
+  return ((CDesktopAppChooser*)data)->m_IsRowVisible(model, iter);
+}
+
+/*! \fn static void cb_catalog_changed(APP_CATALOG_EVENT event, gpointer data)
+    \brief The callback function of the catalog telling the dialog about a change of the rows.
+
+    \param[in] event.
+    \param[in] data. The instance of class CDesktopAppChooser.
+*/
+static void cb_catalog_changed(APP_CATALOG_EVENT event, gpointer data)
+{
+  ((CDesktopAppChooser*)data)->m_OnCatalogChanged(event);
+}
+
+/*! \fn static void count_widget(GtkWidget *widget, gpointer data)
+    \brief To count a widget and, recursively, its children, internal ones included.
+
+    \param[in] widget.
+    \param[in,out] data. The guint counter.
+*/
+static void count_widget(GtkWidget *widget, gpointer data)
+{
+  (*(guint*)data)++;
+
+  if( GTK_IS_CONTAINER(widget) )
+    gtk_container_forall(GTK_CONTAINER(widget), count_widget, data);
+}
+
+/*! \fn static void format_bytes(gchar *text, gsize size, gsize bytes)
+    \brief To write a byte count in B, KB or MB.
+
+    \param[out] text.
+    \param[in] size. The size of text.
+    \param[in] bytes.
+*/
+static void format_bytes(gchar *text, gsize size, gsize bytes)
+{
+  if(bytes < 1024)
+    g_snprintf(text, size, "%lu B", (gulong)bytes);
+  else if(bytes < 1024 * 1024)
+    g_snprintf(text, size, "%.1f KB", bytes / 1024.0);
+  else
+    g_snprintf(text, size, "%.1f MB", bytes / (1024.0 * 1024.0));
 }
 
 //--------------- Class Methos Implementation.
@@ -271,12 +273,21 @@ static gboolean cb_remove_node_data(GtkTreeModel *model, GtkTreePath *path,
 CDesktopAppChooser::CDesktopAppChooser()
 {
   m_pwParent = NULL;
-  m_MenuTree = NULL;
-  m_RootDir = NULL;
   m_TreeViewTree = NULL;
   m_TreeSelection = NULL;
-  m_TreeStore = NULL;
   m_bIsChosen = false;
+  m_pCatalog = &m_Catalog;
+  m_TreeFilter = NULL;
+  m_SearchMatches = g_hash_table_new(g_direct_hash, g_direct_equal);
+  m_pszSearchText = NULL;
+  m_bSearching = false;
+  m_ExpandedRows = NULL;
+  m_nFirstExposeStart = 0;
+  m_bSharedCatalog = false;
+  m_pSelectedExecTemplate = NULL;
+  m_nChosenTime = 0;
+  m_nLaunchLatency = 0;
+  m_nLaunchSpawnTime = 0;
 
   memset(&m_SelectedAppItemInfo, 0, sizeof(APP_ITEM_INFO));
 
@@ -289,6 +300,13 @@ CDesktopAppChooser::CDesktopAppChooser()
 */
 CDesktopAppChooser::~CDesktopAppChooser()
 {
+  m_DetachSharedCatalog();
+
+  g_hash_table_destroy(m_SearchMatches);
+  g_free(m_pSelectedExecTemplate);
+  g_free(m_pszSearchText);
+  m_FreeExpandedRows();
+
   m_pwParent = NULL;
   m_bIsChosen = false;
 }
@@ -315,13 +333,13 @@ void CDesktopAppChooser::m_GetWindowSize(int &nWidth, int &nHeight)
 */
 void CDesktopAppChooser::m_CreateInitValue(void)
 {
-  /* To create the tree-store model. There has tree fields: 
-         { Pixel-Buffer, Text, GPointer }.
-  */
-  m_TreeStore = gtk_tree_store_new(NUM_COLS, GDK_TYPE_PIXBUF, G_TYPE_STRING, G_TYPE_POINTER);
+  /* The rows, the icons and the menu of the shared catalog are kept across dialogs, nothing is loaded here. */
+  if(m_bSharedCatalog)
+    m_AttachSharedCatalog();
+  else
+    m_Catalog.m_CreateInitValue();
 
-  /* To fill tree store(model) by reading Desktop Menu(.menu) file. */
-  m_LoadAndBuildAppsMenuTree();
+  m_pCatalog->m_AttachView(cb_catalog_changed, this);
 }
 
 /*! \fn gboolean CDesktopAppChooser::m_InitLayoutUI(GtkWidget *pwGtkParent, int nPosX, int nPosY)
@@ -338,7 +356,10 @@ gboolean CDesktopAppChooser::m_InitLayoutUI(GtkWidget *pwGtkParent, int nPosX, i
   GtkWidget	*buttonApply = NULL, *buttonClose = NULL;
   GtkWidget *pFixedContainer = NULL;
   GtkWidget	*treeView = NULL;
+  GtkWidget *searchEntry = NULL;
+  GtkWidget *busyBox = NULL, *busySpinner = NULL;
   gboolean bRet = TRUE;
+  gint64 spanStart = m_Catalog.m_GetProfiler()->m_Begin();
 
   /* To store the top-level GTK dialog window. */
   if(pwGtkParent != NULL)
@@ -385,6 +406,19 @@ gboolean CDesktopAppChooser::m_InitLayoutUI(GtkWidget *pwGtkParent, int nPosX, i
   /* Add the main fixed window into the main window */
   gtk_container_add(GTK_CONTAINER (window), pFixedContainer);	
 
+//-------------- Create the search entry above the tree view.
+  searchEntry = gtk_entry_new();
+
+  /* Set the location and the size of the entry in the fixed container. */
+  gtk_fixed_put(GTK_FIXED(pFixedContainer), searchEntry, 10, 10);
+  gtk_widget_set_size_request(searchEntry, 310, 25);
+
+  /* The applications are filtered on every keystroke. */
+  g_signal_connect(G_OBJECT(searchEntry), "changed", G_CALLBACK(cb_search_changed), this);
+
+  /* Store the required widgets. */
+  m_pWidgets[APPCHOOSER_GtkEntry_Search] = searchEntry;
+
 //-------------- Create a scrolled window widget instance.
   /* Create a scroll window object. */
   scrollWin = gtk_scrolled_window_new(NULL, NULL);
@@ -409,10 +443,10 @@ gboolean CDesktopAppChooser::m_InitLayoutUI(GtkWidget *pwGtkParent, int nPosX, i
   gtk_container_add(GTK_CONTAINER(scrollWin), treeView);
 
   /* Set the scrolling window's size. */
-  gtk_widget_set_size_request(scrollWin, 310, 340);
+  gtk_widget_set_size_request(scrollWin, 310, 315);
 
-  /* Put scrolling window to the fixed windows. */
-  gtk_fixed_put(GTK_FIXED(pFixedContainer), scrollWin, 10, 10);
+  /* Put scrolling window to the fixed windows, below the search entry. */
+  gtk_fixed_put(GTK_FIXED(pFixedContainer), scrollWin, 10, 40);
 	
   /* Store the required widgets. */
   m_pWidgets[APPCHOOSER_GtkTreeView] = treeView;	
@@ -450,6 +484,27 @@ gboolean CDesktopAppChooser::m_InitLayoutUI(GtkWidget *pwGtkParent, int nPosX, i
      The destroy signal could come from here, or the window manager. */
   g_signal_connect(GTK_OBJECT(buttonClose), "clicked", G_CALLBACK(on_close), this);
 
+//-------------- Create the busy indicator shown while the menu is loaded.
+  busyBox = gtk_hbox_new(FALSE, 5);
+  busySpinner = gtk_spinner_new();
+  gtk_box_pack_start(GTK_BOX(busyBox), busySpinner, FALSE, FALSE, 0);
+  gtk_box_pack_start(GTK_BOX(busyBox), gtk_label_new(_("Loading...")), FALSE, FALSE, 0);
+  gtk_spinner_start(GTK_SPINNER(busySpinner));
+
+  /* Set the location in the fixed container, left of the buttons. */
+  gtk_fixed_put(GTK_FIXED(pFixedContainer), busyBox, 10, 372);
+
+  /* It is shown by m_ShowBusy() only, not by showing the window. */
+  gtk_widget_set_no_show_all(busyBox, TRUE);
+
+  /* Store the required widgets. */
+  m_pWidgets[APPCHOOSER_GtkBox_Busy] = busyBox;
+
+  if( m_IsMenuLoading() )
+    m_ShowBusy(true);
+
+  m_Catalog.m_GetProfiler()->m_End("m_InitLayoutUI", spanStart);
+
   return bRet;	
 }
 
@@ -463,30 +518,21 @@ void CDesktopAppChooser::m_DeinitValue(void)
 {
   if(m_pWidgets[APPCHOOSER_GtkTreeView])
   {
-     GtkTreeModel *model =NULL;
-     GtkTreeIter iter;
-
-     m_TreeStore = GTK_TREE_STORE( gtk_tree_view_get_model(GTK_TREE_VIEW(m_pWidgets[APPCHOOSER_GtkTreeView])) );
-
-     /* Make sure the model stays with us after the tree view unrefs it */
-     g_object_ref( (GObject*)m_TreeStore );
-
-     /* Detach model from view */
+     /* Detach model from view, the filter model is released with it. */
      gtk_tree_view_set_model(GTK_TREE_VIEW(m_pWidgets[APPCHOOSER_GtkTreeView]), NULL);
-     model = (GtkTreeModel*)m_TreeStore;
-
-     /* Initializes iter with the first iterator in the tree
-        (the top-level item, e.g. the one at the path "0") */
-     if(gtk_tree_model_get_iter_first(model, &iter) == FALSE) 
-       return;
+     m_TreeFilter = NULL;
+  }
 
-     /* To remove the node's data first. */
-     gtk_tree_model_foreach(model, (GtkTreeModelForeachFunc)cb_remove_node_data, NULL);
+  g_hash_table_remove_all(m_SearchMatches);
+  m_bSearching = false;
 
-     /* Then, to clear all tree model data. */
-     gtk_tree_store_clear(m_TreeStore);
-     g_object_unref(m_TreeStore); 
-     m_TreeStore = NULL;
+  /* The shared catalog keeps its rows for the next dialog. */
+  if(m_pCatalog != &m_Catalog)
+    m_DetachSharedCatalog();
+  else
+  {
+     m_Catalog.m_DetachView(this);
+     m_Catalog.m_DeinitValue();
   }
 }
 
@@ -497,6 +543,14 @@ void CDesktopAppChooser::m_DeinitValue(void)
 */
 gboolean CDesktopAppChooser::m_DoModal(void)
 {
+  gint64 spanStart = m_Catalog.m_GetProfiler()->m_Begin();
+
+  m_nFirstExposeStart = spanStart;
+
+  /* The first drawing of the tree view ends the startup. */
+  if( m_Catalog.m_GetProfiler()->m_IsEnabled() )
+    g_signal_connect(G_OBJECT(m_pWidgets[APPCHOOSER_GtkTreeView]), "expose-event", G_CALLBACK(cb_first_expose), this);
+
   /* Sets a window modal or non-modal. */
   gtk_window_set_modal(GTK_WINDOW(m_pWidgets[APPCHOOSER_GtkWindow_Main]), TRUE);
 
@@ -517,29 +571,46 @@ gboolean CDesktopAppChooser::m_DoModal(void)
   /* Show all widgets */
   gtk_widget_show_all(m_pWidgets[APPCHOOSER_GtkWindow_Main]);
 
+  m_Catalog.m_GetProfiler()->m_End("m_DoModal realize and show", spanStart);
+
   /* Start to run. */
   gtk_main();
 
-//-------------- When the modal is terminated, it must grab the current list store of the tree-view, else it will make a big big trouble!	
-  /* To decrease the reference counter of the menu directory object. */
-  gmenu_tree_item_unref(m_RootDir);
+  m_Catalog.m_GetProfiler()->m_Report();
 
-  /* To decrease the reference counter of the menu tree object. */
-  gmenu_tree_unref(m_MenuTree);
+//-------------- When the modal is terminated, it must grab the current list store of the tree-view, else it will make a big big trouble!	
+  m_ReleaseAppsMenuTree();
 
   return TRUE;
 }
 
+/*! \fn void CDesktopAppChooser::m_ReleaseAppsMenuTree(void)
+    \brief To release the menu objects of the dialog's own catalog, see CAppCatalog::m_ReleaseAppsMenuTree().
+
+    \param[in] NONE
+    \return NONE
+*/
+void CDesktopAppChooser::m_ReleaseAppsMenuTree(void)
+{
+  m_Catalog.m_ReleaseAppsMenuTree();
+}
+
 //-------------------------- GtkTreeView
 /*! \fn GtkTreeModel* CDesktopAppChooser::m_CreateAndFillModel(void)
     \brief Create and fill tree model contents.
 
+    The tree view shows a filter model over the tree store(or the flat list model), so the search only hides rows.
+    The tree store stays owned by the catalog.
+
     \param[in] NONE
-    \return TRUE or FALSE
+    \return The filter model. The caller owns the reference.
 */
 GtkTreeModel* CDesktopAppChooser::m_CreateAndFillModel(void)
 {
-   return GTK_TREE_MODEL(m_TreeStore);
+   m_TreeFilter = gtk_tree_model_filter_new( m_pCatalog->m_GetModel(), NULL );
+   gtk_tree_model_filter_set_visible_func(GTK_TREE_MODEL_FILTER(m_TreeFilter), cb_row_visible, this, NULL);
+
+   return m_TreeFilter;
 }
 
 /*! \fn GtkWidget* CDesktopAppChooser::m_CreateTreeView(void)
@@ -573,6 +644,18 @@ GtkWidget* CDesktopAppChooser::m_CreateTreeView(void)
   gtk_tree_view_column_pack_start(col, rendererText, TRUE);
   gtk_tree_view_column_add_attribute(col, rendererText, "text", COLUMN_TEXT);
 
+  /* In lazy mode, a category's applications are created when the category is expanded. */
+  g_signal_connect(G_OBJECT(view), "test-expand-row", G_CALLBACK(cb_test_expand_row), this);
+
+  /* With fixed row heights the tree view asks only the rows on screen for their values,
+     so the flat list model loads only their icons. */
+  if(m_pCatalog->m_GetOptions()->flat_list)
+  {
+     gtk_tree_view_column_set_sizing(col, GTK_TREE_VIEW_COLUMN_FIXED);
+     gtk_tree_view_column_set_fixed_width(col, 290);
+     gtk_tree_view_set_fixed_height_mode(GTK_TREE_VIEW(view), TRUE);
+  }
+
   /* To create the tree model. */
   model = m_CreateAndFillModel();
   gtk_tree_view_set_model(GTK_TREE_VIEW(view), model);
@@ -581,593 +664,590 @@ GtkWidget* CDesktopAppChooser::m_CreateTreeView(void)
   return view;
 }
 
-//----------------------------------- GMenus Reading Applications ".menu" file
-/*========== All things about applications menu starting from here! ==========*/
-/*! \fn gboolean CDesktopAppChooser::m_LoadAndBuildAppsMenuTree(void)
-    \brief To load the main application menu(.menu) file. 
+/*! \fn void CDesktopAppChooser::m_SetViewModel(void)
+    \brief To show the current tree store of the catalog in the tree view, e.g. after it was built again.
 
     \param[in] NONE
-    \return TRUE or FALSE
+    \return NONE
 */
-gboolean CDesktopAppChooser::m_LoadAndBuildAppsMenuTree(void)
+void CDesktopAppChooser::m_SetViewModel(void)
 {
-  GSList *directoryList = NULL;
+  GtkWidget *view = m_pWidgets[APPCHOOSER_GtkTreeView];
+  GtkTreeModel *model = NULL;
 
-  /*------------ THE ENTRY POINT !!! -------------*/
-  /* To open the applications .menu file. */
-  m_MenuTree = gmenu_tree_lookup( APPLICATIONS_MENU, GMENU_TREE_FLAGS_NONE );
+  /* A dialog without its tree view yet creates the filter model over the new store later. */
+  if(!view)
+    return;
 
-  /* To store the parsed direcotry contents. */
-  m_RootDir = gmenu_tree_get_root_directory( m_MenuTree );
+  /* The expanded categories were rows of the replaced store. */
+  m_FreeExpandedRows();
 
-  /* To build the top-level tree node. */
-  for(directoryList = gmenu_tree_directory_get_contents( m_RootDir ); 
-      directoryList; 
-      directoryList = directoryList->next )
-  {
-     GMenuTreeDirectory *tmpDir = (GMenuTreeDirectory*)directoryList->data;
+  model = m_CreateAndFillModel();
+  gtk_tree_view_set_model(GTK_TREE_VIEW(view), model);
+  g_object_unref(model);
+}
 
-     /* To check its type. */
-     if( G_UNLIKELY(gmenu_tree_item_get_type((GMenuTreeItem*)tmpDir) != GMENU_TREE_ITEM_DIRECTORY) )
-       continue;
+/*! \fn void CDesktopAppChooser::m_ShowBusy(gboolean busy)
+    \brief To show or hide the busy indicator below the tree view.
 
-     /* To build top-level(Directory) nodes. */          
-     m_AddAppsMenuTopLevelNode(tmpDir);
+    \param[in] busy.
+*/
+void CDesktopAppChooser::m_ShowBusy(gboolean busy)
+{
+  GtkWidget *busyBox = m_pWidgets[APPCHOOSER_GtkBox_Busy];
 
-     /* To build child nodes(applications). */
-     m_AddAppsMenuLeafNode(tmpDir);		
-  }
+  if(!busyBox)
+    return;
 
-  return true;
+  if(busy)
+    gtk_widget_show_all(busyBox);
+  else
+    gtk_widget_hide(busyBox);
 }
 
-/*! \fn gboolean CDesktopAppChooser::m_AddAppsMenuTopLevelNode(GMenuTreeDirectory *appsDir)
-    \brief To create top-level(Directory) nodes.
+//----------------------------------- Shared Catalog
+/*! \fn void CDesktopAppChooser::m_RefSharedCatalog(void)
+    \brief To keep the shared catalog while no dialog shows it, e.g. for the whole session of the host application.
 
-    \param[in] appsDir.
-    \return TRUE or FALSE
+    The catalog itself is built by the first dialog attaching to it. Every call needs one m_UnrefSharedCatalog().
+
+    \param[in] NONE
+    \return NONE
 */
-gboolean CDesktopAppChooser::m_AddAppsMenuTopLevelNode(GMenuTreeDirectory *appsDir)
+void CDesktopAppChooser::m_RefSharedCatalog(void)
 {
-  GdkPixbuf *pixbuf = NULL;
+  nSharedCatalogRefs++;
+}
 
-  /* To get PixelBuffer of the Directory icon. */
-  pixbuf = m_LoadIcon(gmenu_tree_directory_get_icon(appsDir), IMG_SIZE, TRUE ); 
+/*! \fn void CDesktopAppChooser::m_UnrefSharedCatalog(void)
+    \brief To drop a reference of the shared catalog. The last one releases its rows, icons and menu.
 
-  /* To set the columns' content. */
-  gtk_tree_store_append(m_TreeStore, &m_TopLevelNodeIter, NULL);
-  gtk_tree_store_set(m_TreeStore, &m_TopLevelNodeIter,
-                     COLUMN_ICON, pixbuf,
-                     COLUMN_TEXT, gmenu_tree_directory_get_name(appsDir),
-                     COLUMN_NODEDATA, NULL,
-                     -1);
+    \param[in] NONE
+    \return NONE
+*/
+void CDesktopAppChooser::m_UnrefSharedCatalog(void)
+{
+  if( G_UNLIKELY(nSharedCatalogRefs == 0) )
+    return;
 
-  /* pixbuf has a referece count of "1" now, as the tree store has added its own reference. 
-     So to decrease the reference count of pixbuf. */
-  g_object_unref(pixbuf);
+  if( --nSharedCatalogRefs > 0 || !pSharedCatalog )
+    return;
 
-  return true;
+  pSharedCatalog->m_DeinitValue();
+  pSharedCatalog->m_ReleaseAppsMenuTree();
+  delete pSharedCatalog;
+  pSharedCatalog = NULL;
 }
 
-/*! \fn gboolean CDesktopAppChooser::m_AddAppsMenuLeafNode(GMenuTreeDirectory *appsDir)
-    \brief To create leaf nodes(applications).
+/*! \fn void CDesktopAppChooser::m_AttachSharedCatalog(void)
+    \brief To show the rows of the shared catalog in this dialog, building the catalog if it does not exist yet.
 
-    \param[in] appsDir
-    \return TRUE or FALSE
+    Its icon pipeline, menu loading and menu monitor keep running between dialogs. It is built with the options
+    of the first dialog, later dialogs follow its flat list, lazy mode and sorting whatever they were set to.
+
+    \param[in] NONE
+    \return NONE
 */
-gboolean CDesktopAppChooser::m_AddAppsMenuLeafNode(GMenuTreeDirectory *appsDir)
+void CDesktopAppChooser::m_AttachSharedCatalog(void)
 {
-  GSList *itemList = NULL;
+  if(m_pCatalog != &m_Catalog)
+    return;
 
-  if( G_UNLIKELY(!appsDir) )
-    return false;
+  m_RefSharedCatalog();
 
-  for( itemList = gmenu_tree_directory_get_contents(appsDir);
-       itemList;
-       itemList = itemList->next )
+  if(!pSharedCatalog)
   {
-     GMenuTreeItem  *item = (GMenuTreeItem*)itemList->data;
-     GMenuTreeItemType type = gmenu_tree_item_get_type(item);
-
-     if( type == GMENU_TREE_ITEM_DIRECTORY )
-     {
-        /* To pars sub-directory items and add it to the menu tree.
-           Here using recursive parse. */
-        m_AddAppsMenuLeafNode( (GMenuTreeDirectory*)item );
-     }
-     else if( type == GMENU_TREE_ITEM_ENTRY )
-     {
-        GdkPixbuf *pixbuf = NULL;
-        const gchar *icon_name = gmenu_tree_entry_get_icon( (GMenuTreeEntry*)item );
-        APP_ITEM_INFO *appInfo = NULL;
-				
-        /* To determine if the current item need not to be shown. If it is, continue. */
-        if(gmenu_tree_entry_get_is_nodisplay( (GMenuTreeEntry*)item ) || 
-           gmenu_tree_entry_get_is_excluded( (GMenuTreeEntry*)item ) )
-          continue;
-					
-        /* To create the icon for the currently read node. */
-        if(icon_name)
-          pixbuf = m_LoadIcon(icon_name, IMG_SIZE, TRUE );
-        else
-          pixbuf = m_LoadIcon(DEFAULT_APP__MIME_ICON, IMG_SIZE, TRUE );  // If there has no icon name in .desktop file, using the system default icon for application.
-
-        /* To create a object containing information about current leaf node. */
-        appInfo = new APP_ITEM_INFO ;
-
-        /* Zero out the new allocated memory. */
-        memset(appInfo, 0x00, sizeof(APP_ITEM_INFO));
-
-        if(appInfo)
-        {
-           gchar *name = (gchar*)gmenu_tree_entry_get_name( (GMenuTreeEntry*)item ) ;
-           gchar *exec = (gchar*)gmenu_tree_entry_get_exec( (GMenuTreeEntry*)item );
-           gchar *comment = (gchar*)gmenu_tree_entry_get_comment( (GMenuTreeEntry*)item );
-
-           #if 1
-           gchar *desktopfile = (gchar*)gmenu_tree_entry_get_desktop_file_path( (GMenuTreeEntry*)item );
-           #else
-           gchar *desktopfile = (gchar*)gmenu_tree_entry_get_desktop_file_id( (GMenuTreeEntry*)item );
-           #endif
-
-           if(name)
-             appInfo->name = (gchar*)g_strdup(name);
-
-           if(icon_name)
-             appInfo->icon = (gchar*)g_strdup(icon_name);
-
-           if(exec)
-             appInfo->exec = (gchar*)g_strdup(exec);
-
-           if(comment)
-             appInfo->comment = (gchar*)g_strdup(comment);
-
-           if(desktopfile)
-             appInfo->desktopfile = (gchar*)g_strdup(desktopfile);
-        }
-
-        /* Add a tree leaf. */
-        gtk_tree_store_append(m_TreeStore, &m_ChildNodeIter, &m_TopLevelNodeIter);
-        gtk_tree_store_set(m_TreeStore, &m_ChildNodeIter,
-                           COLUMN_ICON, pixbuf,
-                           COLUMN_TEXT, gmenu_tree_entry_get_name( (GMenuTreeEntry*)item ),
-                           COLUMN_NODEDATA, appInfo,
-                           -1);					
-				
-        /* pixbuf has a referece count of "1" now, as the tree store has added its own reference. 
-           So to decrease the reference count of pixbuf. */
-        g_object_unref(pixbuf);
-    }
-  } // The end of for() 
+     pSharedCatalog = new CAppCatalog;
+     pSharedCatalog->m_SetOptions( m_Catalog.m_GetOptions() );
+     pSharedCatalog->m_CreateInitValue();
+  }
 
-  return true;
+  m_pCatalog = pSharedCatalog;
 }
 
-/*! \fn GdkPixbuf* CDesktopAppChooser::m_LoadIcon(const gchar* name, gint size, gboolean use_fallback)
-    \brief To load a icon's image contents.
+/*! \fn void CDesktopAppChooser::m_DetachSharedCatalog(void)
+    \brief To stop showing the rows of the shared catalog and drop the reference taken by m_AttachSharedCatalog().
 
-    \param[in] name.
-    \param[in] size. 
-    \param[in] use_fallback.
-    \return PixelBuffer object representing the designated icon.
+    \param[in] NONE
+    \return NONE
 */
-GdkPixbuf* CDesktopAppChooser::m_LoadIcon(const gchar* name, gint size, gboolean use_fallback)
+void CDesktopAppChooser::m_DetachSharedCatalog(void)
 {
-  GtkIconTheme *theme = NULL;
-  gchar *icon_name = NULL, *suffix = NULL;
-  GdkPixbuf *icon = NULL;
+  if(m_pCatalog == &m_Catalog)
+    return;
 
-  if(name)
-  {
-    if( g_path_is_absolute( name) )
-      icon = gdk_pixbuf_new_from_file_at_scale( name, size, size, TRUE, NULL );
-    else
-    {
-      theme = gtk_icon_theme_get_default();
-      suffix = strchr((char*)name, '.' );
-	
-      if(suffix)  /* Having file extension, it is the basename of icon file */
-      {
-        /*Try to find it in "pixmaps", "icons/hicolor" and "icons/hicolor/scalable/apps" directories */
-        icon = m_LoadIconFile( name, size );
+  m_pCatalog->m_DetachView(this);
+  m_pCatalog = &m_Catalog;
 
-        if(G_UNLIKELY(!icon))   /* unfortunately, it is not found */
-        {
-           /* Let's remove the suffix and see if this name can match an icon in current icon theme */
-           icon_name = g_strndup(name, (suffix-name) );
-           icon = m_LoadThemeIcon(theme, icon_name, size );
-           g_free( icon_name );
-        }
-      }
-      else  /* no file extension, it could be an icon name in the icon theme */
-        icon = m_LoadThemeIcon( theme, name, size );
-    }
-  }
-	
-  if(G_UNLIKELY(!icon) && use_fallback)  /* fallback to generic icon */
+  m_UnrefSharedCatalog();
+}
+
+/*! \fn void CDesktopAppChooser::m_OnCatalogChanged(APP_CATALOG_EVENT event)
+    \brief To update the tree view after the rows of the catalog have changed.
+
+    \param[in] event.
+    \return NONE
+*/
+void CDesktopAppChooser::m_OnCatalogChanged(APP_CATALOG_EVENT event)
+{
+  switch(event)
   {
-     theme = gtk_icon_theme_get_default();
-     icon = m_LoadThemeIcon(theme, DEFAULT_APP_ICON, size);
+     case APP_CATALOG_MENU_LOADED:
+        m_ShowBusy(false);
+        break;
 
-     if( G_UNLIKELY(!icon) )  /* fallback to generic icon */
-       icon = m_LoadThemeIcon(theme, DEFAULT_APP__MIME_ICON, size );
+     case APP_CATALOG_MODEL_REPLACED:
+        m_SetViewModel();
+        return;
+
+     default:
+        break;
   }
-	
-  return icon;
+
+  /* The added or changed rows are not in the search result yet. */
+  if(m_bSearching)
+    m_ApplySearch();
 }
 
-/*! \fn GdkPixbuf* CDesktopAppChooser::m_LoadIconFile(const char* file_name, int size)
-    \brief Try to find it in "pixmaps", "icons/hicolor", "icons/hicolor/scalable/apps" directories.
+//----------------------------------- Usage Log
+/*! \fn void CDesktopAppChooser::m_RecordUsage(APP_ITEM_INFO *appInfo)
+    \brief To log the choice of an application. A shared catalog shows it in its "Frequently used" category at once.
 
-    \param[in] file_name. The icon name for searching.
-    \param[in] size. The width(height) of the icon for searching. 
-    \return PixelBuffer object representing the designated icon.
+    \param[in] appInfo. The node-data of the chosen row.
+    \return NONE
 */
-GdkPixbuf* CDesktopAppChooser::m_LoadIconFile(const char* file_name, int size)
+void CDesktopAppChooser::m_RecordUsage(APP_ITEM_INFO *appInfo)
 {
-  GdkPixbuf* icon = NULL;
-  char *file_path = NULL;
-  const gchar **dirs = (const gchar**)g_get_system_data_dirs();   /* To read the environment variable which is specified in freedesktop.org Base Directory. */
-  const gchar **dir = NULL;
-  gchar *sizeName = NULL;
+  if( !appInfo || !m_pCatalog->m_LogUsage(appInfo->desktopfile) )
+    return;
 
-  for( (dir = dirs); *dir; ++dir )
-  {
-     /* Searching in "/usr/share/pixmaps" directory */
-     if(g_strrstr(file_name, ".") &&
-        (g_strrstr(file_name, EXT_NAME_PNG) || g_strrstr(file_name, EXT_NAME_XPM) || g_strrstr(file_name, EXT_NAME_SVG)) )
-     {
-        file_path = g_build_filename( *dir, ICON_SEARCH_PATH_PIXMAPS, file_name, NULL );
-        icon = gdk_pixbuf_new_from_file_at_scale( file_path, size, size, TRUE, NULL );
+  /* The own rows of this dialog are released right after the choice. */
+  if(m_pCatalog != &m_Catalog)
+    m_pCatalog->m_UpdateFrequentCategory();
+}
 
-        if(file_path)		
-          g_free(file_path);
+/*! \fn void CDesktopAppChooser::m_SetSelectedExecTemplate(APP_ITEM_INFO *appInfo, gint64 nClickTime)
+    \brief To keep a copy of the tokenized command of the chosen application, the arena is cleared right after.
 
-        file_path = NULL;		
+    \param[in] appInfo. The node-data of the chosen row.
+    \param[in] nClickTime. The monotonic time of the click, the start of the launch latency.
+    \return NONE
+*/
+void CDesktopAppChooser::m_SetSelectedExecTemplate(APP_ITEM_INFO *appInfo, gint64 nClickTime)
+{
+  const EXEC_TEMPLATE *tmpl = m_pCatalog->m_GetExecTemplate(appInfo);
 
-        if( icon )
-		  break;
-     }
-     else
-     {
-        gchar *tempFileName = NULL;
+  g_free(m_pSelectedExecTemplate);
+  m_pSelectedExecTemplate = tmpl ? CExecTemplate::m_Copy(tmpl) : NULL;
 
-        /* Try to load icon file with ".png" extension. */
-        tempFileName = g_strdup_printf("%s%s", file_name, EXT_NAME_PNG);
-        file_path = g_build_filename( *dir, ICON_SEARCH_PATH_PIXMAPS, tempFileName, NULL );
-        icon = gdk_pixbuf_new_from_file_at_scale( file_path, size, size, TRUE, NULL );
+  m_nChosenTime = nClickTime;
+  m_nLaunchLatency = 0;
+  m_nLaunchSpawnTime = 0;
+}
 
-        if(tempFileName)
-          g_free(tempFileName);
+/*! \fn gchar** CDesktopAppChooser::m_GetSelectedAppItem_Argv(const gchar * const *items)
+    \brief To get the command of the chosen application with its field codes filled in, for a caller spawning it itself.
 
-        tempFileName = NULL;
+    \param[in] items. The NULL terminated files or URIs to open. It could be NULL.
+    \return The NULL terminated arguments, freed by the caller with g_strfreev(). NULL if no valid command is chosen.
+*/
+gchar** CDesktopAppChooser::m_GetSelectedAppItem_Argv(const gchar * const *items)
+{
+  EXEC_ENTRY entry = { m_SelectedAppItemInfo.icon, m_SelectedAppItemInfo.name, m_SelectedAppItemInfo.desktopfile };
 
-        if(file_path)		
-          g_free(file_path);
+  if(!m_pSelectedExecTemplate)
+    return NULL;
 
-        file_path = NULL;		
+  return CExecTemplate::m_Expand(m_pSelectedExecTemplate, &entry, items);
+}
 
-        if( icon )
-          break;
+/*! \fn gboolean CDesktopAppChooser::m_LaunchApp(APP_ITEM_INFO *appInfo, const gchar * const *items, GError **error)
+    \brief To run an application of the rows without a shell.
 
-        /* Try to load icon file with ".xpm" extension. */
-        tempFileName = g_strdup_printf("%s%s", file_name, EXT_NAME_XPM);
-        file_path = g_build_filename( *dir, ICON_SEARCH_PATH_PIXMAPS, tempFileName, NULL );
-        icon = gdk_pixbuf_new_from_file_at_scale( file_path, size, size, TRUE, NULL );
+    \param[in] appInfo. A node-data of the rows shown by this dialog.
+    \param[in] items. The NULL terminated files or URIs to open. It could be NULL.
+    \param[out] error. It could be NULL.
+    \return TRUE once the application is executed.
+*/
+gboolean CDesktopAppChooser::m_LaunchApp(APP_ITEM_INFO *appInfo, const gchar * const *items, GError **error)
+{
+  const EXEC_TEMPLATE *tmpl = m_pCatalog->m_GetExecTemplate(appInfo);
+  EXEC_ENTRY entry;
 
-        if(tempFileName)
-          g_free(tempFileName);
+  if(!tmpl)
+  {
+     g_set_error(error, G_SHELL_ERROR, G_SHELL_ERROR_FAILED, "The command \"%s\" is invalid", (appInfo && appInfo->exec) ? appInfo->exec : "");
+     return false;
+  }
 
-        tempFileName = NULL;
+  entry.icon = appInfo->icon;
+  entry.name = appInfo->name;
+  entry.desktopfile = appInfo->desktopfile;
 
-        if(file_path)		
-          g_free(file_path);
+  return CExecTemplate::m_Launch(tmpl, &entry, items, error);
+}
 
-        file_path = NULL;		
+/*! \fn gboolean CDesktopAppChooser::m_LaunchSelectedApp(const gchar * const *items, GError **error)
+    \brief To run the chosen application without a shell, and measure the latency from the click to its exec().
 
-        if( icon )
-          break;
+    %i is given the icon file of the chosen application, see m_GetSelectedAppItem_Icon().
 
-        /* Try to load icon whose name in the end of  ".svg" */
-        tempFileName = g_strdup_printf("%s%s", file_name, EXT_NAME_SVG);
-        file_path = g_build_filename( *dir, ICON_SEARCH_PATH_PIXMAPS, tempFileName, NULL );
-        icon = gdk_pixbuf_new_from_file_at_scale( file_path, size, size, TRUE, NULL );
+    \param[in] items. The NULL terminated files or URIs to open. It could be NULL.
+    \param[out] error. It could be NULL.
+    \return TRUE once the application is executed.
+*/
+gboolean CDesktopAppChooser::m_LaunchSelectedApp(const gchar * const *items, GError **error)
+{
+  EXEC_ENTRY entry = { m_SelectedAppItemInfo.icon, m_SelectedAppItemInfo.name, m_SelectedAppItemInfo.desktopfile };
+  gint64 start = 0, now = 0;
+  gboolean bRet = false;
 
-        if(tempFileName)
-          g_free(tempFileName);
+  if(!m_pSelectedExecTemplate)
+  {
+     g_set_error(error, G_SHELL_ERROR, G_SHELL_ERROR_FAILED, "No application with a valid command is chosen");
+     return false;
+  }
 
-        tempFileName = NULL;
+  start = g_get_monotonic_time();
+  bRet = CExecTemplate::m_Launch(m_pSelectedExecTemplate, &entry, items, error);
+  now = g_get_monotonic_time();
 
-        if(file_path)		
-          g_free(file_path);
+  m_nLaunchSpawnTime = now - start;
+  m_nLaunchLatency = m_nChosenTime ? now - m_nChosenTime : 0;
 
-        file_path = NULL;		
+  return bRet;
+}
 
-        if( icon )
-          break;
-     }	
+//----------------------------------- Type-ahead Search
+/*! \fn void CDesktopAppChooser::m_SetSearchText(const gchar *text)
+    \brief To show only the applications whose name, comment or command contains a text.
 
-     /* Searching in "/usr/share/icons/hicolor/SizexSize/apps", 
-        "/usr/local/share/icons/hicolor/SizexSize/apps" directories.
-        These are needed to assign the directory name formed in size. */
-     sizeName = g_strdup_printf("%s/%dx%d/apps", ICON_SEARCH_PATH_HICOLOR, size, size);
-     file_path = g_build_filename( *dir, sizeName, file_name, NULL );
-     icon = gdk_pixbuf_new_from_file_at_scale( file_path, size, size, TRUE, NULL );
+    \param[in] text. An empty text or NULL shows all applications again.
+*/
+void CDesktopAppChooser::m_SetSearchText(const gchar *text)
+{
+  /* Typing further only hides some of the rows found for the previous text. */
+  gboolean bNarrow = m_bSearching && m_pszSearchText && text && strstr(text, m_pszSearchText);
 
-     if(file_path)		
-       g_free( file_path );
+  g_free(m_pszSearchText);
+  m_pszSearchText = (text && *text)? g_strdup(text) : NULL;
 
-     if(sizeName)		
-       g_free(sizeName);
+  if(bNarrow)
+    m_NarrowSearch();
+  else
+    m_ApplySearch();
+}
 
-     file_path = NULL;	
-     sizeName = NULL;	
+/*! \fn void CDesktopAppChooser::m_ApplySearch(void)
+    \brief To look up the current search text in the search index and filter the tree view.
 
-     if( icon )
-       break;
+    \param[in] NONE
+    \return NONE
+*/
+void CDesktopAppChooser::m_ApplySearch(void)
+{
+  gboolean bWasSearching = m_bSearching;
 
-     /* Searching in "/usr/share/icons/hicolor/scalable/apps",
-        "/usr/local/share/icons/hicolor/scalable/apps" directories. */
-     file_path = g_build_filename( *dir, ICON_SEARCH_PATH_HICOLOR_SCALABLE, file_name, NULL );
-     icon = gdk_pixbuf_new_from_file_at_scale( file_path, size, size, TRUE, NULL );
+  g_hash_table_remove_all(m_SearchMatches);
+  m_bSearching = (m_pszSearchText != NULL);
 
-     if(file_path)		
-       g_free( file_path );
+  if(m_bSearching && !bWasSearching)
+    m_SaveExpandedRows();
 
-     file_path = NULL;	
+  if(m_bSearching)
+  {
+     /* In lazy mode only the expanded categories are indexed yet. */
+     if(m_pCatalog->m_GetOptions()->lazy_load)
+       m_pCatalog->m_PopulateAllCategories();
 
-     if( icon )
-       break;
+     m_pCatalog->m_GetSearchIndex()->m_Query(m_pszSearchText, m_SearchMatches);
+  }
 
-     /* Searching in "/usr/share/icons/gnome/scalable" directory. */
-     file_path = g_build_filename( *dir, ICON_SEARCH_PATH_GNOME_SCALABLE, file_name, NULL );
-     icon = gdk_pixbuf_new_from_file_at_scale( file_path, size, size, TRUE, NULL );
+  if(m_TreeFilter)
+    gtk_tree_model_filter_refilter( GTK_TREE_MODEL_FILTER(m_TreeFilter) );
 
-     if(file_path)
-       g_free( file_path );
+  /* The found applications are shown in their categories. */
+  if(m_pWidgets[APPCHOOSER_GtkTreeView])
+  {
+     if(m_bSearching)
+       gtk_tree_view_expand_all( GTK_TREE_VIEW(m_pWidgets[APPCHOOSER_GtkTreeView]) );
+     else if(bWasSearching)
+       m_RestoreExpandedRows();
+  }
+}
 
-     file_path = NULL;	
+/*! \fn void CDesktopAppChooser::m_NarrowSearch(void)
+    \brief To filter the tree view by a search text containing the previous one.
 
-     if( icon )
-       break;
+    Only the applications found before are checked, and only the rows no longer found are filtered again,
+    instead of the whole model.
 
-     /* Searching in "/usr/share/icons/gnome/scalable/apps" directory. */
-     file_path = g_build_filename( *dir, ICON_SEARCH_PATH_GNOME_SCALABLE_APPS, file_name, NULL );
-     icon = gdk_pixbuf_new_from_file_at_scale( file_path, size, size, TRUE, NULL );
+    \param[in] NONE
+    \return NONE
+*/
+void CDesktopAppChooser::m_NarrowSearch(void)
+{
+  GPtrArray *paths = NULL;
+  GtkTreeModel *model = NULL;
 
-     if(file_path)
-       g_free( file_path );
+  m_pCatalog->m_GetSearchIndex()->m_Refine(m_pszSearchText, m_SearchMatches);
 
-     file_path = NULL;	
+  if(!m_TreeFilter)
+    return;
 
-     if( icon )
-       break;
+  model = gtk_tree_model_filter_get_model( GTK_TREE_MODEL_FILTER(m_TreeFilter) );
+  paths = g_ptr_array_new_with_free_func( (GDestroyNotify)gtk_tree_path_free );
 
-     /* Searching in "/usr/share/icons/gnome/SizexSize/apps" directory.
-		These are needed to assign the directory name formed in size. */
-     sizeName = g_strdup_printf("%s/%dx%d/apps", ICON_SEARCH_PATH_GNOME, size, size);
-     file_path = g_build_filename( *dir, sizeName, file_name, NULL );
-     icon = gdk_pixbuf_new_from_file_at_scale( file_path, size, size, TRUE, NULL );
+  m_CollectNarrowedRows(NULL, paths);
 
-     if(file_path)
-       g_free (file_path);
+  /* The rows are hidden by the filter model when they are changed, the applications before their categories. */
+  for(guint i = 0; i < paths->len; i++)
+  {
+     GtkTreePath *path = (GtkTreePath*)g_ptr_array_index(paths, i);
+     GtkTreeIter iter;
 
-     if(sizeName)
-       g_free(sizeName);
+     if( gtk_tree_model_get_iter(model, &iter, path) )
+       gtk_tree_model_row_changed(model, path, &iter);
+  }
 
-     file_path = NULL;
-     sizeName = NULL;
+  g_ptr_array_free(paths, TRUE);
+}
 
-     if( icon )
-       break;
-  }
+/*! \fn gboolean CDesktopAppChooser::m_CollectNarrowedRows(GtkTreeIter *parent, GPtrArray *paths)
+    \brief To find the shown rows which are not found any more, in the filter model.
 
-  return icon;
+    \param[in] parent. A row of the filter model, NULL for the top level.
+    \param[out] paths. The paths of the rows to hide, in the filtered model, are added. A category comes after its children.
+    \return TRUE if a row under the parent is still found.
+*/
+gboolean CDesktopAppChooser::m_CollectNarrowedRows(GtkTreeIter *parent, GPtrArray *paths)
+{
+  GtkTreeIter iter, childIter;
+  gboolean bFound = false;
+
+  if( !gtk_tree_model_iter_children(m_TreeFilter, &iter, parent) )
+    return false;
+
+  do
+  {
+     gpointer nodeData = NULL;
+     gboolean bKeep = false;
+
+     gtk_tree_model_get(m_TreeFilter, &iter, COLUMN_NODEDATA, &nodeData, -1);
+
+     if(nodeData)
+       bKeep = g_hash_table_contains(m_SearchMatches, nodeData);
+     else
+       bKeep = m_CollectNarrowedRows(&iter, paths);
+
+     if(!bKeep)
+     {
+        gtk_tree_model_filter_convert_iter_to_child_iter( GTK_TREE_MODEL_FILTER(m_TreeFilter), &childIter, &iter );
+        g_ptr_array_add( paths, gtk_tree_model_get_path( gtk_tree_model_filter_get_model(GTK_TREE_MODEL_FILTER(m_TreeFilter)), &childIter ) );
+     }
+
+     bFound = bFound || bKeep;
+  } while( gtk_tree_model_iter_next(m_TreeFilter, &iter) );
+
+  return bFound;
 }
 
-/*! \fn GdkPixbuf* CDesktopAppChooser::m_LoadThemeIcon(GtkIconTheme* theme, const char* icon_name, int size)
-    \brief To load a icon contents found in theme icon pool.
+/*! \fn void CDesktopAppChooser::m_SaveExpandedRows(void)
+    \brief To remember the categories expanded in the tree view before a search expands all of them.
 
-    \param[in] theme.
-    \param[in] icon_name. 
-    \param[in] size.
-    \return PixelBuffer object representing the designated icon.
+    \param[in] NONE
+    \return NONE
 */
-GdkPixbuf* CDesktopAppChooser::m_LoadThemeIcon(GtkIconTheme* theme, const char* icon_name, int size)
+void CDesktopAppChooser::m_SaveExpandedRows(void)
 {
-  GdkPixbuf *icon = NULL;
-  const char *file = NULL;
-  GtkIconInfo *info = gtk_icon_theme_lookup_icon(theme, icon_name, size, GTK_ICON_LOOKUP_USE_BUILTIN);
+  GPtrArray *paths = NULL;
+  GtkTreeModel *model = NULL;
 
-  if( G_UNLIKELY(!info) )
-    return NULL;
+  m_FreeExpandedRows();
 
-  file = gtk_icon_info_get_filename( info );
+  if( m_pCatalog->m_GetOptions()->flat_list || !m_TreeFilter || !m_pWidgets[APPCHOOSER_GtkTreeView] )
+    return;
 
-  if( G_LIKELY( file ) )
-    icon = gdk_pixbuf_new_from_file( file, NULL );
-  else
-    icon = gtk_icon_info_get_builtin_pixbuf( info );
+  model = gtk_tree_model_filter_get_model( GTK_TREE_MODEL_FILTER(m_TreeFilter) );
+  paths = g_ptr_array_new_with_free_func( (GDestroyNotify)gtk_tree_path_free );
 
-  gtk_icon_info_free( info );
+  /* Parents are mapped before their children. */
+  gtk_tree_view_map_expanded_rows( GTK_TREE_VIEW(m_pWidgets[APPCHOOSER_GtkTreeView]), cb_collect_expanded_row, paths );
 
-  if( G_LIKELY( icon ) )
+  for(guint i = 0; i < paths->len; i++)
   {
-	int height = gdk_pixbuf_get_height(icon);
-    int width = gdk_pixbuf_get_width(icon);
-
-    /* Scale down the icon if it's too big to be shown. */
-    if(G_UNLIKELY( (height > size) || (width > size) ))
-    {
-      GdkPixbuf *scaled = NULL;
-
-      if( height > width )
-      {
-         width = size * height / width;
-		 height = size;
-      }
-      else if( height < width )
-      {
-         height = size * width / height;
-         width = size;
-      }
-      else
-         height = width = size;
-
-      scaled = gdk_pixbuf_scale_simple( icon, width, height, GDK_INTERP_BILINEAR );
-      g_object_unref( icon );
-      icon = scaled;
-    }
+     GtkTreePath *path = gtk_tree_model_filter_convert_path_to_child_path( GTK_TREE_MODEL_FILTER(m_TreeFilter), (GtkTreePath*)g_ptr_array_index(paths, i) );
+
+     /* The rows of the store are followed while the rows are changed during the search. */
+     if(path)
+     {
+        m_ExpandedRows = g_slist_prepend( m_ExpandedRows, gtk_tree_row_reference_new(model, path) );
+        gtk_tree_path_free(path);
+     }
   }
 
-  return icon;
+  m_ExpandedRows = g_slist_reverse(m_ExpandedRows);
+  g_ptr_array_free(paths, TRUE);
 }
 
-/*! \fn gchar* CDesktopAppChooser::m_GetIconFullName(const char* file_name, int size )
-    \brief Try to find it in "pixmaps", "icons/hicolor", "icons/hicolor/scalable/apps" directories.
+/*! \fn void CDesktopAppChooser::m_RestoreExpandedRows(void)
+    \brief To expand again the categories expanded before the search, and only them.
 
-    \param[in] file_name.
-    \param[in] size.
-    \return Newly allocated string representing the icon's full name.
+    \param[in] NONE
+    \return NONE
 */
-gchar* CDesktopAppChooser::m_GetIconFullName(const char* file_name, int size)
+void CDesktopAppChooser::m_RestoreExpandedRows(void)
 {
-  GdkPixbuf *icon = NULL;
-  char *file_path = NULL;
-  const gchar **dirs = (const gchar**)g_get_system_data_dirs();
-  const gchar **dir = NULL;
-  gchar *sizeName = NULL; 
-	
-  for( (dir = dirs); *dir; ++dir )
+  GtkTreeView *view = GTK_TREE_VIEW(m_pWidgets[APPCHOOSER_GtkTreeView]);
+
+  gtk_tree_view_collapse_all(view);
+
+  for(GSList *row = m_ExpandedRows; row && m_TreeFilter; row = row->next)
   {
-     /* Searching in "/usr/share/pixmaps" */
-     file_path = g_build_filename( *dir, ICON_SEARCH_PATH_PIXMAPS/*"pixmaps"*/, file_name, NULL );
-     icon = gdk_pixbuf_new_from_file_at_scale( file_path, size, size, TRUE, NULL );
+     GtkTreePath *storePath = gtk_tree_row_reference_get_path( (GtkTreeRowReference*)row->data );
+     GtkTreePath *path = NULL;
+
+     /* A category removed during the search. */
+     if(!storePath)
+       continue;
+
+     path = gtk_tree_model_filter_convert_child_path_to_path( GTK_TREE_MODEL_FILTER(m_TreeFilter), storePath );
 
-     if( icon )
+     if(path)
      {
-        /* pixbuf has a referece count of "1" now, as the tree store has added its own reference. 
-           So to decrease the reference count of pixbuf. */
-        g_object_unref(icon);
-        break;
+        gtk_tree_view_expand_row(view, path, FALSE);
+        gtk_tree_path_free(path);
      }
-     else
-     {
-        if(file_path)		
-          g_free(file_path);
 
-        file_path = NULL;		
-     }
+     gtk_tree_path_free(storePath);
+  }
 
-     /* Searching in "/usr/share/icons/hicolor/SizexSize/apps", "/usr/local/share/icons/hicolor/SizexSize/apps" directories.
-        These are needed to assign the directory name formed in size. */
-     sizeName = g_strdup_printf( "%s/%dx%d/apps", ICON_SEARCH_PATH_HICOLOR, size, size);
-     file_path = g_build_filename( *dir, sizeName, file_name, NULL );
-     icon = gdk_pixbuf_new_from_file_at_scale( file_path, size, size, TRUE, NULL );
+  m_FreeExpandedRows();
+}
 
-     if(sizeName)		
-       g_free(sizeName);
+/*! \fn void CDesktopAppChooser::m_FreeExpandedRows(void)
+    \brief To forget the categories expanded before the search.
 
-     sizeName = NULL;	
-		
-     if( icon )
-     {
-        /* pixbuf has a referece count of "1" now, as the tree store has added its own reference. 
-           So to decrease the reference count of pixbuf. */
-        g_object_unref(icon);
-        break;
-     }
-     else
-     {
-        if(file_path)		
-          g_free( file_path );
+    \param[in] NONE
+    \return NONE
+*/
+void CDesktopAppChooser::m_FreeExpandedRows(void)
+{
+  g_slist_free_full(m_ExpandedRows, (GDestroyNotify)gtk_tree_row_reference_free);
+  m_ExpandedRows = NULL;
+}
 
-        file_path = NULL;	
-     }
+/*! \fn gboolean CDesktopAppChooser::m_IsRowVisible(GtkTreeModel *model, GtkTreeIter *iter)
+    \brief To check if a row of the tree store(or the flat list model) passes the search.
 
-     /* Searching in "/usr/share/icons/hicolor/scalable/apps", "/usr/local/share/icons/hicolor/scalable/apps" directories. */
-     file_path = g_build_filename( *dir, ICON_SEARCH_PATH_HICOLOR_SCALABLE, file_name, NULL );
-     icon = gdk_pixbuf_new_from_file_at_scale( file_path, size, size, TRUE, NULL );
+    An application is shown if it is found, a category if one of the applications under it is found.
 
-     if( icon )
-     {
-        /* pixbuf has a referece count of "1" now, as the tree store has added its own reference. 
-           So to decrease the reference count of pixbuf. */
-        g_object_unref(icon);
-        break;
-     }
-     else
-     {
-        if(file_path)		
-          g_free( file_path );
+    \param[in] model.
+    \param[in] iter.
+    \return TRUE or FALSE
+*/
+gboolean CDesktopAppChooser::m_IsRowVisible(GtkTreeModel *model, GtkTreeIter *iter)
+{
+  gpointer nodeData = NULL, dirData = NULL;
+  GtkTreeIter child;
 
-        file_path = NULL;			
-     }
+  if(!m_bSearching)
+    return true;
 
-     /* Searching in "/usr/share/icons/gnome/scalable". */
-     file_path = g_build_filename( *dir, ICON_SEARCH_PATH_GNOME_SCALABLE, file_name, NULL );
-     icon = gdk_pixbuf_new_from_file_at_scale( file_path, size, size, TRUE, NULL );
+  gtk_tree_model_get(model, iter, COLUMN_NODEDATA, &nodeData, COLUMN_DIRDATA, &dirData, -1);
 
-     if( icon )
-     {
-        /* pixbuf has a referece count of "1" now, as the tree store has added its own reference. 
-           So to decrease the reference count of pixbuf. */
-        g_object_unref(icon);
-        break;
-     }
-     else
-     {
-        if(file_path)
-          g_free( file_path );
+  if(nodeData)
+    return g_hash_table_contains(m_SearchMatches, nodeData);
 
-        file_path = NULL;	
-     }
+  /* The dummy child of a lazy category is never found. */
+  if( !dirData || !gtk_tree_model_iter_children(model, &child, iter) )
+    return false;
 
-     /* Searching in "/usr/share/icons/gnome/scalable/apps". */
-     file_path = g_build_filename( *dir, ICON_SEARCH_PATH_GNOME_SCALABLE_APPS, file_name, NULL );
-     icon = gdk_pixbuf_new_from_file_at_scale( file_path, size, size, TRUE, NULL );
+  do
+  {
+     if( m_IsRowVisible(model, &child) )
+       return true;
+  } while( gtk_tree_model_iter_next(model, &child) );
 
-     if( icon )
-     {
-        /* pixbuf has a referece count of "1" now, as the tree store has added its own reference. 
-           So to decrease the reference count of pixbuf. */
-	    g_object_unref(icon);
-        break;
-     }
-     else
-     {
-        if(file_path)
-          g_free( file_path );
+  return false;
+}
 
-        file_path = NULL;	
-     }
+//----------------------------------- Memory Accounting
+/*! \fn void CDesktopAppChooser::m_GetMemoryStats(APPCHOOSER_MEMORY_STATS *stats)
+    \brief To count what the chooser holds: the data of the catalog it shows, see CAppCatalog::m_GetMemoryStats(),
+           and its own widgets.
 
-     /* Searching in "/usr/share/icons/gnome/SizexSize/apps".
-        These are needed to assign the directory name formed in size. */
-     sizeName = g_strdup_printf( "%s/%dx%d/apps", ICON_SEARCH_PATH_GNOME, size, size );
-     file_path = g_build_filename( *dir,  sizeName, file_name, NULL );
-     icon = gdk_pixbuf_new_from_file_at_scale( file_path, size, size, TRUE, NULL );
+    \param[out] stats.
+    \return NONE
+*/
+void CDesktopAppChooser::m_GetMemoryStats(APPCHOOSER_MEMORY_STATS *stats)
+{
+  m_pCatalog->m_GetMemoryStats(stats);
 
-     if(sizeName)
-       g_free(sizeName);
+  if( m_pWidgets[APPCHOOSER_GtkWindow_Main] )
+    count_widget(m_pWidgets[APPCHOOSER_GtkWindow_Main], &stats->nWidgets);
+}
 
-     sizeName = NULL;
+/*! \fn void CDesktopAppChooser::m_DumpMemoryStats(FILE *stream)
+    \brief To write m_GetMemoryStats() as a table.
 
-     if ( icon )
-     {
-        /* pixbuf has a referece count of "1" now, as the tree store has added its own reference. 
-           So to decrease the reference count of pixbuf. */
-        g_object_unref(icon);			
-        break;		
-     }
-	 else
-     {
-        if(file_path)
-          g_free (file_path);
+    \param[in] stream.
+    \return NONE
+*/
+void CDesktopAppChooser::m_DumpMemoryStats(FILE *stream)
+{
+  APPCHOOSER_MEMORY_STATS stats;
+  gchar bytes[32], otherBytes[32];
 
-        file_path = NULL;
-     }
+  m_GetMemoryStats(&stats);
+
+  fprintf(stream, "Memory of the chooser%s:\n", (m_pCatalog != &m_Catalog) ? " (shared catalog)" : "");
+  fprintf(stream, "  %-16s %u (%u categories, %u applications)\n", "rows", stats.nRows, stats.nCategories, stats.nApplications);
+
+  format_bytes(bytes, sizeof(bytes), stats.arena.nRecordBytes);
+  format_bytes(otherBytes, sizeof(otherBytes), stats.arena.nBlockBytes);
+  fprintf(stream, "  %-16s %u records %s in %u blocks of %s\n", "app items", stats.arena.nRecords, bytes, stats.arena.nBlocks, otherBytes);
+
+  format_bytes(bytes, sizeof(bytes), stats.arena.nStringBytes);
+  format_bytes(otherBytes, sizeof(otherBytes), stats.arena.nStringRequestBytes);
+  fprintf(stream, "  %-16s %u distinct %s (%u interned, %s)\n", "strings", stats.arena.nStrings, bytes,
+          stats.arena.nStringRequests, otherBytes);
+
+  format_bytes(bytes, sizeof(bytes), stats.arena.nFreeRecordBytes);
+  format_bytes(otherBytes, sizeof(otherBytes), stats.arena.nUnusedStringBytes);
+  fprintf(stream, "  %-16s %u records %s, %u strings %s\n", "arena unused", stats.arena.nFreeRecords, bytes,
+          stats.arena.nUnusedStrings, otherBytes);
+
+  for(guint i = 0; i < stats.nIconSizes; i++)
+  {
+     gchar label[32];
+
+     g_snprintf(label, sizeof(label), "icons %dpx", stats.iconSizes[i].size);
+     format_bytes(bytes, sizeof(bytes), stats.iconSizes[i].nPixelBytes);
+     fprintf(stream, "  %-16s %u icons %s\n", label, stats.iconSizes[i].nIcons, bytes);
   }
 
-  return file_path;
+  fprintf(stream, "  %-16s %u failed, %u pending\n", "icon loads", stats.nIconFailures, stats.nPendingIcons);
+
+  if(stats.nListIconCapacity)
+  {
+     format_bytes(bytes, sizeof(bytes), stats.nListIconPixelBytes);
+     fprintf(stream, "  %-16s %u / %u icons %s\n", "list icon cache", stats.nListIcons, stats.nListIconCapacity, bytes);
+  }
+
+  format_bytes(bytes, sizeof(bytes), stats.nIconFileBytes);
+  fprintf(stream, "  %-16s %u names %s\n", "icon files", stats.nIconFiles, bytes);
+  fprintf(stream, "  %-16s %u names, %u misses\n", "icon resolver", stats.nResolverNames, stats.nResolverMisses);
+
+  format_bytes(bytes, sizeof(bytes), stats.nSearchBytes);
+  fprintf(stream, "  %-16s %u documents, %u grams %s\n", "search index", stats.nSearchDocuments, stats.nSearchGrams, bytes);
+  fprintf(stream, "  %-16s %u commands\n", "exec templates", stats.nExecTemplates);
+
+  format_bytes(bytes, sizeof(bytes), stats.nSnapshotBytes);
+  fprintf(stream, "  %-16s %s mapped\n", "menu snapshot", bytes);
+  fprintf(stream, "  %-16s %u directories, %u entries\n", "menu tree", stats.nMenuDirectories, stats.nMenuEntries);
+  fprintf(stream, "  %-16s %u\n", "widgets", stats.nWidgets);
+
+  format_bytes(bytes, sizeof(bytes), stats.nTotalBytes);
+  fprintf(stream, "  %-16s %s\n", "total", bytes);
 }
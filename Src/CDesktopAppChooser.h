@@ -12,26 +12,12 @@
 #ifndef __CDESKTOPAPPCHOOSER_H
 #define __CDESKTOPAPPCHOOSER_H
 
+#include <stdio.h>
 #include <glib.h>
 #include <gtk/gtk.h>
 #include <gdk/gdk.h>
 
-#define GMENU_I_KNOW_THIS_IS_UNSTABLE  /* This definition must be added else it will fail to build the image. */
-#include <gmenu-tree.h>	 /* GNOME Menus library header. */
-
-/* The alternative icons searching path. */
-#define ICON_SEARCH_PATH_PIXMAPS  "pixmaps"
-#define ICON_SEARCH_PATH_HICOLOR  "icons/hicolor"
-#define ICON_SEARCH_PATH_HICOLOR_SCALABLE  "icons/hicolor/scalable/apps"
-//
-#define ICON_SEARCH_PATH_GNOME                "icons/gnome"
-#define ICON_SEARCH_PATH_GNOME_SCALABLE       "icons/gnome/scalable"
-#define ICON_SEARCH_PATH_GNOME_SCALABLE_APPS  "icons/gnome/scalable/apps"
-
-/* Extension names of images. */
-#define EXT_NAME_PNG  ".png"
-#define EXT_NAME_XPM  ".xpm"
-#define EXT_NAME_SVG  ".svg"
+#include "CAppCatalog.h"
 
 /*! \enum  APPCHOOSER_WIDGET_IDX
     \brief The indices of the widget array.
@@ -41,20 +27,11 @@ enum APPCHOOSER_WIDGET_IDX {
   APPCHOOSER_GtkTreeView,
   APPCHOOSER_GtkTreeSelection,
   APPCHOOSER_GtkTreeStore,
+  APPCHOOSER_GtkEntry_Search,
+  APPCHOOSER_GtkBox_Busy,
   N_APPCHOOSER_WIDGET_IDX
 };
 
-/*! \struct APP_ITEM_INFO
-    \brief The application item's information. This follows freedesktop.org Desktop Entry specification.
-*/
-typedef  struct {
-  gchar *name;
-  gchar *icon;
-  gchar *exec;
-  gchar *comment;
-  gchar *desktopfile;
-} APP_ITEM_INFO;
-
 /*! \class CDesktopAppChooser
     \brief The X desktop applications chooser GUI class
 */
@@ -68,15 +45,30 @@ class CDesktopAppChooser
     /* GtkTreeView relevant variables. */
     GtkWidget *m_TreeViewTree;
     GtkTreeSelection *m_TreeSelection;  /*!< The selection instance gotten from the created TreeView. */
-    GtkTreeStore  *m_TreeStore;         /*!< The GtkTreeStore type memer variable. */
-    GtkTreeIter m_TopLevelNodeIter, m_ChildNodeIter;  /*!< The tree iterate objects represent top-level and child nodes respectively. */
+    GtkTreeModel  *m_TreeFilter;        /*!< The filter model over the model of the catalog shown by the tree view. */
     GtkWidget *m_pWidgets[N_APPCHOOSER_WIDGET_IDX];   /*!< This is used to store widget instances for accessing in the event handle callback function. */
     APP_ITEM_INFO  m_SelectedAppItemInfo;             /*!< To store the information about the selected system installed application. */
     gboolean m_bIsChosen;  /*!< To indicate if a applicatoin is chosen. */
 
-    /* GNOME Menus relevant variables. */   
-    GMenuTree *m_MenuTree;          /*!< The application menu tree. */
-    GMenuTreeDirectory *m_RootDir;  /*!< The directories' content. */
+    /* Catalog relevant variables. */
+    CAppCatalog m_Catalog;            /*!< The rows of this dialog, unless it shows the shared catalog. It holds the options either way. */
+    CAppCatalog *m_pCatalog;          /*!< The catalog shown, m_Catalog or the shared catalog. */
+    gboolean m_bSharedCatalog;        /*!< To indicate if the dialog shows the process-wide catalog instead of building its own. */
+
+    /* Startup profiling relevant variables. */
+    gint64 m_nFirstExposeStart;   /*!< The start of the span ending at the first drawing of the tree view. */
+
+    /* Type-ahead search relevant variables. */
+    GHashTable *m_SearchMatches;    /*!< The APP_ITEM_INFO objects found for the current search text. */
+    gchar *m_pszSearchText;         /*!< The current search text, NULL if no search is done. */
+    gboolean m_bSearching;          /*!< To indicate if the tree view is filtered. */
+    GSList *m_ExpandedRows;         /*!< The categories(GtkTreeRowReference of the store) expanded before the search, expanded again after it. */
+
+    /* Launcher relevant variables. */
+    EXEC_TEMPLATE *m_pSelectedExecTemplate;  /*!< The template of the chosen application, kept after m_DeinitValue(). */
+    gint64 m_nChosenTime;             /*!< The monotonic time of the click choosing the application. */
+    gint64 m_nLaunchLatency;          /*!< From the click to the exec() of the last m_LaunchSelectedApp(). */
+    gint64 m_nLaunchSpawnTime;        /*!< The expansion and the spawning of the last m_LaunchSelectedApp(). */
 
   public:
     /* The constructor and the destructorof class CDesktopAppChooser. */
@@ -98,16 +90,54 @@ class CDesktopAppChooser
     gchar* m_GetSelectedAppItem_Comment(void) { return (m_SelectedAppItemInfo.comment != NULL)? m_SelectedAppItemInfo.comment : (gchar*)""; }  /*!< To retrive the chosen application's Desktop Entry "comment" value. */         
     gchar* m_GetSelectedAppItem_DesktopEntry(void) { return (m_SelectedAppItemInfo.desktopfile != NULL)? m_SelectedAppItemInfo.desktopfile : (gchar*)""; }  /*!< To retrive the chosen application item's desktop entry file full path. */         
 
-    /* GNOME Menus relevant functions */
+    /* Catalog options, see APP_CATALOG_OPTIONS. */
+    void m_SetLazyLoad(gboolean lazy) { m_Catalog.m_SetLazyLoad(lazy); }  /*!< Create only the categories in m_CreateInitValue(), their applications on expansion. */
+    void m_SetSortByName(gboolean sort) { m_Catalog.m_SetSortByName(sort); }  /*!< Sort the categories and applications by name, the categories first. */
+    void m_SetAsyncMenuLoad(gboolean async) { m_Catalog.m_SetAsyncMenuLoad(async); }  /*!< Parse the menu in a thread while the window is shown(default) or in m_CreateInitValue(). */
+    void m_SetMenuSnapshot(gboolean use) { m_Catalog.m_SetMenuSnapshot(use); }  /*!< Read the menu from the snapshot of the last parse while it is fresh(default). */
+    void m_SetCatalogDaemon(gboolean use) { m_Catalog.m_SetCatalogDaemon(use); }  /*!< Show the rows and icons of a running catalog daemon instead of loading them. */
+    void m_SetFlatList(gboolean flat) { m_Catalog.m_SetFlatList(flat); }  /*!< Show the applications as one list whose icons are loaded only for the rows on screen. */
+    void m_SetAsyncIconLoad(gboolean async) { m_Catalog.m_SetAsyncIconLoad(async); }  /*!< Decode icons in worker threads(default) or in m_CreateInitValue(). */
+    void m_SetDeferScalableIcons(gboolean defer) { m_Catalog.m_SetDeferScalableIcons(defer); }  /*!< Show a bitmap preview of a scalable icon and rasterize it when the other icons are done(default). */
+    void m_SetUsageLog(gboolean use) { m_Catalog.m_SetUsageLog(use); }  /*!< Log the chosen applications and show the most used in a first category(default). */
+
+    /* GtkTreeView relevant functions */
     GtkTreeModel* m_CreateAndFillModel(void);
     GtkWidget* m_CreateTreeView(void);
-    gboolean m_LoadAndBuildAppsMenuTree(void);  /*!< To load the main application menu content and build a tree representing menu contents. */ 
-    gboolean m_AddAppsMenuTopLevelNode(GMenuTreeDirectory *appsDir);  /*!< To addd top-level tree nodes. */
-    gboolean m_AddAppsMenuLeafNode(GMenuTreeDirectory *appsDir);       /*!< To create the leaves of the applications menu contents. */
-    GdkPixbuf* m_LoadIcon( const gchar* name, gint size, gboolean use_fallback );  /*!< To load a icon's image. */
-    GdkPixbuf* m_LoadIconFile( const char* file_name, int size );
-    GdkPixbuf* m_LoadThemeIcon( GtkIconTheme* theme, const char* icon_name, int size );
-    gchar* m_GetIconFullName(const char* file_name, int size);
+    void m_SetViewModel(void);
+    void m_ShowBusy(gboolean busy);
+    void m_ReleaseAppsMenuTree(void);  /*!< To release the menu objects after m_DeinitValue(). */
+    gboolean m_IsMenuLoading(void) { return m_pCatalog->m_IsMenuLoading(); }  /*!< To check if categories of the menu are still to come. */
+    guint m_GetPendingIconCount(void) { return m_pCatalog->m_GetPendingIconCount(); }  /*!< To get the number of icons the rows are still waiting for. */
+    void m_GetIconInternStats(guint &nDecodes, guint &nSaved) { m_pCatalog->m_GetIconInternStats(nDecodes, nSaved); }  /*!< To get how many icons were loaded and how many loads sharing saved. */
+    void m_GetMemoryStats(APPCHOOSER_MEMORY_STATS *stats);
+    void m_DumpMemoryStats(FILE *stream);
+    void m_EndFirstExposeSpan(void) { m_Catalog.m_GetProfiler()->m_End("m_DoModal until first expose", m_nFirstExposeStart); }  /*!< To end the span started by m_DoModal(). */
+    /* Type-ahead search relevant functions. */
+    void m_SetSearchText(const gchar *text);  /*!< To filter the applications by their name, comment or command. */
+    void m_ApplySearch(void);
+    void m_NarrowSearch(void);
+    gboolean m_CollectNarrowedRows(GtkTreeIter *parent, GPtrArray *paths);
+    void m_SaveExpandedRows(void);
+    void m_RestoreExpandedRows(void);
+    void m_FreeExpandedRows(void);
+    gboolean m_IsRowVisible(GtkTreeModel *model, GtkTreeIter *iter);
+    /* Shared catalog relevant functions. */
+    void m_SetSharedCatalog(gboolean shared) { m_bSharedCatalog = shared; }  /*!< Show the process-wide catalog, built by the first dialog and kept while it is referenced. */
+    CAppCatalog* m_GetCatalog(void) { return m_pCatalog; }  /*!< To get the catalog holding the rows shown by this dialog. */
+    static void m_RefSharedCatalog(void);
+    static void m_UnrefSharedCatalog(void);
+    void m_AttachSharedCatalog(void);
+    void m_DetachSharedCatalog(void);
+    void m_OnCatalogChanged(APP_CATALOG_EVENT event);
+    /* Usage log relevant functions. */
+    void m_RecordUsage(APP_ITEM_INFO *appInfo);
+    /* Launcher relevant functions. */
+    void m_SetSelectedExecTemplate(APP_ITEM_INFO *appInfo, gint64 nClickTime);
+    gchar** m_GetSelectedAppItem_Argv(const gchar * const *items);  /*!< To get the chosen application's command with its field codes filled in. */
+    gboolean m_LaunchApp(APP_ITEM_INFO *appInfo, const gchar * const *items, GError **error);
+    gboolean m_LaunchSelectedApp(const gchar * const *items, GError **error);  /*!< To run the chosen application without a shell. */
+    void m_GetLaunchLatency(gint64 &nClickToExec, gint64 &nSpawn) { nClickToExec = m_nLaunchLatency; nSpawn = m_nLaunchSpawnTime; }  /*!< To get the microseconds from the click and of the spawning of the last m_LaunchSelectedApp(). */
     //
     void m_SetIsChosen(gboolean chosen) { m_bIsChosen = chosen; }  /*!< Set the bool value indicating if an application item is chosen. */
     gboolean m_GetIsChosen(void) { return m_bIsChosen; }  /*!< Get the bool value indicating if an application item is chosen. */
@@ -0,0 +1,397 @@
+/*! \file CExecTemplate.cpp
+    \brief Desktop entry "Exec" commands tokenized once into argument templates, and launched without a shell.
+
+    \date 2026-10-17
+    \version 1.0
+
+    \b Change_History:
+    \n (1) 2026-10-17 initial version.
+*/
+
+#include <string.h>
+
+#include "CExecTemplate.h"
+
+//------------------------ Static Functions
+/*! \fn static gboolean is_blank(gchar c)
+    \brief To check if a character separates the arguments of a command.
+*/
+static gboolean is_blank(gchar c)
+{
+  return (c == ' ' || c == '\t' || c == '\n');
+}
+
+/*! \fn static void add_arg(GArray *args, GString *texts, GString *word, guint32 kind, gboolean bQuoted)
+    \brief To append a parsed argument to the arguments and its text to the texts.
+
+    \param[in] args. The EXEC_ARG array, their offsets are from the start of the texts until the template is built.
+    \param[in] texts. The NUL terminated texts.
+    \param[in] word. The text of the argument, with "%%" for a '%'. It is emptied.
+    \param[in] kind. The EXEC_ARG_KIND of the argument.
+    \param[in] bQuoted. TRUE if the argument was quoted, an empty one is kept then.
+*/
+static void add_arg(GArray *args, GString *texts, GString *word, guint32 kind, gboolean bQuoted)
+{
+  EXEC_ARG arg;
+
+  /* An argument made of removed field codes only is removed as well. */
+  if(kind == EXEC_ARG_LITERAL && word->len == 0 && !bQuoted)
+    return;
+
+  arg.kind = kind;
+  arg.offset = (guint32)texts->len;
+
+  if(kind == EXEC_ARG_LITERAL)
+  {
+     /* No field code is left to expand, "%%" is a '%' at once. */
+     for(gsize i = 0; i < word->len; i++)
+     {
+        g_string_append_c(texts, word->str[i]);
+
+        if(word->str[i] == '%')
+          i++;
+     }
+  }
+  else
+    g_string_append_len(texts, word->str, word->len);
+
+  g_string_append_c(texts, '\0');
+  g_array_append_val(args, arg);
+  g_string_truncate(word, 0);
+}
+
+/*! \fn static gchar* get_item_file(const gchar *item)
+    \brief To get the local file of a file or URI given to a command.
+
+    \param[in] item. A file path or a URI.
+    \return The file path, NULL if it is a URI of another scheme than "file". Freed by the caller with g_free().
+*/
+static gchar* get_item_file(const gchar *item)
+{
+  gchar *scheme = g_uri_parse_scheme(item);
+
+  if(!scheme)
+    return g_strdup(item);
+
+  g_free(scheme);
+
+  return g_filename_from_uri(item, NULL, NULL);
+}
+
+/*! \fn static gchar* expand_fields(const gchar *text, const EXEC_ENTRY *entry, const gchar *item)
+    \brief To fill in the field codes of an EXEC_ARG_FIELDS argument.
+
+    \param[in] text. The text of the argument.
+    \param[in] entry. The keys of the desktop entry.
+    \param[in] item. The file or URI of %f and %u. It could be NULL.
+    \return The argument, freed by the caller with g_free().
+*/
+static gchar* expand_fields(const gchar *text, const EXEC_ENTRY *entry, const gchar *item)
+{
+  GString *out = g_string_new(NULL);
+  gchar *file = NULL;
+
+  for(const gchar *p = text; *p; p++)
+  {
+     if(*p != '%' || !p[1])
+     {
+        g_string_append_c(out, *p);
+        continue;
+     }
+
+     switch(*++p)
+     {
+       case '%':
+         g_string_append_c(out, '%');
+         break;
+
+       case 'f':
+         if( item && (file = get_item_file(item)) )
+         {
+            g_string_append(out, file);
+            g_free(file);
+         }
+         break;
+
+       case 'u':
+         if(item)
+           g_string_append(out, item);
+         break;
+
+       case 'c':
+         if(entry && entry->name)
+           g_string_append(out, entry->name);
+         break;
+
+       case 'k':
+         if(entry && entry->desktopfile)
+           g_string_append(out, entry->desktopfile);
+         break;
+     }
+  }
+
+  return g_string_free(out, FALSE);
+}
+
+/*! \fn static gboolean spawn_command(gchar **argv, GError **error)
+    \brief To run a command searching $PATH, and free its arguments.
+
+    \param[in] argv. The NULL terminated arguments, freed with g_strfreev().
+    \param[out] error. It could be NULL.
+    \return TRUE once the program is executed, g_spawn_async() reports a failing exec() of the child.
+*/
+static gboolean spawn_command(gchar **argv, GError **error)
+{
+  gboolean bRet = false;
+
+  if(!argv[0])
+    g_set_error(error, G_SPAWN_ERROR, G_SPAWN_ERROR_FAILED, "The command is empty");
+  else
+    bRet = g_spawn_async(NULL, argv, NULL, G_SPAWN_SEARCH_PATH, NULL, NULL, NULL, error);
+
+  g_strfreev(argv);
+
+  return bRet;
+}
+
+//--------------- Class Methos Implementation.
+/*! \fn EXEC_TEMPLATE* CExecTemplate::m_Parse(const gchar *exec, GError **error)
+    \brief To tokenize an "Exec" command, whose string escapes were already removed by the key file parser.
+
+    Inside double quotes a backslash escapes '"', '`', '$' and '\\', outside it escapes any character.
+
+    \param[in] exec. The command.
+    \param[out] error. G_SHELL_ERROR_EMPTY_STRING or G_SHELL_ERROR_BAD_QUOTING. It could be NULL.
+    \return The template, freed with g_free(). NULL on error.
+*/
+EXEC_TEMPLATE* CExecTemplate::m_Parse(const gchar *exec, GError **error)
+{
+  GArray *args = g_array_new(FALSE, FALSE, sizeof(EXEC_ARG));
+  GString *texts = g_string_new(NULL), *word = g_string_new(NULL);
+  EXEC_TEMPLATE *tmpl = NULL;
+  guint32 kind = EXEC_ARG_LITERAL, flags = 0;
+  gboolean bInWord = false, bQuoted = false, bInQuotes = false;
+  gsize nHeaderSize = 0;
+
+  for(const gchar *p = exec ? exec : ""; *p; p++)
+  {
+     if( !bInQuotes && is_blank(*p) )
+     {
+        if(bInWord)
+          add_arg(args, texts, word, kind, bQuoted);
+
+        kind = EXEC_ARG_LITERAL;
+        bInWord = bQuoted = false;
+        continue;
+     }
+
+     bInWord = true;
+
+     switch(*p)
+     {
+       case '"':
+         bInQuotes = !bInQuotes;
+         bQuoted = true;
+         break;
+
+       case '\\':
+         if( p[1] && (!bInQuotes || strchr("\"`$\\", p[1])) )
+           p++;
+
+         /* The word keeps a '%' as "%%", so an escaped one is not taken for a field code. */
+         if(*p == '%')
+           g_string_append(word, "%%");
+         else
+           g_string_append_c(word, *p);
+         break;
+
+       case '%':
+         if(!p[1])
+           break;
+
+         switch(*++p)
+         {
+           case '%':
+             g_string_append(word, "%%");
+             break;
+
+           case 'f': case 'u': case 'c': case 'k':
+             g_string_append_c(word, '%');
+             g_string_append_c(word, *p);
+             kind = EXEC_ARG_FIELDS;
+             flags |= (*p == 'f') ? EXEC_TEMPLATE_FILE : (*p == 'u') ? EXEC_TEMPLATE_URI : 0;
+             break;
+
+           case 'F': case 'U': case 'i':
+             /* They may only be arguments of their own, elsewhere they are removed. */
+             if( word->len == 0 && !bQuoted && (!p[1] || is_blank(p[1])) )
+             {
+                kind = (*p == 'F') ? EXEC_ARG_FILES : (*p == 'U') ? EXEC_ARG_URIS : EXEC_ARG_ICON;
+                flags |= (*p == 'F') ? EXEC_TEMPLATE_FILES : (*p == 'U') ? EXEC_TEMPLATE_URIS : 0;
+             }
+             break;
+
+           default:
+             /* The deprecated %d, %D, %n, %N, %v and %m, and the unknown ones, are removed. */
+             break;
+         }
+         break;
+
+       default:
+         g_string_append_c(word, *p);
+         break;
+     }
+  }
+
+  if(bInQuotes)
+    g_set_error(error, G_SHELL_ERROR, G_SHELL_ERROR_BAD_QUOTING, "Unterminated quote in the command \"%s\"", exec);
+  else
+  {
+     if(bInWord)
+       add_arg(args, texts, word, kind, bQuoted);
+
+     if(args->len == 0)
+       g_set_error(error, G_SHELL_ERROR, G_SHELL_ERROR_EMPTY_STRING, "The command is empty");
+  }
+
+  if( !bInQuotes && args->len > 0 )
+  {
+     nHeaderSize = G_STRUCT_OFFSET(EXEC_TEMPLATE, args) + args->len * sizeof(EXEC_ARG);
+
+     tmpl = (EXEC_TEMPLATE*)g_malloc(nHeaderSize + texts->len);
+     tmpl->size = (guint32)(nHeaderSize + texts->len);
+     tmpl->nArgs = args->len;
+     tmpl->flags = flags;
+     tmpl->reserved = 0;
+
+     for(guint n = 0; n < args->len; n++)
+     {
+        tmpl->args[n].kind = g_array_index(args, EXEC_ARG, n).kind;
+        tmpl->args[n].offset = (guint32)nHeaderSize + g_array_index(args, EXEC_ARG, n).offset;
+     }
+
+     memcpy((gchar*)tmpl + nHeaderSize, texts->str, texts->len);
+  }
+
+  g_string_free(word, TRUE);
+  g_string_free(texts, TRUE);
+  g_array_free(args, TRUE);
+
+  return tmpl;
+}
+
+/*! \fn EXEC_TEMPLATE* CExecTemplate::m_Copy(const EXEC_TEMPLATE *tmpl)
+    \brief To copy a template, its texts are at offsets from its start.
+
+    \param[in] tmpl.
+    \return The copy, freed with g_free().
+*/
+EXEC_TEMPLATE* CExecTemplate::m_Copy(const EXEC_TEMPLATE *tmpl)
+{
+  EXEC_TEMPLATE *copy = (EXEC_TEMPLATE*)g_malloc(tmpl->size);
+
+  memcpy(copy, tmpl, tmpl->size);
+
+  return copy;
+}
+
+/*! \fn gboolean CExecTemplate::m_TakesOneItem(const EXEC_TEMPLATE *tmpl)
+    \brief To check if a command takes a single file or URI, so one instance is run for each of them.
+
+    \param[in] tmpl.
+    \return TRUE if it holds %f or %u but neither %F nor %U.
+*/
+gboolean CExecTemplate::m_TakesOneItem(const EXEC_TEMPLATE *tmpl)
+{
+  return ( (tmpl->flags & (EXEC_TEMPLATE_FILE | EXEC_TEMPLATE_URI)) && !(tmpl->flags & (EXEC_TEMPLATE_FILES | EXEC_TEMPLATE_URIS)) );
+}
+
+/*! \fn gchar** CExecTemplate::m_Expand(const EXEC_TEMPLATE *tmpl, const EXEC_ENTRY *entry, const gchar * const *items)
+    \brief To fill in the field codes of a template. %f and %u take the first item, %f and %F skip the URIs of
+           other schemes than "file", and a command taking no file is given none.
+
+    \param[in] tmpl.
+    \param[in] entry. The keys of the desktop entry. It could be NULL.
+    \param[in] items. The NULL terminated files or URIs. It could be NULL.
+    \return The NULL terminated arguments, freed by the caller with g_strfreev().
+*/
+gchar** CExecTemplate::m_Expand(const EXEC_TEMPLATE *tmpl, const EXEC_ENTRY *entry, const gchar * const *items)
+{
+  GPtrArray *argv = g_ptr_array_sized_new(tmpl->nArgs + 1);
+  const gchar *item = (items && items[0]) ? items[0] : NULL;
+
+  for(guint n = 0; n < tmpl->nArgs; n++)
+  {
+     const gchar *text = m_GetArgText(tmpl, n);
+     gchar *arg = NULL;
+
+     switch(tmpl->args[n].kind)
+     {
+       case EXEC_ARG_LITERAL:
+         g_ptr_array_add(argv, g_strdup(text));
+         break;
+
+       case EXEC_ARG_FIELDS:
+         arg = expand_fields(text, entry, item);
+
+         if(*arg)
+           g_ptr_array_add(argv, arg);
+         else
+           g_free(arg);
+         break;
+
+       case EXEC_ARG_FILES:
+         for(guint i = 0; items && items[i]; i++)
+         {
+            if( (arg = get_item_file(items[i])) )
+              g_ptr_array_add(argv, arg);
+         }
+         break;
+
+       case EXEC_ARG_URIS:
+         for(guint i = 0; items && items[i]; i++)
+           g_ptr_array_add(argv, g_strdup(items[i]));
+         break;
+
+       case EXEC_ARG_ICON:
+         if(entry && entry->icon && *entry->icon)
+         {
+            g_ptr_array_add(argv, g_strdup("--icon"));
+            g_ptr_array_add(argv, g_strdup(entry->icon));
+         }
+         break;
+     }
+  }
+
+  g_ptr_array_add(argv, NULL);
+
+  return (gchar**)g_ptr_array_free(argv, FALSE);
+}
+
+/*! \fn gboolean CExecTemplate::m_Launch(const EXEC_TEMPLATE *tmpl, const EXEC_ENTRY *entry, const gchar * const *items, GError **error)
+    \brief To run a command with its field codes filled in. A command taking a single file or URI is run once
+           for each item.
+
+    \param[in] tmpl.
+    \param[in] entry. The keys of the desktop entry. It could be NULL.
+    \param[in] items. The NULL terminated files or URIs. It could be NULL.
+    \param[out] error. It could be NULL.
+    \return TRUE once every program is executed. On FALSE the items after the failing one are not launched.
+*/
+gboolean CExecTemplate::m_Launch(const EXEC_TEMPLATE *tmpl, const EXEC_ENTRY *entry, const gchar * const *items, GError **error)
+{
+  if( items && items[0] && items[1] && m_TakesOneItem(tmpl) )
+  {
+     for(guint i = 0; items[i]; i++)
+     {
+        const gchar *item[2] = { items[i], NULL };
+
+        if( !spawn_command(m_Expand(tmpl, entry, item), error) )
+          return false;
+     }
+
+     return true;
+  }
+
+  return spawn_command(m_Expand(tmpl, entry, items), error);
+}
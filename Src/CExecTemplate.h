@@ -0,0 +1,86 @@
+/*! \file    CExecTemplate.h
+    \brief   Desktop entry "Exec" commands tokenized once into argument templates, and launched without a shell.
+
+    \date    2026-10-17
+    \version 1.0
+
+    \b Change_History:
+    \n 1) 2026-10-17 initialized.
+*/
+
+#ifndef __CEXECTEMPLATE_H
+#define __CEXECTEMPLATE_H
+
+#include <glib.h>
+
+/*! \enum EXEC_ARG_KIND
+    \brief The kinds of the arguments of a template.
+*/
+typedef enum
+{
+  EXEC_ARG_LITERAL = 0,  /*!< Passed as it is. */
+  EXEC_ARG_FIELDS,       /*!< Holds %f, %u, %c or %k, and "%%" for a '%'. It is dropped if it expands to nothing. */
+  EXEC_ARG_FILES,        /*!< %F, one argument per local file. */
+  EXEC_ARG_URIS,         /*!< %U, one argument per URI. */
+  EXEC_ARG_ICON          /*!< %i, "--icon" and the icon if the entry has one. */
+} EXEC_ARG_KIND;
+
+/*! \enum EXEC_TEMPLATE_FLAGS
+    \brief The field codes taking files or URIs which a template holds.
+*/
+typedef enum
+{
+  EXEC_TEMPLATE_FILE = 1 << 0,  /*!< %f */
+  EXEC_TEMPLATE_FILES = 1 << 1, /*!< %F */
+  EXEC_TEMPLATE_URI = 1 << 2,   /*!< %u */
+  EXEC_TEMPLATE_URIS = 1 << 3   /*!< %U */
+} EXEC_TEMPLATE_FLAGS;
+
+/*! \struct EXEC_ARG
+    \brief An argument of a template. Its text is at an offset from the template, so a template may be copied as it is.
+*/
+typedef struct {
+  guint32 kind;    /*!< EXEC_ARG_KIND */
+  guint32 offset;  /*!< The offset of the NUL terminated text from the start of the template. */
+} EXEC_ARG;
+
+/*! \struct EXEC_TEMPLATE
+    \brief A tokenized "Exec" command in one block: this header, "nArgs" arguments, then their texts.
+*/
+typedef struct {
+  guint32 size;      /*!< The bytes of the whole block. */
+  guint32 nArgs;
+  guint32 flags;     /*!< EXEC_TEMPLATE_FLAGS */
+  guint32 reserved;
+  EXEC_ARG args[1];
+} EXEC_TEMPLATE;
+
+/*! \struct EXEC_ENTRY
+    \brief The keys of the desktop entry the field codes other than the files and URIs expand to.
+*/
+typedef struct {
+  const gchar *icon;         /*!< %i, the "Icon" key or an icon file. It could be NULL. */
+  const gchar *name;         /*!< %c, the translated "Name" key. It could be NULL. */
+  const gchar *desktopfile;  /*!< %k, the desktop file path. It could be NULL. */
+} EXEC_ENTRY;
+
+/*! \class CExecTemplate
+    \brief Parse an "Exec" command of the Desktop Entry specification into an argument template, then fill in its
+           field codes and spawn it.
+
+    The quoting and the field codes are handled once by m_Parse(), a launch only copies the arguments and
+    expands the few field codes. The deprecated and unknown field codes are removed, %F, %U and %i are only
+    taken as arguments of their own. The command is run by g_spawn_async() searching $PATH, no shell is involved.
+    The methods hold no state.
+*/
+class CExecTemplate
+{
+  public:
+    static EXEC_TEMPLATE* m_Parse(const gchar *exec, GError **error);
+    static EXEC_TEMPLATE* m_Copy(const EXEC_TEMPLATE *tmpl);
+    static const gchar* m_GetArgText(const EXEC_TEMPLATE *tmpl, guint n) { return (const gchar*)tmpl + tmpl->args[n].offset; }  /*!< To get the text of an argument. */
+    static gboolean m_TakesOneItem(const EXEC_TEMPLATE *tmpl);
+    static gchar** m_Expand(const EXEC_TEMPLATE *tmpl, const EXEC_ENTRY *entry, const gchar * const *items);
+    static gboolean m_Launch(const EXEC_TEMPLATE *tmpl, const EXEC_ENTRY *entry, const gchar * const *items, GError **error);
+};
+#endif /* __CEXECTEMPLATE_H */
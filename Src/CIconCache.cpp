@@ -0,0 +1,247 @@
+/*! \file CIconCache.cpp
+    \brief Persistent on-disk cache of pre-scaled icon pixel buffers.
+
+    \date 2026-10-17
+    \version 1.0
+
+    \b Change_History:
+    \n (1) 2026-10-17 initial version.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include "CIconCache.h"
+
+/*! \def ICON_CACHE_ALIGN
+    \brief The alignment of the pixel data inside a cached icon file.
+*/
+#define ICON_CACHE_ALIGN  16
+
+//------------------------ Callback Functions
+/*! \fn static void cb_unmap_icon_data(guchar *pixels, gpointer data)
+    \brief Release the mapped cache file when the pixel buffer wrapping it is finalized.
+
+    \param[in] pixels. The pixel data of the pixel buffer.
+    \param[in] data. The GMappedFile object.
+*/
+static void cb_unmap_icon_data(guchar *pixels, gpointer data)
+{
+  pixels = pixels;
+
+  g_mapped_file_unref( (GMappedFile*)data );
+}
+
+/*! \fn static gboolean get_file_mtime(const gchar *file_name, gint64 *mtime)
+    \brief To get the modification time of a file.
+
+    \param[in] file_name.
+    \param[out] mtime.
+    \return TRUE or FALSE
+*/
+static gboolean get_file_mtime(const gchar *file_name, gint64 *mtime)
+{
+  struct stat st;
+
+  if( !file_name || stat(file_name, &st) != 0 )
+    return false;
+
+  *mtime = (gint64)st.st_mtime;
+
+  return true;
+}
+
+//--------------- Class Methos Implementation.
+/*! \fn CIconCache::CIconCache()
+    \brief CIconCache constructor
+*/
+CIconCache::CIconCache()
+{
+  m_pszCacheDir = NULL;
+  m_pszContext = NULL;
+}
+
+/*! \fn CIconCache::~CIconCache()
+    \brief CIconCache destructor
+*/
+CIconCache::~CIconCache()
+{
+  g_free(m_pszCacheDir);
+  g_free(m_pszContext);
+}
+
+/*! \fn gboolean CIconCache::m_Init(const gchar *context)
+    \brief To create the cache directory if it does not exist yet.
+
+    \param[in] context. The extra key part, e.g. the current icon theme name. It could be NULL.
+    \return TRUE or FALSE. On FALSE the cache is disabled and every lookup misses.
+*/
+gboolean CIconCache::m_Init(const gchar *context)
+{
+  gchar *dir = NULL;
+
+  g_free(m_pszContext);
+  m_pszContext = g_strdup( context ? context : "" );
+
+  if(m_pszCacheDir)
+    return true;
+
+  /* g_get_user_cache_dir() honours $XDG_CACHE_HOME. */
+  dir = g_build_filename( g_get_user_cache_dir(), ICON_CACHE_DIR_NAME, NULL );
+
+  if( g_mkdir_with_parents(dir, 0700) != 0 )
+  {
+     g_free(dir);
+     return false;
+  }
+
+  m_pszCacheDir = dir;
+
+  return true;
+}
+
+/*! \fn gchar* CIconCache::m_GetEntryFileName(const gchar *name, gint size)
+    \brief To build the full name of the cache file of an icon.
+
+    \param[in] name. The icon name.
+    \param[in] size. The requested icon size.
+    \return Newly allocated string.
+*/
+gchar* CIconCache::m_GetEntryFileName(const gchar *name, gint size)
+{
+  gchar *key = NULL, *digest = NULL, *file_name = NULL;
+
+  key = g_strdup_printf("%s\n%d\n%s", m_pszContext, size, name);
+  digest = g_compute_checksum_for_string( G_CHECKSUM_MD5, key, -1 );
+  file_name = g_build_filename( m_pszCacheDir, digest, NULL );
+
+  g_free(digest);
+  g_free(key);
+
+  return file_name;
+}
+
+/*! \fn GdkPixbuf* CIconCache::m_Lookup(const gchar *name, gint size)
+    \brief To map a cached icon. Nothing is decoded, the returned pixel buffer refers to the mapped file.
+
+    \param[in] name. The icon name.
+    \param[in] size. The requested icon size.
+    \return PixelBuffer object or NULL if there has no valid entry.
+*/
+GdkPixbuf* CIconCache::m_Lookup(const gchar *name, gint size)
+{
+  gchar *file_name = NULL;
+  GMappedFile *mapped = NULL;
+  const gchar *contents = NULL;
+  const ICON_CACHE_HEADER *header = NULL;
+  gsize length = 0;
+  gint64 mtime = 0;
+
+  if( G_UNLIKELY(!m_pszCacheDir || !name) )
+    return NULL;
+
+  file_name = m_GetEntryFileName(name, size);
+  mapped = g_mapped_file_new( file_name, FALSE, NULL );
+  g_free(file_name);
+
+  if( !mapped )
+    return NULL;
+
+  contents = g_mapped_file_get_contents(mapped);
+  length = g_mapped_file_get_length(mapped);
+  header = (const ICON_CACHE_HEADER*)contents;
+
+  /* To validate the entry: its format, its size and the source image modification time. */
+  if( length < sizeof(ICON_CACHE_HEADER) ||
+      header->magic != ICON_CACHE_MAGIC || header->version != ICON_CACHE_VERSION ||
+      header->size != (guint32)size ||
+      header->path_len == 0 || sizeof(ICON_CACHE_HEADER) + header->path_len > header->data_offset ||
+      header->rowstride < header->width * 4 ||
+      (gsize)header->data_offset + (gsize)header->rowstride * header->height > length ||
+      contents[sizeof(ICON_CACHE_HEADER) + header->path_len - 1] != '\0' ||
+      !get_file_mtime( contents + sizeof(ICON_CACHE_HEADER), &mtime ) ||
+      mtime != header->mtime )
+  {
+     g_mapped_file_unref(mapped);
+     return NULL;
+  }
+
+  /* The pixel buffer takes over the mapping and releases it in cb_unmap_icon_data(). */
+  return gdk_pixbuf_new_from_data( (const guchar*)(contents + header->data_offset),
+                                   GDK_COLORSPACE_RGB, TRUE, 8,
+                                   header->width, header->height, header->rowstride,
+                                   cb_unmap_icon_data, mapped );
+}
+
+/*! \fn gboolean CIconCache::m_Store(const gchar *name, gint size, const gchar *source_file, GdkPixbuf *pixbuf)
+    \brief To write a decoded icon into the cache.
+
+    \param[in] name. The icon name.
+    \param[in] size. The requested icon size.
+    \param[in] source_file. The full name of the image file the icon was decoded from.
+    \param[in] pixbuf. The decoded and scaled icon.
+    \return TRUE or FALSE
+*/
+gboolean CIconCache::m_Store(const gchar *name, gint size, const gchar *source_file, GdkPixbuf *pixbuf)
+{
+  ICON_CACHE_HEADER header;
+  GdkPixbuf *rgba = NULL;
+  gchar *file_name = NULL, *buffer = NULL;
+  const guchar *pixels = NULL;
+  gsize length = 0;
+  gint64 mtime = 0;
+  gint rowstride = 0;
+  gboolean bRet = FALSE;
+
+  if( G_UNLIKELY(!m_pszCacheDir || !name || !pixbuf) )
+    return false;
+
+  if( gdk_pixbuf_get_bits_per_sample(pixbuf) != 8 || !get_file_mtime(source_file, &mtime) )
+    return false;
+
+  /* Entries are always stored as RGBA. */
+  if( gdk_pixbuf_get_has_alpha(pixbuf) )
+    rgba = (GdkPixbuf*)g_object_ref(pixbuf);
+  else
+    rgba = gdk_pixbuf_add_alpha(pixbuf, FALSE, 0, 0, 0);
+
+  if( !rgba )
+    return false;
+
+  memset(&header, 0, sizeof(ICON_CACHE_HEADER));
+  header.magic = ICON_CACHE_MAGIC;
+  header.version = ICON_CACHE_VERSION;
+  header.size = size;
+  header.width = gdk_pixbuf_get_width(rgba);
+  header.height = gdk_pixbuf_get_height(rgba);
+  header.rowstride = header.width * 4;
+  header.mtime = mtime;
+  header.path_len = strlen(source_file) + 1;
+  header.data_offset = (sizeof(ICON_CACHE_HEADER) + header.path_len + ICON_CACHE_ALIGN - 1) & ~(ICON_CACHE_ALIGN - 1);
+
+  length = header.data_offset + header.rowstride * header.height;
+  buffer = (gchar*)g_malloc0(length);
+
+  memcpy(buffer, &header, sizeof(ICON_CACHE_HEADER));
+  memcpy(buffer + sizeof(ICON_CACHE_HEADER), source_file, header.path_len);
+
+  /* Copy row by row, the source rowstride could have padding. */
+  pixels = gdk_pixbuf_get_pixels(rgba);
+  rowstride = gdk_pixbuf_get_rowstride(rgba);
+
+  for(guint32 y = 0; y < header.height; y++)
+     memcpy(buffer + header.data_offset + y * header.rowstride, pixels + y * rowstride, header.rowstride);
+
+  /* g_file_set_contents() writes a temporary file and renames it, so a reader never sees a partial entry. */
+  file_name = m_GetEntryFileName(name, size);
+  bRet = g_file_set_contents(file_name, buffer, length, NULL);
+
+  g_free(file_name);
+  g_free(buffer);
+  g_object_unref(rgba);
+
+  return bRet;
+}
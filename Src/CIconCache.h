@@ -0,0 +1,70 @@
+/*! \file    CIconCache.h
+    \brief   Persistent on-disk cache of pre-scaled icon pixel buffers.
+
+    \date    2026-10-17
+    \version 1.0
+
+    \b Change_History:
+    \n 1) 2026-10-17 initialized.
+*/
+
+#ifndef __CICONCACHE_H
+#define __CICONCACHE_H
+
+#include <glib.h>
+#include <gdk-pixbuf/gdk-pixbuf.h>
+
+/*! \def ICON_CACHE_DIR_NAME
+    \brief The sub-directory under $XDG_CACHE_HOME holding the cached icons. The version is part of the name, so
+           a format change simply starts a new, empty cache.
+*/
+#define ICON_CACHE_DIR_NAME  "DesktopAppChooser/icons-v2"
+
+/*! \def ICON_CACHE_MAGIC
+    \brief The magic number("DACI") at the beginning of every cached icon file.
+*/
+#define ICON_CACHE_MAGIC    0x49434144
+#define ICON_CACHE_VERSION  2
+
+/*! \struct ICON_CACHE_HEADER
+    \brief The header of a cached icon file. It is followed by the source file path(NUL terminated)
+           and, at offset "data_offset", by "height" rows of raw RGBA pixels.
+*/
+typedef struct {
+  guint32 magic;
+  guint32 version;
+  guint32 size;         /*!< The requested icon size. */
+  guint32 width;
+  guint32 height;
+  guint32 rowstride;
+  gint64  mtime;        /*!< The modification time of the source image file when it was decoded. */
+  guint32 path_len;     /*!< The length of the source file path including the terminating NUL. */
+  guint32 data_offset;  /*!< The offset of the pixel data from the beginning of the file. */
+} ICON_CACHE_HEADER;
+
+/*! \class CIconCache
+    \brief Store decoded and scaled icons in $XDG_CACHE_HOME and map them back without decoding.
+
+    Every entry is keyed by the icon name, the requested size and the modification time of the
+    image file it was decoded from. A warm lookup is one open()+mmap() of the entry plus one stat()
+    of the source file, the returned pixel buffer wraps the mapped memory directly.
+    The object holds no mutable state after m_Init(), so lookups may run on any thread.
+*/
+class CIconCache
+{
+  private:
+    gchar *m_pszCacheDir;  /*!< The full path of the cache directory. NULL if the cache is disabled. */
+    gchar *m_pszContext;   /*!< Extra key part(e.g. the icon theme name) mixed into every entry's key. */
+
+    gchar* m_GetEntryFileName(const gchar *name, gint size);
+
+  public:
+    CIconCache();
+    ~CIconCache();
+
+    gboolean m_Init(const gchar *context);
+    gboolean m_IsEnabled(void) { return (m_pszCacheDir != NULL); }  /*!< To check if the cache directory is usable. */
+    GdkPixbuf* m_Lookup(const gchar *name, gint size);
+    gboolean m_Store(const gchar *name, gint size, const gchar *source_file, GdkPixbuf *pixbuf);
+};
+#endif /* __CICONCACHE_H */
@@ -0,0 +1,424 @@
+/*! \file CIconResolver.cpp
+    \brief Resolve icon file names in the alternative icon searching paths through a prebuilt index.
+
+    \date 2026-10-17
+    \version 1.0
+
+    \b Change_History:
+    \n (1) 2026-10-17 initial version.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "CIconResolver.h"
+
+/*! \enum ICON_SEARCH_RANK
+    \brief The probing order of the searching paths inside one system data directory.
+           Entries of an earlier data directory always rank before the ones of a later data directory.
+*/
+enum ICON_SEARCH_RANK
+{
+  RANK_PIXMAPS_PNG = 0,    /* Also a "pixmaps" file named with its extension. */
+  RANK_PIXMAPS_XPM,
+  RANK_PIXMAPS_SVG,
+  RANK_HICOLOR_SIZE,
+  RANK_HICOLOR_SCALABLE,
+  RANK_GNOME_SCALABLE,
+  RANK_GNOME_SCALABLE_APPS,
+  RANK_GNOME_SIZE,
+  N_RANKS_PER_DIR
+};
+
+/*! \enum ICON_OTHER_SIZE_RANK
+    \brief The order of the "SizexSize" directories of the other sizes inside one system data directory.
+           They rank after the searching paths of every data directory, so an icon of the wrong size is only
+           taken if no data directory has one of the right size.
+*/
+enum ICON_OTHER_SIZE_RANK
+{
+  RANK_HICOLOR_OTHER_SIZE = 0,  /* The closest size first. */
+  RANK_GNOME_OTHER_SIZE,
+  N_OTHER_SIZE_RANKS_PER_DIR
+};
+
+/*! \def ICON_SIZE_RANKS
+    \brief The number of ranks inside one ICON_SEARCH_RANK, used to order the directories of the other sizes:
+           the bigger sizes from the closest, then the smaller sizes from the closest. A bigger image is
+           decoded at the icon size, a smaller one would be shown smaller.
+*/
+#define ICON_SIZE_RANKS  1024
+
+/*! \struct ICON_INDEX_ENTRY
+    \brief The best ranked file found for a key of the index.
+*/
+typedef struct {
+  guint rank;
+  gchar *path;
+} ICON_INDEX_ENTRY;
+
+/*! \def STEM_KEY_PREFIX
+    \brief Keys of "pixmaps" files looked up without their extension start with this character,
+           which can not be a part of a file name.
+*/
+#define STEM_KEY_PREFIX  "/"
+
+//------------------------ Helper Functions
+/*! \fn static void free_index_entry(gpointer data)
+    \brief To release an index entry.
+
+    \param[in] data. The ICON_INDEX_ENTRY object.
+*/
+static void free_index_entry(gpointer data)
+{
+  ICON_INDEX_ENTRY *entry = (ICON_INDEX_ENTRY*)data;
+
+  g_free(entry->path);
+  g_free(entry);
+}
+
+/*! \fn static void free_index(gpointer data)
+    \brief To release an index.
+
+    \param[in] data. The GHashTable object.
+*/
+static void free_index(gpointer data)
+{
+  g_hash_table_destroy( (GHashTable*)data );
+}
+
+/*! \fn static gboolean has_image_extension(const gchar *file_name)
+    \brief To check if a name has one of the image file extensions. This is the same test the probing code used.
+
+    \param[in] file_name.
+    \return TRUE or FALSE
+*/
+static gboolean has_image_extension(const gchar *file_name)
+{
+  return g_strrstr(file_name, ".") &&
+         (g_strrstr(file_name, EXT_NAME_PNG) || g_strrstr(file_name, EXT_NAME_XPM) || g_strrstr(file_name, EXT_NAME_SVG));
+}
+
+/*! \fn static void add_index_entry(GHashTable *index, const gchar *key, guint rank, const gchar *path)
+    \brief To add a file to the index unless a better ranked file has the same key.
+
+    \param[in] index.
+    \param[in] key.
+    \param[in] rank.
+    \param[in] path. The full name of the file.
+*/
+static void add_index_entry(GHashTable *index, const gchar *key, guint rank, const gchar *path)
+{
+  ICON_INDEX_ENTRY *entry = (ICON_INDEX_ENTRY*)g_hash_table_lookup(index, key);
+
+  if(entry)
+  {
+     if(entry->rank <= rank)
+       return;
+
+     g_free(entry->path);
+  }
+  else
+  {
+     entry = g_new0(ICON_INDEX_ENTRY, 1);
+     g_hash_table_insert(index, g_strdup(key), entry);
+  }
+
+  entry->rank = rank;
+  entry->path = g_strdup(path);
+}
+
+/*! \fn static void scan_directory(GHashTable *index, const gchar *data_dir, const gchar *sub_dir, guint base_rank, guint rank,
+                                      guint size_rank, gboolean is_pixmaps)
+    \brief To add every file of one searching path to the index.
+
+    \param[in] index.
+    \param[in] data_dir. The system data directory.
+    \param[in] sub_dir. The searching path relative to data_dir.
+    \param[in] base_rank. The rank of the first searching path in data_dir.
+    \param[in] rank. The rank of this searching path.
+    \param[in] size_rank. The rank of the directory's icon size among the other sizes, 0 for the other searching paths.
+    \param[in] is_pixmaps. TRUE for the "pixmaps" directory.
+*/
+static void scan_directory(GHashTable *index, const gchar *data_dir, const gchar *sub_dir,
+                           guint base_rank, guint rank, guint size_rank, gboolean is_pixmaps)
+{
+  gchar *dir_path = g_build_filename(data_dir, sub_dir, NULL);
+  GDir *dir = g_dir_open(dir_path, 0, NULL);
+  const gchar *name = NULL;
+
+  if(!dir)
+  {
+     g_free(dir_path);
+     return;
+  }
+
+  while( (name = g_dir_read_name(dir)) != NULL )
+  {
+     gchar *path = g_build_filename(dir_path, name, NULL);
+
+     if(!is_pixmaps)
+       add_index_entry(index, name, (base_rank + rank) * ICON_SIZE_RANKS + size_rank, path);
+     else if( has_image_extension(name) )
+     {
+        /* A "pixmaps" file matches its own name, and its name without the extension
+           in ".png", ".xpm", ".svg" preference order. */
+        add_index_entry(index, name, (base_rank + RANK_PIXMAPS_PNG) * ICON_SIZE_RANKS, path);
+
+        if( g_str_has_suffix(name, EXT_NAME_PNG) || g_str_has_suffix(name, EXT_NAME_XPM) || g_str_has_suffix(name, EXT_NAME_SVG) )
+        {
+           gchar *stem = g_strndup(name, strlen(name) - strlen(EXT_NAME_PNG));
+           gchar *key = g_strconcat(STEM_KEY_PREFIX, stem, NULL);
+           guint stemRank = g_str_has_suffix(name, EXT_NAME_PNG)? RANK_PIXMAPS_PNG :
+                            g_str_has_suffix(name, EXT_NAME_XPM)? RANK_PIXMAPS_XPM : RANK_PIXMAPS_SVG;
+
+           add_index_entry(index, key, (base_rank + stemRank) * ICON_SIZE_RANKS, path);
+
+           g_free(key);
+           g_free(stem);
+        }
+     }
+
+     g_free(path);
+  }
+
+  g_dir_close(dir);
+  g_free(dir_path);
+}
+
+/*! \fn static void scan_other_size_directories(GHashTable *index, const gchar *data_dir, const gchar *theme_dir,
+                                                   guint base_rank, guint rank, gint size)
+    \brief To add the files of the "SizexSize/apps" directories of an icon theme whose size is not the icon size.
+
+    \param[in] index.
+    \param[in] data_dir. The system data directory.
+    \param[in] theme_dir. The icon theme relative to data_dir, e.g. "icons/hicolor".
+    \param[in] base_rank. The rank of the other sizes of the first icon theme in data_dir.
+    \param[in] rank. The rank of the other sizes of this icon theme.
+    \param[in] size. The icon size, its own directory is scanned by the caller.
+*/
+static void scan_other_size_directories(GHashTable *index, const gchar *data_dir, const gchar *theme_dir,
+                                        guint base_rank, guint rank, gint size)
+{
+  gchar *dir_path = g_build_filename(data_dir, theme_dir, NULL);
+  GDir *dir = g_dir_open(dir_path, 0, NULL);
+  const gchar *name = NULL;
+
+  if(!dir)
+  {
+     g_free(dir_path);
+     return;
+  }
+
+  while( (name = g_dir_read_name(dir)) != NULL )
+  {
+     gint width = 0, height = 0, nameLen = 0;
+     guint size_rank = 0;
+     gchar *sub_dir = NULL;
+
+     if( sscanf(name, "%dx%d%n", &width, &height, &nameLen) != 2 || name[nameLen] != '\0' ||
+         width != height || width <= 0 || width == size )
+       continue;
+
+     if( width > size )
+       size_rank = MIN( (guint)(width - size), ICON_SIZE_RANKS / 2 - 1 );
+     else
+       size_rank = ICON_SIZE_RANKS / 2 + MIN( (guint)(size - width), ICON_SIZE_RANKS / 2 - 1 );
+
+     sub_dir = g_strdup_printf("%s/%s/apps", theme_dir, name);
+     scan_directory(index, data_dir, sub_dir, base_rank, rank, size_rank, FALSE);
+     g_free(sub_dir);
+  }
+
+  g_dir_close(dir);
+  g_free(dir_path);
+}
+
+//--------------- Class Methos Implementation.
+/*! \fn CIconResolver::CIconResolver()
+    \brief CIconResolver constructor
+*/
+CIconResolver::CIconResolver()
+{
+  g_mutex_init(&m_Mutex);
+  m_Indexes = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, free_index);
+  m_Misses = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+}
+
+/*! \fn CIconResolver::~CIconResolver()
+    \brief CIconResolver destructor
+*/
+CIconResolver::~CIconResolver()
+{
+  g_hash_table_destroy(m_Indexes);
+  g_hash_table_destroy(m_Misses);
+  g_mutex_clear(&m_Mutex);
+}
+
+/*! \fn GHashTable* CIconResolver::m_BuildIndex(gint size)
+    \brief To read all searching paths and build the index for one icon size.
+
+    \param[in] size. The width(height) of the icon. The "SizexSize" directories of this size rank first,
+                    the ones of the closest other sizes after all other searching paths.
+    \return The new index.
+*/
+GHashTable* CIconResolver::m_BuildIndex(gint size)
+{
+  GHashTable *index = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, free_index_entry);
+  const gchar **dirs = (const gchar**)g_get_system_data_dirs();   /* To read the environment variable which is specified in freedesktop.org Base Directory. */
+  gchar *hicolorSize = g_strdup_printf("%s/%dx%d/apps", ICON_SEARCH_PATH_HICOLOR, size, size);
+  gchar *gnomeSize = g_strdup_printf("%s/%dx%d/apps", ICON_SEARCH_PATH_GNOME, size, size);
+  guint base = 0;
+
+  for(const gchar **dir = dirs; *dir; ++dir, base += N_RANKS_PER_DIR)
+  {
+     scan_directory(index, *dir, ICON_SEARCH_PATH_PIXMAPS, base, RANK_PIXMAPS_PNG, 0, TRUE);
+     scan_directory(index, *dir, hicolorSize, base, RANK_HICOLOR_SIZE, 0, FALSE);
+     scan_directory(index, *dir, ICON_SEARCH_PATH_HICOLOR_SCALABLE, base, RANK_HICOLOR_SCALABLE, 0, FALSE);
+     scan_directory(index, *dir, ICON_SEARCH_PATH_GNOME_SCALABLE, base, RANK_GNOME_SCALABLE, 0, FALSE);
+     scan_directory(index, *dir, ICON_SEARCH_PATH_GNOME_SCALABLE_APPS, base, RANK_GNOME_SCALABLE_APPS, 0, FALSE);
+     scan_directory(index, *dir, gnomeSize, base, RANK_GNOME_SIZE, 0, FALSE);
+  }
+
+  /* A second pass, its ranks start after the searching paths of the last data directory. */
+  for(const gchar **dir = dirs; *dir; ++dir, base += N_OTHER_SIZE_RANKS_PER_DIR)
+  {
+     scan_other_size_directories(index, *dir, ICON_SEARCH_PATH_HICOLOR, base, RANK_HICOLOR_OTHER_SIZE, size);
+     scan_other_size_directories(index, *dir, ICON_SEARCH_PATH_GNOME, base, RANK_GNOME_OTHER_SIZE, size);
+  }
+
+  g_free(hicolorSize);
+  g_free(gnomeSize);
+
+  return index;
+}
+
+/*! \fn GHashTable* CIconResolver::m_GetIndex(gint size)
+    \brief To get the index of an icon size, building it at the first time. The caller holds m_Mutex.
+
+    \param[in] size.
+    \return The index.
+*/
+GHashTable* CIconResolver::m_GetIndex(gint size)
+{
+  GHashTable *index = (GHashTable*)g_hash_table_lookup(m_Indexes, GINT_TO_POINTER(size));
+
+  if(!index)
+  {
+     index = m_BuildIndex(size);
+     g_hash_table_insert(m_Indexes, GINT_TO_POINTER(size), index);
+  }
+
+  return index;
+}
+
+/*! \fn gchar* CIconResolver::m_Resolve(const gchar *file_name, gint size)
+    \brief To find the full name of an icon file.
+
+    A name with an image file extension matches files of that name, a name without it also matches
+    "pixmaps" files with the ".png", ".xpm" or ".svg" extension.
+
+    \param[in] file_name. The icon file's basename, with or without the extension.
+    \param[in] size. The width(height) of the icon.
+    \return Newly allocated full name, or NULL if there has no such file or it is a remembered miss.
+*/
+gchar* CIconResolver::m_Resolve(const gchar *file_name, gint size)
+{
+  GHashTable *index = NULL;
+  ICON_INDEX_ENTRY *entry = NULL, *stemEntry = NULL;
+  gchar *key = NULL, *path = NULL;
+
+  if( G_UNLIKELY(!file_name) )
+    return NULL;
+
+  key = g_strdup_printf("%d\n%s", size, file_name);
+
+  g_mutex_lock(&m_Mutex);
+
+  if( !g_hash_table_lookup(m_Misses, key) )
+  {
+     index = m_GetIndex(size);
+     entry = (ICON_INDEX_ENTRY*)g_hash_table_lookup(index, file_name);
+
+     if( !has_image_extension(file_name) )
+     {
+        gchar *stemKey = g_strconcat(STEM_KEY_PREFIX, file_name, NULL);
+
+        stemEntry = (ICON_INDEX_ENTRY*)g_hash_table_lookup(index, stemKey);
+
+        if( stemEntry && (!entry || stemEntry->rank < entry->rank) )
+          entry = stemEntry;
+
+        g_free(stemKey);
+     }
+
+     if(entry)
+       path = g_strdup(entry->path);
+     else
+     {
+        /* The table takes over the key. */
+        g_hash_table_insert(m_Misses, key, GINT_TO_POINTER(1));
+        key = NULL;
+     }
+  }
+
+  g_mutex_unlock(&m_Mutex);
+
+  g_free(key);
+
+  return path;
+}
+
+/*! \fn void CIconResolver::m_AddMiss(const gchar *file_name, gint size)
+    \brief To remember that the file resolved for a name can not be loaded.
+
+    \param[in] file_name.
+    \param[in] size.
+*/
+void CIconResolver::m_AddMiss(const gchar *file_name, gint size)
+{
+  g_mutex_lock(&m_Mutex);
+  g_hash_table_replace(m_Misses, g_strdup_printf("%d\n%s", size, file_name), GINT_TO_POINTER(1));
+  g_mutex_unlock(&m_Mutex);
+}
+
+/*! \fn void CIconResolver::m_Clear(void)
+    \brief To forget the indexes and the misses, e.g. because icons were installed. The searching paths are read
+           again by the next query.
+
+    \param[in] NONE
+    \return NONE
+*/
+void CIconResolver::m_Clear(void)
+{
+  g_mutex_lock(&m_Mutex);
+  g_hash_table_remove_all(m_Indexes);
+  g_hash_table_remove_all(m_Misses);
+  g_mutex_unlock(&m_Mutex);
+}
+
+/*! \fn void CIconResolver::m_GetStats(guint &nNames, guint &nMisses)
+    \brief To get the occupancy of the indexes.
+
+    \param[out] nNames. The names indexed for all sizes.
+    \param[out] nMisses. The names remembered as not loadable.
+*/
+void CIconResolver::m_GetStats(guint &nNames, guint &nMisses)
+{
+  GHashTableIter iter;
+  gpointer value = NULL;
+
+  nNames = 0;
+
+  g_mutex_lock(&m_Mutex);
+
+  g_hash_table_iter_init(&iter, m_Indexes);
+
+  while( g_hash_table_iter_next(&iter, NULL, &value) )
+     nNames += g_hash_table_size( (GHashTable*)value );
+
+  nMisses = g_hash_table_size(m_Misses);
+
+  g_mutex_unlock(&m_Mutex);
+}
@@ -0,0 +1,57 @@
+/*! \file    CIconResolver.h
+    \brief   Resolve icon file names in the alternative icon searching paths through a prebuilt index.
+
+    \date    2026-10-17
+    \version 1.0
+
+    \b Change_History:
+    \n 1) 2026-10-17 initialized.
+*/
+
+#ifndef __CICONRESOLVER_H
+#define __CICONRESOLVER_H
+
+#include <glib.h>
+
+/* The alternative icons searching path. */
+#define ICON_SEARCH_PATH_PIXMAPS  "pixmaps"
+#define ICON_SEARCH_PATH_HICOLOR  "icons/hicolor"
+#define ICON_SEARCH_PATH_HICOLOR_SCALABLE  "icons/hicolor/scalable/apps"
+//
+#define ICON_SEARCH_PATH_GNOME                "icons/gnome"
+#define ICON_SEARCH_PATH_GNOME_SCALABLE       "icons/gnome/scalable"
+#define ICON_SEARCH_PATH_GNOME_SCALABLE_APPS  "icons/gnome/scalable/apps"
+
+/* Extension names of images. */
+#define EXT_NAME_PNG  ".png"
+#define EXT_NAME_XPM  ".xpm"
+#define EXT_NAME_SVG  ".svg"
+
+/*! \class CIconResolver
+    \brief Map icon file names to full names found in "pixmaps", "icons/hicolor" and "icons/gnome" directories.
+
+    The first query for a size reads these directories under every g_get_system_data_dirs() entry once
+    and builds a hash index from the file basename to its full name, ranked in the same order the
+    directories used to be probed. Afterwards, resolving a name is a hash lookup and costs no system call.
+    Names whose file fails to load are remembered as misses, until m_Clear(). All methods are thread safe.
+*/
+class CIconResolver
+{
+  private:
+    GMutex m_Mutex;           /*!< Protects the tables below. */
+    GHashTable *m_Indexes;    /*!< Size -> index(GHashTable of basename -> ICON_INDEX_ENTRY). */
+    GHashTable *m_Misses;     /*!< "size\nname" keys of names that have no loadable file. */
+
+    GHashTable* m_GetIndex(gint size);
+    GHashTable* m_BuildIndex(gint size);
+
+  public:
+    CIconResolver();
+    ~CIconResolver();
+
+    gchar* m_Resolve(const gchar *file_name, gint size);
+    void m_AddMiss(const gchar *file_name, gint size);
+    void m_Clear(void);
+    void m_GetStats(guint &nNames, guint &nMisses);
+};
+#endif /* __CICONRESOLVER_H */
@@ -0,0 +1,620 @@
+/*! \file CIconScaler.cpp
+    \brief Box filter downscaling of decoded icons with SSE2/AVX2 kernels.
+
+    \date 2026-10-17
+    \version 1.0
+
+    \b Change_History:
+    \n (1) 2026-10-17 initial version.
+*/
+
+#include <string.h>
+#include <math.h>
+
+#include "CIconScaler.h"
+
+/* The SIMD kernels are compiled with target attributes and chosen at run time,
+   so the build needs no extra compiler flag and the program runs on any x86 CPU. */
+#if defined(__GNUC__) && ( defined(__x86_64__) || defined(__i386__) )
+#define ICON_SCALER_X86  1
+#include <immintrin.h>
+#endif
+
+/*! \def ICON_SCALER_ONE
+    \brief The fixed point 1.0 of the filter weights, the weights of a destination pixel add up to it.
+*/
+#define ICON_SCALER_ONE  65535
+
+/*! \struct SCALE_WEIGHTS
+    \brief The box filter of one direction: destination pixel i averages "count[i]" source pixels
+           from "first[i]" on, weighted by weights[i * max_taps + k].
+*/
+typedef struct {
+  gint *first;
+  gint *count;
+  guint16 *weights;
+  gint max_taps;
+} SCALE_WEIGHTS;
+
+/*! \struct SCALER_PASSES
+    \brief The kernels of the three passes working on 16 bits premultiplied RGBA.
+*/
+typedef struct {
+  void (*premultiply)(const guchar *src, guint16 *dst, gint width, gint n_channels);
+  void (*filter_rows)(guint16 *const *rows, const guint16 *weights, gint count, guint16 *dst, gint n);
+  void (*filter_columns)(const guint16 *row, const SCALE_WEIGHTS *wx, gint width, guint16 *dst);
+} SCALER_PASSES;
+
+/*! \fn static void make_weights(SCALE_WEIGHTS *w, gint src_len, gint dst_len)
+    \brief To compute the box filter from src_len pixels down to dst_len pixels.
+
+    Destination pixel i covers the source span [i * src_len / dst_len, (i + 1) * src_len / dst_len), every
+    source pixel is weighted by the part of it inside the span. The spans are measured in 1 / dst_len of a
+    source pixel, so the overlaps are exact integers and their sum is src_len. The rounding remainder of the
+    fixed point weights goes to the biggest one.
+
+    \param[out] w. Free it with free_weights().
+    \param[in] src_len.
+    \param[in] dst_len. Not bigger than src_len.
+*/
+static void make_weights(SCALE_WEIGHTS *w, gint src_len, gint dst_len)
+{
+  w->max_taps = (src_len + dst_len - 1) / dst_len + 1;
+  w->first = g_new(gint, dst_len);
+  w->count = g_new(gint, dst_len);
+  w->weights = g_new0(guint16, dst_len * w->max_taps);
+
+  for(gint i = 0; i < dst_len; i++)
+  {
+     gint64 lo = (gint64)i * src_len, hi = (gint64)(i + 1) * src_len;
+     gint first = (gint)(lo / dst_len), last = (gint)((hi - 1) / dst_len);
+     guint16 *weights = w->weights + i * w->max_taps;
+     guint sum = 0;
+     gint biggest = 0;
+
+     w->first[i] = first;
+     w->count[i] = last - first + 1;
+
+     for(gint k = 0; k < w->count[i]; k++)
+     {
+        gint64 overlap = MIN(hi, (gint64)(first + k + 1) * dst_len) - MAX(lo, (gint64)(first + k) * dst_len);
+
+        weights[k] = (guint16)(overlap * ICON_SCALER_ONE / src_len);
+        sum += weights[k];
+
+        if( weights[k] > weights[biggest] )
+          biggest = k;
+     }
+
+     weights[biggest] += ICON_SCALER_ONE - sum;
+  }
+}
+
+/*! \fn static void free_weights(SCALE_WEIGHTS *w)
+    \brief To free the arrays of a box filter.
+
+    \param[in] w.
+*/
+static void free_weights(SCALE_WEIGHTS *w)
+{
+  g_free(w->first);
+  g_free(w->count);
+  g_free(w->weights);
+}
+
+//------------------------ Scalar Kernels
+/*! \fn static void premultiply_row_scalar(const guchar *src, guint16 *dst, gint width, gint n_channels)
+    \brief To convert a RGB(A) row to 16 bits premultiplied RGBA: the colors times the alpha, the alpha times 255.
+
+    \param[in] src.
+    \param[out] dst. 4 * width values.
+    \param[in] width.
+    \param[in] n_channels. 3 or 4.
+*/
+static void premultiply_row_scalar(const guchar *src, guint16 *dst, gint width, gint n_channels)
+{
+  for(gint x = 0; x < width; x++, src += n_channels, dst += 4)
+  {
+     guint alpha = (n_channels == 4) ? src[3] : 255;
+
+     dst[0] = src[0] * alpha;
+     dst[1] = src[1] * alpha;
+     dst[2] = src[2] * alpha;
+     dst[3] = 255 * alpha;
+  }
+}
+
+/*! \fn static void filter_rows_scalar(guint16 *const *rows, const guint16 *weights, gint count, guint16 *dst, gint n)
+    \brief The vertical pass: to add up premultiplied rows times their weights.
+
+    Every product keeps its high 16 bits, like _mm_mulhi_epu16(). As the weights add up to less than 1.0,
+    the sum never overflows 16 bits.
+
+    \param[in] rows. "count" rows.
+    \param[in] weights. The weight of each row.
+    \param[in] count.
+    \param[out] dst.
+    \param[in] n. The number of values of a row.
+*/
+static void filter_rows_scalar(guint16 *const *rows, const guint16 *weights, gint count, guint16 *dst, gint n)
+{
+  for(gint i = 0; i < n; i++)
+  {
+     guint sum = 0;
+
+     for(gint k = 0; k < count; k++)
+       sum += (rows[k][i] * (guint)weights[k]) >> 16;
+
+     dst[i] = (guint16)sum;
+  }
+}
+
+/*! \fn static void filter_columns_scalar(const guint16 *row, const SCALE_WEIGHTS *wx, gint width, guint16 *dst)
+    \brief The horizontal pass: to average the premultiplied pixels of a filtered row.
+
+    \param[in] row.
+    \param[in] wx. The horizontal box filter.
+    \param[in] width. The destination width.
+    \param[out] dst. 4 * width values.
+*/
+static void filter_columns_scalar(const guint16 *row, const SCALE_WEIGHTS *wx, gint width, guint16 *dst)
+{
+  for(gint x = 0; x < width; x++, dst += 4)
+  {
+     const guint16 *src = row + 4 * wx->first[x];
+     const guint16 *weights = wx->weights + x * wx->max_taps;
+     guint sum[4] = { 0, 0, 0, 0 };
+
+     for(gint k = 0; k < wx->count[x]; k++, src += 4)
+     {
+        for(gint c = 0; c < 4; c++)
+          sum[c] += (src[c] * (guint)weights[k]) >> 16;
+     }
+
+     for(gint c = 0; c < 4; c++)
+       dst[c] = (guint16)sum[c];
+  }
+}
+
+//------------------------ SIMD Kernels
+#ifdef ICON_SCALER_X86
+/*! \fn static void premultiply_row_sse2(const guchar *src, guint16 *dst, gint width, gint n_channels)
+    \brief premultiply_row_scalar() for 4 RGBA pixels at a time.
+*/
+__attribute__((target("sse2")))
+static void premultiply_row_sse2(const guchar *src, guint16 *dst, gint width, gint n_channels)
+{
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i alphaLanes = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+  const __m128i c255 = _mm_set1_epi16(255);
+  gint x = 0;
+
+  if(n_channels != 4)
+  {
+     premultiply_row_scalar(src, dst, width, n_channels);
+     return;
+  }
+
+  for(; x + 4 <= width; x += 4)
+  {
+     __m128i pixels = _mm_loadu_si128( (const __m128i*)(src + 4 * x) );
+
+     for(gint half = 0; half < 2; half++)
+     {
+        __m128i values = half ? _mm_unpackhi_epi8(pixels, zero) : _mm_unpacklo_epi8(pixels, zero);
+        __m128i alpha = _mm_shufflehi_epi16( _mm_shufflelo_epi16(values, 0xFF), 0xFF );
+
+        /* r g b a -> r g b 255, times a a a a. */
+        values = _mm_or_si128( _mm_andnot_si128(alphaLanes, values), _mm_and_si128(alphaLanes, c255) );
+        _mm_storeu_si128( (__m128i*)(dst + 4 * x + 8 * half), _mm_mullo_epi16(values, alpha) );
+     }
+  }
+
+  premultiply_row_scalar(src + 4 * x, dst + 4 * x, width - x, n_channels);
+}
+
+/*! \fn static void filter_rows_sse2(guint16 *const *rows, const guint16 *weights, gint count, guint16 *dst, gint n)
+    \brief filter_rows_scalar() for 8 values at a time.
+*/
+__attribute__((target("sse2")))
+static void filter_rows_sse2(guint16 *const *rows, const guint16 *weights, gint count, guint16 *dst, gint n)
+{
+  gint i = 0;
+
+  for(; i + 8 <= n; i += 8)
+  {
+     __m128i sum = _mm_setzero_si128();
+
+     for(gint k = 0; k < count; k++)
+       sum = _mm_add_epi16( sum, _mm_mulhi_epu16( _mm_loadu_si128( (const __m128i*)(rows[k] + i) ),
+                                                  _mm_set1_epi16( (short)weights[k] ) ) );
+
+     _mm_storeu_si128( (__m128i*)(dst + i), sum );
+  }
+
+  for(; i < n; i++)
+  {
+     guint sum = 0;
+
+     for(gint k = 0; k < count; k++)
+       sum += (rows[k][i] * (guint)weights[k]) >> 16;
+
+     dst[i] = (guint16)sum;
+  }
+}
+
+/*! \fn static void filter_columns_sse2(const guint16 *row, const SCALE_WEIGHTS *wx, gint width, guint16 *dst)
+    \brief filter_columns_scalar() for the 4 channels of a pixel at a time.
+*/
+__attribute__((target("sse2")))
+static void filter_columns_sse2(const guint16 *row, const SCALE_WEIGHTS *wx, gint width, guint16 *dst)
+{
+  for(gint x = 0; x < width; x++)
+  {
+     const guint16 *src = row + 4 * wx->first[x];
+     const guint16 *weights = wx->weights + x * wx->max_taps;
+     __m128i sum = _mm_setzero_si128();
+
+     for(gint k = 0; k < wx->count[x]; k++)
+       sum = _mm_add_epi16( sum, _mm_mulhi_epu16( _mm_loadl_epi64( (const __m128i*)(src + 4 * k) ),
+                                                  _mm_set1_epi16( (short)weights[k] ) ) );
+
+     _mm_storel_epi64( (__m128i*)(dst + 4 * x), sum );
+  }
+}
+
+/*! \fn static void premultiply_row_avx2(const guchar *src, guint16 *dst, gint width, gint n_channels)
+    \brief premultiply_row_scalar() for 4 RGBA pixels widened to 16 values at a time.
+*/
+__attribute__((target("avx2")))
+static void premultiply_row_avx2(const guchar *src, guint16 *dst, gint width, gint n_channels)
+{
+  const __m256i alphaLanes = _mm256_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0);
+  const __m256i c255 = _mm256_set1_epi16(255);
+  gint x = 0;
+
+  if(n_channels != 4)
+  {
+     premultiply_row_scalar(src, dst, width, n_channels);
+     return;
+  }
+
+  for(; x + 4 <= width; x += 4)
+  {
+     __m256i values = _mm256_cvtepu8_epi16( _mm_loadu_si128( (const __m128i*)(src + 4 * x) ) );
+     __m256i alpha = _mm256_shufflehi_epi16( _mm256_shufflelo_epi16(values, 0xFF), 0xFF );
+
+     values = _mm256_or_si256( _mm256_andnot_si256(alphaLanes, values), _mm256_and_si256(alphaLanes, c255) );
+     _mm256_storeu_si256( (__m256i*)(dst + 4 * x), _mm256_mullo_epi16(values, alpha) );
+  }
+
+  premultiply_row_scalar(src + 4 * x, dst + 4 * x, width - x, n_channels);
+}
+
+/*! \fn static void filter_rows_avx2(guint16 *const *rows, const guint16 *weights, gint count, guint16 *dst, gint n)
+    \brief filter_rows_scalar() for 16 values at a time.
+*/
+__attribute__((target("avx2")))
+static void filter_rows_avx2(guint16 *const *rows, const guint16 *weights, gint count, guint16 *dst, gint n)
+{
+  gint i = 0;
+
+  for(; i + 16 <= n; i += 16)
+  {
+     __m256i sum = _mm256_setzero_si256();
+
+     for(gint k = 0; k < count; k++)
+       sum = _mm256_add_epi16( sum, _mm256_mulhi_epu16( _mm256_loadu_si256( (const __m256i*)(rows[k] + i) ),
+                                                        _mm256_set1_epi16( (short)weights[k] ) ) );
+
+     _mm256_storeu_si256( (__m256i*)(dst + i), sum );
+  }
+
+  for(; i < n; i++)
+  {
+     guint sum = 0;
+
+     for(gint k = 0; k < count; k++)
+       sum += (rows[k][i] * (guint)weights[k]) >> 16;
+
+     dst[i] = (guint16)sum;
+  }
+}
+
+/*! \fn static void filter_columns_avx2(const guint16 *row, const SCALE_WEIGHTS *wx, gint width, guint16 *dst)
+    \brief filter_columns_scalar() for 2 destination pixels at a time.
+*/
+__attribute__((target("avx2")))
+static void filter_columns_avx2(const guint16 *row, const SCALE_WEIGHTS *wx, gint width, guint16 *dst)
+{
+  gint x = 0;
+
+  /* The two pixels may have different tap counts, the missing taps of the shorter one weigh 0. */
+  for(; x + 2 <= width; x += 2)
+  {
+     const guint16 *src0 = row + 4 * wx->first[x], *src1 = row + 4 * wx->first[x + 1];
+     const guint16 *weights0 = wx->weights + x * wx->max_taps, *weights1 = weights0 + wx->max_taps;
+     gint count = MAX(wx->count[x], wx->count[x + 1]);
+     __m128i sum = _mm_setzero_si128();
+
+     for(gint k = 0; k < count; k++)
+     {
+        gint k0 = MIN(k, wx->count[x] - 1), k1 = MIN(k, wx->count[x + 1] - 1);
+        __m128i pixels = _mm_unpacklo_epi64( _mm_loadl_epi64( (const __m128i*)(src0 + 4 * k0) ),
+                                             _mm_loadl_epi64( (const __m128i*)(src1 + 4 * k1) ) );
+        __m128i weights = _mm_unpacklo_epi64( _mm_set1_epi16( (short)(k < wx->count[x] ? weights0[k] : 0) ),
+                                              _mm_set1_epi16( (short)(k < wx->count[x + 1] ? weights1[k] : 0) ) );
+
+        sum = _mm_add_epi16( sum, _mm_mulhi_epu16(pixels, weights) );
+     }
+
+     _mm_storeu_si128( (__m128i*)(dst + 4 * x), sum );
+  }
+
+  for(; x < width; x++)
+  {
+     const guint16 *src = row + 4 * wx->first[x];
+     const guint16 *weights = wx->weights + x * wx->max_taps;
+     __m128i sum = _mm_setzero_si128();
+
+     for(gint k = 0; k < wx->count[x]; k++)
+       sum = _mm_add_epi16( sum, _mm_mulhi_epu16( _mm_loadl_epi64( (const __m128i*)(src + 4 * k) ),
+                                                  _mm_set1_epi16( (short)weights[k] ) ) );
+
+     _mm_storel_epi64( (__m128i*)(dst + 4 * x), sum );
+  }
+}
+#endif /* ICON_SCALER_X86 */
+
+/*! \fn static void unpremultiply_row(const guint16 *src, guchar *dst, gint width, gint n_channels)
+    \brief To divide the filtered colors by their alpha back to 8 bits RGB(A). It is shared by every kernel.
+
+    \param[in] src. 4 * width values.
+    \param[out] dst.
+    \param[in] width.
+    \param[in] n_channels. 3 or 4.
+*/
+static void unpremultiply_row(const guint16 *src, guchar *dst, gint width, gint n_channels)
+{
+  for(gint x = 0; x < width; x++, src += 4, dst += n_channels)
+  {
+     guint alpha = src[3];
+
+     if(n_channels == 3)
+     {
+        for(gint c = 0; c < 3; c++)
+          dst[c] = (guchar)((src[c] + 127) / 255);
+     }
+     else if(alpha == 0)
+       dst[0] = dst[1] = dst[2] = dst[3] = 0;
+     else
+     {
+        for(gint c = 0; c < 3; c++)
+          dst[c] = (guchar)MIN(255, (src[c] * 255 + alpha / 2) / alpha);
+
+        dst[3] = (guchar)((alpha + 127) / 255);
+     }
+  }
+}
+
+/*! \fn static void get_passes(ICON_SCALER_KERNEL kernel, SCALER_PASSES *passes)
+    \brief To get the pass functions of a supported kernel.
+
+    \param[in] kernel. Not ICON_SCALER_AUTO.
+    \param[out] passes.
+*/
+static void get_passes(ICON_SCALER_KERNEL kernel, SCALER_PASSES *passes)
+{
+  passes->premultiply = premultiply_row_scalar;
+  passes->filter_rows = filter_rows_scalar;
+  passes->filter_columns = filter_columns_scalar;
+
+#ifdef ICON_SCALER_X86
+  if(kernel == ICON_SCALER_SSE2)
+  {
+     passes->premultiply = premultiply_row_sse2;
+     passes->filter_rows = filter_rows_sse2;
+     passes->filter_columns = filter_columns_sse2;
+  }
+  else if(kernel == ICON_SCALER_AVX2)
+  {
+     passes->premultiply = premultiply_row_avx2;
+     passes->filter_rows = filter_rows_avx2;
+     passes->filter_columns = filter_columns_avx2;
+  }
+#else
+  kernel = kernel;
+#endif
+}
+
+//--------------- Class Methos Implementation.
+/*! \fn GdkPixbuf* CIconScaler::m_ScaleDown(const GdkPixbuf *src, gint width, gint height, ICON_SCALER_KERNEL kernel)
+    \brief To scale a pixel buffer down to width x height, or to copy it at its own size.
+
+    \param[in] src. 8 bits RGB or RGBA.
+    \param[in] width. Not bigger than the width of src.
+    \param[in] height. Not bigger than the height of src.
+    \param[in] kernel. An unsupported kernel falls back to the best supported one.
+    \return A new pixel buffer with the alpha channel of src, or NULL if src is not in a supported format
+            or a dimension would grow, the caller then uses gdk_pixbuf_scale_simple().
+*/
+GdkPixbuf* CIconScaler::m_ScaleDown(const GdkPixbuf *src, gint width, gint height, ICON_SCALER_KERNEL kernel)
+{
+  SCALE_WEIGHTS wx, wy;
+  SCALER_PASSES passes;
+  GdkPixbuf *dst = NULL;
+  guint16 *ring = NULL, *filtered = NULL, *columns = NULL;
+  guint16 **rows = NULL;
+  gint *ringRows = NULL;
+  gint srcWidth = 0, srcHeight = 0, nChannels = 0, srcStride = 0, dstStride = 0;
+  const guchar *srcPixels = NULL;
+  guchar *dstPixels = NULL;
+
+  if( !src || gdk_pixbuf_get_colorspace(src) != GDK_COLORSPACE_RGB || gdk_pixbuf_get_bits_per_sample(src) != 8 )
+    return NULL;
+
+  srcWidth = gdk_pixbuf_get_width(src);
+  srcHeight = gdk_pixbuf_get_height(src);
+  nChannels = gdk_pixbuf_get_n_channels(src);
+
+  if( nChannels != (gdk_pixbuf_get_has_alpha(src) ? 4 : 3) ||
+      width < 1 || height < 1 || width > srcWidth || height > srcHeight )
+    return NULL;
+
+  dst = gdk_pixbuf_new(GDK_COLORSPACE_RGB, gdk_pixbuf_get_has_alpha(src), 8, width, height);
+
+  if( !dst )
+    return NULL;
+
+  if( kernel == ICON_SCALER_AUTO || !m_IsKernelSupported(kernel) )
+    kernel = m_IsKernelSupported(ICON_SCALER_AVX2) ? ICON_SCALER_AVX2 :
+             m_IsKernelSupported(ICON_SCALER_SSE2) ? ICON_SCALER_SSE2 : ICON_SCALER_SCALAR;
+
+  get_passes(kernel, &passes);
+  make_weights(&wx, srcWidth, width);
+  make_weights(&wy, srcHeight, height);
+
+  srcPixels = gdk_pixbuf_get_pixels(src);
+  srcStride = gdk_pixbuf_get_rowstride(src);
+  dstPixels = gdk_pixbuf_get_pixels(dst);
+  dstStride = gdk_pixbuf_get_rowstride(dst);
+
+  /* The spans of consecutive destination rows never go back, so a ring of max_taps premultiplied rows
+     holds every source row of the current span and each source row is premultiplied once. */
+  ring = g_new(guint16, (gsize)wy.max_taps * 4 * srcWidth);
+  ringRows = g_new(gint, wy.max_taps);
+  rows = g_new(guint16*, wy.max_taps);
+  filtered = g_new(guint16, 4 * srcWidth);
+  columns = g_new(guint16, 4 * width);
+
+  for(gint i = 0; i < wy.max_taps; i++)
+    ringRows[i] = -1;
+
+  for(gint y = 0; y < height; y++)
+  {
+     for(gint k = 0; k < wy.count[y]; k++)
+     {
+        gint row = wy.first[y] + k, slot = row % wy.max_taps;
+
+        rows[k] = ring + (gsize)slot * 4 * srcWidth;
+
+        if(ringRows[slot] != row)
+        {
+           passes.premultiply(srcPixels + (gsize)row * srcStride, rows[k], srcWidth, nChannels);
+           ringRows[slot] = row;
+        }
+     }
+
+     passes.filter_rows(rows, wy.weights + y * wy.max_taps, wy.count[y], filtered, 4 * srcWidth);
+     passes.filter_columns(filtered, &wx, width, columns);
+     unpremultiply_row(columns, dstPixels + (gsize)y * dstStride, width, nChannels);
+  }
+
+  g_free(ring);
+  g_free(ringRows);
+  g_free(rows);
+  g_free(filtered);
+  g_free(columns);
+  free_weights(&wx);
+  free_weights(&wy);
+
+  return dst;
+}
+
+/*! \fn gboolean CIconScaler::m_IsKernelSupported(ICON_SCALER_KERNEL kernel)
+    \brief To check if a kernel is built in and the CPU runs it.
+
+    \param[in] kernel.
+    \return TRUE or FALSE
+*/
+gboolean CIconScaler::m_IsKernelSupported(ICON_SCALER_KERNEL kernel)
+{
+  switch(kernel)
+  {
+     case ICON_SCALER_AUTO:
+     case ICON_SCALER_SCALAR:
+       return true;
+
+#ifdef ICON_SCALER_X86
+     case ICON_SCALER_SSE2:
+       __builtin_cpu_init();
+       return __builtin_cpu_supports("sse2");
+
+     case ICON_SCALER_AVX2:
+       __builtin_cpu_init();
+       return __builtin_cpu_supports("avx2");
+#endif
+
+     default:
+       return false;
+  }
+}
+
+/*! \fn const gchar* CIconScaler::m_GetKernelName(ICON_SCALER_KERNEL kernel)
+    \brief To get the name of a kernel.
+
+    \param[in] kernel.
+    \return A static string.
+*/
+const gchar* CIconScaler::m_GetKernelName(ICON_SCALER_KERNEL kernel)
+{
+  switch(kernel)
+  {
+     case ICON_SCALER_SCALAR:
+       return "scalar";
+     case ICON_SCALER_SSE2:
+       return "sse2";
+     case ICON_SCALER_AVX2:
+       return "avx2";
+     default:
+       return "auto";
+  }
+}
+
+/*! \fn gdouble CIconScaler::m_ComputePSNR(const GdkPixbuf *a, const GdkPixbuf *b)
+    \brief To compare two pixel buffers of the same size by their peak signal-to-noise ratio.
+
+    The colors are compared premultiplied, as they are drawn over the background, so the color of
+    a (nearly) transparent pixel hardly counts. The alpha is compared too.
+
+    \param[in] a.
+    \param[in] b.
+    \return The PSNR in dB, 100 if they are identical, -1 if their sizes or formats differ.
+*/
+gdouble CIconScaler::m_ComputePSNR(const GdkPixbuf *a, const GdkPixbuf *b)
+{
+  gint width = gdk_pixbuf_get_width(a), height = gdk_pixbuf_get_height(a);
+  gint nChannels = gdk_pixbuf_get_n_channels(a);
+  gboolean bAlpha = gdk_pixbuf_get_has_alpha(a);
+  gdouble sum = 0.0;
+
+  if( width != gdk_pixbuf_get_width(b) || height != gdk_pixbuf_get_height(b) ||
+      nChannels != gdk_pixbuf_get_n_channels(b) || bAlpha != gdk_pixbuf_get_has_alpha(b) ||
+      gdk_pixbuf_get_bits_per_sample(a) != 8 || gdk_pixbuf_get_bits_per_sample(b) != 8 || nChannels < 3 )
+    return -1.0;
+
+  for(gint y = 0; y < height; y++)
+  {
+     const guchar *pa = gdk_pixbuf_get_pixels(a) + (gsize)y * gdk_pixbuf_get_rowstride(a);
+     const guchar *pb = gdk_pixbuf_get_pixels(b) + (gsize)y * gdk_pixbuf_get_rowstride(b);
+
+     for(gint x = 0; x < width; x++, pa += nChannels, pb += nChannels)
+     {
+        gdouble alphaA = bAlpha ? pa[3] / 255.0 : 1.0, alphaB = bAlpha ? pb[3] / 255.0 : 1.0;
+
+        for(gint c = 0; c < 3; c++)
+        {
+           gdouble diff = pa[c] * alphaA - pb[c] * alphaB;
+           sum += diff * diff;
+        }
+
+        if(bAlpha)
+          sum += (gdouble)(pa[3] - pb[3]) * (pa[3] - pb[3]);
+     }
+  }
+
+  if(sum == 0.0)
+    return 100.0;
+
+  return 10.0 * log10( 255.0 * 255.0 / (sum / ((gdouble)width * height * (bAlpha ? 4 : 3))) );
+}
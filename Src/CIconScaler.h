@@ -0,0 +1,45 @@
+/*! \file    CIconScaler.h
+    \brief   Box filter downscaling of decoded icons with SSE2/AVX2 kernels.
+
+    \date    2026-10-17
+    \version 1.0
+
+    \b Change_History:
+    \n 1) 2026-10-17 initialized.
+*/
+
+#ifndef __CICONSCALER_H
+#define __CICONSCALER_H
+
+#include <glib.h>
+#include <gdk-pixbuf/gdk-pixbuf.h>
+
+/*! \enum ICON_SCALER_KERNEL
+    \brief The implementations of the scaling passes. They give bit-identical results.
+*/
+typedef enum
+{
+  ICON_SCALER_AUTO = 0,  /*!< The fastest kernel the CPU supports. */
+  ICON_SCALER_SCALAR,
+  ICON_SCALER_SSE2,
+  ICON_SCALER_AVX2
+} ICON_SCALER_KERNEL;
+
+/*! \class CIconScaler
+    \brief Scale 8 bits RGB(A) pixel buffers down with an area averaging(box) filter in premultiplied alpha.
+
+    Every destination pixel is the average of the source area it covers, which is what GDK_INTERP_BILINEAR
+    does when it scales down, without its generic tile and filter setup. The rows are premultiplied into
+    16 bits per channel, filtered vertically then horizontally with 16 bits fixed point weights, and divided
+    back by the alpha. Only the few source rows under the current destination row are kept.
+    The methods hold no state, so they may run in the worker threads of the icon pipeline.
+*/
+class CIconScaler
+{
+  public:
+    static GdkPixbuf* m_ScaleDown(const GdkPixbuf *src, gint width, gint height, ICON_SCALER_KERNEL kernel = ICON_SCALER_AUTO);
+    static gboolean m_IsKernelSupported(ICON_SCALER_KERNEL kernel);
+    static const gchar* m_GetKernelName(ICON_SCALER_KERNEL kernel);
+    static gdouble m_ComputePSNR(const GdkPixbuf *a, const GdkPixbuf *b);
+};
+#endif /* __CICONSCALER_H */
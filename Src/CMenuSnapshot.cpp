@@ -0,0 +1,784 @@
+/*! \file CMenuSnapshot.cpp
+    \brief Persistent binary snapshot of the parsed applications menu.
+
+    \date 2026-10-17
+    \version 1.0
+
+    \b Change_History:
+    \n (1) 2026-10-17 initial version.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <dirent.h>
+
+#include "CMenuSnapshot.h"
+
+/*! \def MENU_SNAPSHOT_MAX_DEPTH
+    \brief The deepest sub-directory level checked below a menu directory. It also stops symbolic link loops.
+*/
+#define MENU_SNAPSHOT_MAX_DEPTH  8
+
+/*! \struct MENU_SNAPSHOT_DIR_STATE
+    \brief The current state of a directory, compared with a MENU_SNAPSHOT_DIR record.
+*/
+typedef struct {
+  gchar *path;
+  gint64 mtime;
+  gint64 newest;
+  guint32 n_files;
+} MENU_SNAPSHOT_DIR_STATE;
+
+//------------------------ Static Functions
+/*! \fn static gint compare_names(gconstpointer a, gconstpointer b)
+    \brief The GCompareFunc sorting a GPtrArray of strings.
+*/
+static gint compare_names(gconstpointer a, gconstpointer b)
+{
+  return strcmp( *(const gchar**)a, *(const gchar**)b );
+}
+
+/*! \fn static void add_dir_state(GArray *dirs, const gchar *path, gint depth)
+    \brief To add the state of a directory and, recursively, of its sub-directories in name order.
+
+    \param[out] dirs. MENU_SNAPSHOT_DIR_STATE objects.
+    \param[in] path.
+    \param[in] depth. The sub-directory level of the path.
+*/
+static void add_dir_state(GArray *dirs, const gchar *path, gint depth)
+{
+  MENU_SNAPSHOT_DIR_STATE state;
+  GPtrArray *subDirs = NULL;
+  struct stat st;
+  struct dirent *ent = NULL;
+  DIR *dir = NULL;
+  guint index = dirs->len;
+
+  state.path = g_strdup(path);
+  state.mtime = -1;
+  state.newest = -1;
+  state.n_files = 0;
+
+  /* A missing directory is recorded as well, creating it makes the snapshot stale. */
+  if( stat(path, &st) != 0 || !S_ISDIR(st.st_mode) )
+  {
+     g_array_append_val(dirs, state);
+     return;
+  }
+
+  /* A directory's modification time changes when a name is added, removed or renamed in it. */
+  state.mtime = (gint64)st.st_mtim.tv_sec * G_GINT64_CONSTANT(1000000000) + st.st_mtim.tv_nsec;
+  g_array_append_val(dirs, state);
+
+  dir = opendir(path);
+
+  if( !dir )
+    return;
+
+  subDirs = g_ptr_array_new_with_free_func(g_free);
+
+  while( (ent = readdir(dir)) != NULL )
+  {
+     MENU_SNAPSHOT_DIR_STATE *current = &g_array_index(dirs, MENU_SNAPSHOT_DIR_STATE, index);
+
+     if( strcmp(ent->d_name, ".") == 0 || strcmp(ent->d_name, "..") == 0 )
+       continue;
+
+     current->n_files++;
+
+     /* A file rewritten in place changes its own modification time, not the directory's. Links are followed. */
+     if( fstatat(dirfd(dir), ent->d_name, &st, 0) != 0 )
+       continue;
+
+     current->newest = MAX( current->newest, (gint64)st.st_mtim.tv_sec * G_GINT64_CONSTANT(1000000000) + st.st_mtim.tv_nsec );
+
+     if( depth < MENU_SNAPSHOT_MAX_DEPTH && S_ISDIR(st.st_mode) )
+       g_ptr_array_add( subDirs, g_build_filename(path, ent->d_name, NULL) );
+  }
+
+  closedir(dir);
+
+  /* readdir() has no defined order, the records must come out the same for an unchanged tree. */
+  g_ptr_array_sort(subDirs, compare_names);
+
+  for(guint i = 0; i < subDirs->len; i++)
+     add_dir_state(dirs, (const gchar*)g_ptr_array_index(subDirs, i), depth + 1);
+
+  g_ptr_array_free(subDirs, TRUE);
+}
+
+/*! \fn static void add_base_dir_states(GArray *dirs, const gchar *base, const gchar *const *subDirs)
+    \brief To add the states of the menu relevant sub-directories of an XDG base directory.
+
+    \param[out] dirs.
+    \param[in] base. e.g. "/usr/share".
+    \param[in] subDirs. NULL terminated, e.g. { "applications", NULL }.
+*/
+static void add_base_dir_states(GArray *dirs, const gchar *base, const gchar *const *subDirs)
+{
+  for(; *subDirs; subDirs++)
+  {
+     gchar *path = g_build_filename(base, *subDirs, NULL);
+
+     add_dir_state(dirs, path, 0);
+     g_free(path);
+  }
+}
+
+/*! \fn static GArray* collect_menu_dir_states(void)
+    \brief To get the states of all directories GNOME Menus reads: the ".menu" files, the desktop entries and
+           the directory entries, under $XDG_CONFIG_HOME, $XDG_CONFIG_DIRS, $XDG_DATA_HOME and $XDG_DATA_DIRS.
+
+    \return Newly allocated GArray of MENU_SNAPSHOT_DIR_STATE, released by free_menu_dir_states().
+*/
+static GArray* collect_menu_dir_states(void)
+{
+  static const gchar *const dataSubDirs[] = { "applications", "desktop-directories", NULL };
+  static const gchar *const configSubDirs[] = { "menus", NULL };
+  GArray *dirs = g_array_new(FALSE, FALSE, sizeof(MENU_SNAPSHOT_DIR_STATE));
+  const gchar *const *base = NULL;
+
+  add_base_dir_states(dirs, g_get_user_config_dir(), configSubDirs);
+
+  for(base = g_get_system_config_dirs(); *base; base++)
+     add_base_dir_states(dirs, *base, configSubDirs);
+
+  add_base_dir_states(dirs, g_get_user_data_dir(), dataSubDirs);
+
+  for(base = g_get_system_data_dirs(); *base; base++)
+     add_base_dir_states(dirs, *base, dataSubDirs);
+
+  return dirs;
+}
+
+/*! \fn static void free_menu_dir_states(GArray *dirs)
+    \brief To release the result of collect_menu_dir_states().
+
+    \param[in] dirs. It could be NULL.
+*/
+static void free_menu_dir_states(GArray *dirs)
+{
+  if(!dirs)
+    return;
+
+  for(guint i = 0; i < dirs->len; i++)
+     g_free( g_array_index(dirs, MENU_SNAPSHOT_DIR_STATE, i).path );
+
+  g_array_free(dirs, TRUE);
+}
+
+/*! \fn static gboolean table_fits(guint32 offset, guint32 count, gsize record_size, gsize align, gsize length)
+    \brief To check if a table of a snapshot file lies inside the file and is aligned for its records.
+           The file is mapped at a page boundary, so an aligned offset is an aligned address.
+*/
+static gboolean table_fits(guint32 offset, guint32 count, gsize record_size, gsize align, gsize length)
+{
+  return (offset % align == 0) && (guint64)offset + (guint64)count * record_size <= length;
+}
+
+/*! \fn static guint32 align_offset(guint32 offset, gsize align)
+    \brief To round a table offset of a snapshot file up to the alignment of its records.
+*/
+static guint32 align_offset(guint32 offset, gsize align)
+{
+  return (guint32)( (offset + align - 1) / align * align );
+}
+
+//--------------- Class Methos Implementation.
+/*! \fn CMenuSnapshot::CMenuSnapshot()
+    \brief CMenuSnapshot constructor
+*/
+CMenuSnapshot::CMenuSnapshot()
+{
+  m_pszFileName = NULL;
+  m_pszIconContext = NULL;
+  m_nIconSize = 0;
+  m_nShowIconSize = 0;
+  m_Mapped = NULL;
+  m_pHeader = NULL;
+  m_bIconFilesValid = false;
+  m_CurrentDirs = NULL;
+  m_NewCategories = NULL;
+  m_NewEntries = NULL;
+  m_NewItems = NULL;
+  m_NewStrings = NULL;
+  m_NewStringOffsets = NULL;
+}
+
+/*! \fn CMenuSnapshot::~CMenuSnapshot()
+    \brief CMenuSnapshot destructor
+*/
+CMenuSnapshot::~CMenuSnapshot()
+{
+  m_Release();
+
+  if(m_NewCategories)
+  {
+     g_array_free(m_NewCategories, TRUE);
+     g_array_free(m_NewEntries, TRUE);
+     g_array_free(m_NewItems, TRUE);
+     g_string_free(m_NewStrings, TRUE);
+     g_hash_table_destroy(m_NewStringOffsets);
+  }
+
+  free_menu_dir_states(m_CurrentDirs);
+
+  g_free(m_pszFileName);
+  g_free(m_pszIconContext);
+}
+
+/*! \fn gboolean CMenuSnapshot::m_Init(const gchar *menu_name, const gchar *icon_context, gint icon_size, gint show_icon_size)
+    \brief To choose the snapshot file of a menu and create its directory if it does not exist yet.
+
+    The menu name, $XDG_MENU_PREFIX and the language pick the file, so each of them has its own snapshot.
+
+    \param[in] menu_name. e.g. "applications.menu".
+    \param[in] icon_context. The icon theme name the icon files are looked up in. It could be NULL.
+    \param[in] icon_size. The size the icon files are looked up for.
+    \param[in] show_icon_size. The size the shown icon files are looked up for.
+    \return TRUE or FALSE. On FALSE snapshots are disabled and m_Load() always fails.
+*/
+gboolean CMenuSnapshot::m_Init(const gchar *menu_name, const gchar *icon_context, gint icon_size, gint show_icon_size)
+{
+  gchar *dir = NULL, *key = NULL, *digest = NULL;
+
+  g_free(m_pszIconContext);
+  m_pszIconContext = g_strdup( icon_context ? icon_context : "" );
+  m_nIconSize = icon_size;
+  m_nShowIconSize = show_icon_size;
+
+  g_free(m_pszFileName);
+  m_pszFileName = NULL;
+
+  /* g_get_user_cache_dir() honours $XDG_CACHE_HOME. */
+  dir = g_build_filename( g_get_user_cache_dir(), MENU_SNAPSHOT_DIR_NAME, NULL );
+
+  if( g_mkdir_with_parents(dir, 0700) != 0 )
+  {
+     g_free(dir);
+     return false;
+  }
+
+  key = g_strdup_printf( "%s\n%s\n%s", menu_name, g_getenv("XDG_MENU_PREFIX") ? g_getenv("XDG_MENU_PREFIX") : "",
+                         g_get_language_names()[0] );
+  digest = g_compute_checksum_for_string( G_CHECKSUM_MD5, key, -1 );
+  m_pszFileName = g_build_filename( dir, digest, NULL );
+
+  g_free(digest);
+  g_free(key);
+  g_free(dir);
+
+  return true;
+}
+
+/*! \fn gboolean CMenuSnapshot::m_Load(void)
+    \brief To map the snapshot file if it is still fresh.
+
+    The states of the menu directories are taken before anything else, so if the snapshot is stale they are
+    the ones m_Commit() records: a change made while the menu is being parsed makes the new snapshot stale.
+
+    \param[in] NONE
+    \return TRUE if a fresh snapshot is mapped, otherwise FALSE and the menu has to be parsed.
+*/
+gboolean CMenuSnapshot::m_Load(void)
+{
+  GMappedFile *mapped = NULL;
+
+  m_Release();
+
+  if( !m_pszFileName )
+    return false;
+
+  free_menu_dir_states(m_CurrentDirs);
+  m_CurrentDirs = collect_menu_dir_states();
+
+  mapped = g_mapped_file_new( m_pszFileName, FALSE, NULL );
+
+  if( !mapped )
+    return false;
+
+  if( !m_Validate( g_mapped_file_get_contents(mapped), g_mapped_file_get_length(mapped) ) )
+  {
+     g_mapped_file_unref(mapped);
+     return false;
+  }
+
+  m_Mapped = mapped;
+  m_pHeader = (const MENU_SNAPSHOT_HEADER*)g_mapped_file_get_contents(mapped);
+
+  /* Not needed for writing any more. */
+  free_menu_dir_states(m_CurrentDirs);
+  m_CurrentDirs = NULL;
+
+  return true;
+}
+
+/*! \fn gboolean CMenuSnapshot::m_Validate(const gchar *contents, gsize length)
+    \brief To check the format of a mapped snapshot file and compare its directories with the current ones.
+
+    \param[in] contents.
+    \param[in] length.
+    \return TRUE if the snapshot can be used.
+*/
+gboolean CMenuSnapshot::m_Validate(const gchar *contents, gsize length)
+{
+  const MENU_SNAPSHOT_HEADER *header = (const MENU_SNAPSHOT_HEADER*)contents;
+  const MENU_SNAPSHOT_CATEGORY *categories = NULL;
+  const MENU_SNAPSHOT_ENTRY *entries = NULL;
+  const guint32 *items = NULL;
+  const gchar *strings = NULL;
+  GArray *enclosing = NULL;
+  gboolean bValid = true;
+
+  if( length < sizeof(MENU_SNAPSHOT_HEADER) ||
+      header->magic != MENU_SNAPSHOT_MAGIC || header->version != MENU_SNAPSHOT_VERSION ||
+      header->length != length ||
+      !table_fits(header->dirs_offset, header->n_dirs, sizeof(MENU_SNAPSHOT_DIR), sizeof(gint64), length) ||
+      !table_fits(header->categories_offset, header->n_categories, sizeof(MENU_SNAPSHOT_CATEGORY), sizeof(guint32), length) ||
+      !table_fits(header->entries_offset, header->n_entries, sizeof(MENU_SNAPSHOT_ENTRY), sizeof(guint32), length) ||
+      !table_fits(header->items_offset, header->n_items, sizeof(guint32), sizeof(guint32), length) ||
+      header->strings_length == 0 || (guint64)header->strings_offset + header->strings_length > length )
+    return false;
+
+  /* Any offset into a string table ending with a NUL is a terminated string. */
+  strings = contents + header->strings_offset;
+
+  if( strings[header->strings_length - 1] != '\0' || header->icon_context >= header->strings_length )
+    return false;
+
+  /* The cheap part first: any added, removed, renamed or rewritten file makes it stale. */
+  if( !m_MatchDirStates(contents, m_CurrentDirs) )
+    return false;
+
+  categories = (const MENU_SNAPSHOT_CATEGORY*)(contents + header->categories_offset);
+  enclosing = g_array_new(FALSE, FALSE, sizeof(guint32));
+
+  for(guint i = 0; i < header->n_categories && bValid; i++)
+  {
+     guint32 parent = MENU_SNAPSHOT_NO_PARENT;
+
+     if( categories[i].name >= header->strings_length || categories[i].icon >= header->strings_length ||
+         categories[i].icon_file >= header->strings_length || categories[i].show_file >= header->strings_length ||
+         (guint64)categories[i].first_entry + categories[i].n_entries > header->n_entries ||
+         (guint64)categories[i].first_item + categories[i].n_items > header->n_items ||
+         categories[i].end <= i || categories[i].end > header->n_categories )
+     {
+        bValid = false;
+        break;
+     }
+
+     /* The directories still open in pre-order: the parent must be the innermost one, and enclose this one. */
+     while( enclosing->len > 0 && categories[g_array_index(enclosing, guint32, enclosing->len - 1)].end <= i )
+       g_array_set_size(enclosing, enclosing->len - 1);
+
+     if(enclosing->len > 0)
+       parent = g_array_index(enclosing, guint32, enclosing->len - 1);
+
+     if( categories[i].parent != parent ||
+         (parent != MENU_SNAPSHOT_NO_PARENT && categories[i].end > categories[parent].end) )
+       bValid = false;
+
+     g_array_append_val(enclosing, i);
+  }
+
+  g_array_free(enclosing, TRUE);
+
+  /* An item is one of the directory's own entries or one of its direct sub-directories. */
+  items = (const guint32*)(contents + header->items_offset);
+
+  for(guint i = 0; i < header->n_categories && bValid; i++)
+  {
+     for(guint n = 0; n < categories[i].n_items && bValid; n++)
+     {
+        guint32 item = items[categories[i].first_item + n];
+        guint32 index = item & ~MENU_SNAPSHOT_ITEM_DIRECTORY;
+
+        if(item & MENU_SNAPSHOT_ITEM_DIRECTORY)
+          bValid = ( index < header->n_categories && categories[index].parent == i );
+        else
+          bValid = ( index >= categories[i].first_entry && index - categories[i].first_entry < categories[i].n_entries );
+     }
+  }
+
+  if(!bValid)
+    return false;
+
+  entries = (const MENU_SNAPSHOT_ENTRY*)(contents + header->entries_offset);
+
+  for(guint i = 0; i < header->n_entries; i++)
+  {
+     if( entries[i].name >= header->strings_length || entries[i].icon >= header->strings_length ||
+         entries[i].icon_file >= header->strings_length || entries[i].show_file >= header->strings_length ||
+         entries[i].exec >= header->strings_length ||
+         entries[i].comment >= header->strings_length || entries[i].desktopfile >= header->strings_length )
+       return false;
+  }
+
+  /* The icon files are only hints, a different icon theme does not make the menu stale. */
+  m_bIconFilesValid = ( header->icon_size == m_nIconSize && header->show_icon_size == m_nShowIconSize &&
+                        strcmp(strings + header->icon_context, m_pszIconContext) == 0 );
+
+  return true;
+}
+
+/*! \fn gboolean CMenuSnapshot::m_MatchDirStates(const gchar *contents, GArray *states)
+    \brief To compare the directories of a snapshot file with their current states.
+
+    \param[in] contents. The snapshot file, its header and string table are checked already.
+    \param[in] states. The MENU_SNAPSHOT_DIR_STATE objects of collect_menu_dir_states(). It could be NULL.
+    \return TRUE if no directory changed.
+*/
+gboolean CMenuSnapshot::m_MatchDirStates(const gchar *contents, GArray *states)
+{
+  const MENU_SNAPSHOT_HEADER *header = (const MENU_SNAPSHOT_HEADER*)contents;
+  const MENU_SNAPSHOT_DIR *dirs = (const MENU_SNAPSHOT_DIR*)(contents + header->dirs_offset);
+  const gchar *strings = contents + header->strings_offset;
+
+  if( !states || header->n_dirs != states->len )
+    return false;
+
+  for(guint i = 0; i < header->n_dirs; i++)
+  {
+     MENU_SNAPSHOT_DIR_STATE *state = &g_array_index(states, MENU_SNAPSHOT_DIR_STATE, i);
+
+     if( dirs[i].mtime != state->mtime || dirs[i].newest != state->newest || dirs[i].n_files != state->n_files ||
+         dirs[i].path >= header->strings_length || strcmp(strings + dirs[i].path, state->path) != 0 )
+       return false;
+  }
+
+  return true;
+}
+
+/*! \fn gboolean CMenuSnapshot::m_IsStale(void)
+    \brief To check again if the menu directories changed since the loaded snapshot was written, e.g. while the
+           menu was parsed after the snapshot was loaded. It only reads the mapped file, so it can run in another
+           thread while the snapshot is being read.
+
+    \param[in] NONE
+    \return TRUE if a directory changed, FALSE if it did not or no snapshot is loaded.
+*/
+gboolean CMenuSnapshot::m_IsStale(void)
+{
+  GArray *states = NULL;
+  gboolean bStale = false;
+
+  if(!m_pHeader)
+    return false;
+
+  states = collect_menu_dir_states();
+  bStale = !m_MatchDirStates( (const gchar*)m_pHeader, states );
+  free_menu_dir_states(states);
+
+  return bStale;
+}
+
+/*! \fn void CMenuSnapshot::m_Release(void)
+    \brief To unmap the snapshot. The strings got from it are invalid afterwards.
+
+    \param[in] NONE
+    \return NONE
+*/
+void CMenuSnapshot::m_Release(void)
+{
+  if(m_Mapped)
+    g_mapped_file_unref(m_Mapped);
+
+  m_Mapped = NULL;
+  m_pHeader = NULL;
+  m_bIconFilesValid = false;
+}
+
+/*! \fn const MENU_SNAPSHOT_CATEGORY* CMenuSnapshot::m_GetCategory(guint index)
+    \brief To get a directory of the mapped snapshot.
+
+    \param[in] index. 0 to m_GetCategoryCount() - 1.
+    \return The record in the mapped file, or NULL.
+*/
+const MENU_SNAPSHOT_CATEGORY* CMenuSnapshot::m_GetCategory(guint index)
+{
+  if( !m_pHeader || index >= m_pHeader->n_categories )
+    return NULL;
+
+  return (const MENU_SNAPSHOT_CATEGORY*)( (const gchar*)m_pHeader + m_pHeader->categories_offset ) + index;
+}
+
+/*! \fn guint CMenuSnapshot::m_GetCategoryIndex(const MENU_SNAPSHOT_CATEGORY *category)
+    \brief To get the index of a directory got from m_GetCategory().
+
+    \param[in] category.
+    \return The index.
+*/
+guint CMenuSnapshot::m_GetCategoryIndex(const MENU_SNAPSHOT_CATEGORY *category)
+{
+  return (guint)( category - m_GetCategory(0) );
+}
+
+/*! \fn const MENU_SNAPSHOT_ENTRY* CMenuSnapshot::m_GetEntry(guint index)
+    \brief To get an application of the mapped snapshot.
+
+    \param[in] index. An index in the entry range of a category.
+    \return The record in the mapped file, or NULL.
+*/
+const MENU_SNAPSHOT_ENTRY* CMenuSnapshot::m_GetEntry(guint index)
+{
+  if( !m_pHeader || index >= m_pHeader->n_entries )
+    return NULL;
+
+  return (const MENU_SNAPSHOT_ENTRY*)( (const gchar*)m_pHeader + m_pHeader->entries_offset ) + index;
+}
+
+/*! \fn guint32 CMenuSnapshot::m_GetItem(guint index)
+    \brief To get an item of the mapped snapshot: an entry index, or a directory index with MENU_SNAPSHOT_ITEM_DIRECTORY set.
+
+    \param[in] index. An index in the item range of a category.
+    \return The item, or MENU_SNAPSHOT_ITEM_DIRECTORY | MENU_SNAPSHOT_NO_PARENT.
+*/
+guint32 CMenuSnapshot::m_GetItem(guint index)
+{
+  if( !m_pHeader || index >= m_pHeader->n_items )
+    return MENU_SNAPSHOT_ITEM_DIRECTORY | MENU_SNAPSHOT_NO_PARENT;
+
+  return ( (const guint32*)( (const gchar*)m_pHeader + m_pHeader->items_offset ) )[index];
+}
+
+/*! \fn const gchar* CMenuSnapshot::m_GetString(guint32 offset)
+    \brief To get a string of the mapped snapshot. It is not copied.
+
+    \param[in] offset. A string member of a record.
+    \return The string in the mapped file, or NULL.
+*/
+const gchar* CMenuSnapshot::m_GetString(guint32 offset)
+{
+  if( !m_pHeader || offset == 0 )
+    return NULL;
+
+  return (const gchar*)m_pHeader + m_pHeader->strings_offset + offset;
+}
+
+/*! \fn void CMenuSnapshot::m_BeginWrite(void)
+    \brief To start a new snapshot. The directories and their entries are added in pre-order, the menu order of each
+           directory is set by m_SetCategoryItems(), then m_Commit() writes it.
+
+    \param[in] NONE
+    \return NONE
+*/
+void CMenuSnapshot::m_BeginWrite(void)
+{
+  if(!m_NewCategories)
+  {
+     m_NewCategories = g_array_new(FALSE, FALSE, sizeof(MENU_SNAPSHOT_CATEGORY));
+     m_NewEntries = g_array_new(FALSE, FALSE, sizeof(MENU_SNAPSHOT_ENTRY));
+     m_NewItems = g_array_new(FALSE, FALSE, sizeof(guint32));
+     m_NewStrings = g_string_sized_new(4096);
+     m_NewStringOffsets = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+  }
+
+  g_array_set_size(m_NewCategories, 0);
+  g_array_set_size(m_NewEntries, 0);
+  g_array_set_size(m_NewItems, 0);
+  g_hash_table_remove_all(m_NewStringOffsets);
+
+  /* Offset 0 is NULL. */
+  g_string_truncate(m_NewStrings, 0);
+  g_string_append_c(m_NewStrings, '\0');
+}
+
+/*! \fn guint32 CMenuSnapshot::m_AddString(const gchar *str)
+    \brief To add a string to the string table of the new snapshot. Equal strings are stored once.
+
+    \param[in] str. It could be NULL.
+    \return The offset of the string.
+*/
+guint32 CMenuSnapshot::m_AddString(const gchar *str)
+{
+  gpointer offset = NULL;
+  guint32 nOffset = 0;
+
+  if(!str)
+    return 0;
+
+  if( g_hash_table_lookup_extended(m_NewStringOffsets, str, NULL, &offset) )
+    return GPOINTER_TO_UINT(offset);
+
+  nOffset = m_NewStrings->len;
+  g_string_append_len(m_NewStrings, str, strlen(str) + 1);
+  g_hash_table_insert(m_NewStringOffsets, g_strdup(str), GUINT_TO_POINTER(nOffset));
+
+  return nOffset;
+}
+
+/*! \fn guint32 CMenuSnapshot::m_AddCategory(const gchar *name, const gchar *icon, const gchar *icon_file, const gchar *show_file, guint32 parent)
+    \brief To add a directory to the new snapshot. The entries added next belong to it, so a directory's own
+           entries are added before its sub-directories.
+
+    \param[in] name.
+    \param[in] icon. The icon name.
+    \param[in] icon_file. The image file of the icon in the icon theme, or NULL.
+    \param[in] show_file. The full name of the icon file at the shown size, or NULL.
+    \param[in] parent. The index of the parent directory, which must be the last added one or one of its parents.
+    \return The index of the directory.
+*/
+guint32 CMenuSnapshot::m_AddCategory(const gchar *name, const gchar *icon, const gchar *icon_file, const gchar *show_file,
+                                     guint32 parent)
+{
+  MENU_SNAPSHOT_CATEGORY category;
+  guint32 index = m_NewCategories->len;
+
+  category.name = m_AddString(name);
+  category.icon = m_AddString(icon);
+  category.icon_file = m_AddString(icon_file);
+  category.show_file = m_AddString(show_file);
+  category.first_entry = m_NewEntries->len;
+  category.n_entries = 0;
+  category.first_item = 0;
+  category.n_items = 0;
+  category.parent = parent;
+  category.end = index + 1;
+
+  g_array_append_val(m_NewCategories, category);
+
+  /* The directories above enclose it now. */
+  while( parent != MENU_SNAPSHOT_NO_PARENT && parent < index )
+  {
+     MENU_SNAPSHOT_CATEGORY *above = &g_array_index(m_NewCategories, MENU_SNAPSHOT_CATEGORY, parent);
+
+     above->end = index + 1;
+     parent = above->parent;
+  }
+
+  return index;
+}
+
+/*! \fn guint32 CMenuSnapshot::m_AddEntry(const gchar *name, const gchar *icon, const gchar *icon_file, const gchar *show_file,
+                                          const gchar *exec, const gchar *comment, const gchar *desktopfile)
+    \brief To add an application of the last added directory to the new snapshot.
+
+    \param[in] name.
+    \param[in] icon. The icon name.
+    \param[in] icon_file. The image file of the icon in the icon theme, or NULL.
+    \param[in] show_file. The full name of the icon file at the shown size, or NULL.
+    \param[in] exec.
+    \param[in] comment.
+    \param[in] desktopfile.
+    \return The index of the entry, or MENU_SNAPSHOT_NO_PARENT if no directory is added yet.
+*/
+guint32 CMenuSnapshot::m_AddEntry(const gchar *name, const gchar *icon, const gchar *icon_file, const gchar *show_file,
+                                  const gchar *exec, const gchar *comment, const gchar *desktopfile)
+{
+  MENU_SNAPSHOT_ENTRY entry;
+
+  if( G_UNLIKELY(m_NewCategories->len == 0) )
+    return MENU_SNAPSHOT_NO_PARENT;
+
+  entry.name = m_AddString(name);
+  entry.icon = m_AddString(icon);
+  entry.icon_file = m_AddString(icon_file);
+  entry.show_file = m_AddString(show_file);
+  entry.exec = m_AddString(exec);
+  entry.comment = m_AddString(comment);
+  entry.desktopfile = m_AddString(desktopfile);
+
+  g_array_append_val(m_NewEntries, entry);
+  g_array_index(m_NewCategories, MENU_SNAPSHOT_CATEGORY, m_NewCategories->len - 1).n_entries++;
+
+  return m_NewEntries->len - 1;
+}
+
+/*! \fn void CMenuSnapshot::m_SetCategoryItems(guint32 index, const GArray *items)
+    \brief To set the applications and direct sub-directories of a directory of the new snapshot in menu order.
+
+    \param[in] index. The index of the directory, returned by m_AddCategory().
+    \param[in] items. The items(guint32): the entry indices returned by m_AddEntry() and the directory indices
+                returned by m_AddCategory() with MENU_SNAPSHOT_ITEM_DIRECTORY set.
+*/
+void CMenuSnapshot::m_SetCategoryItems(guint32 index, const GArray *items)
+{
+  MENU_SNAPSHOT_CATEGORY *category = NULL;
+
+  if( G_UNLIKELY(index >= m_NewCategories->len) )
+    return;
+
+  category = &g_array_index(m_NewCategories, MENU_SNAPSHOT_CATEGORY, index);
+  category->first_item = m_NewItems->len;
+  category->n_items = items->len;
+
+  g_array_append_vals(m_NewItems, items->data, items->len);
+}
+
+/*! \fn gboolean CMenuSnapshot::m_Commit(void)
+    \brief To write the new snapshot with the directory states taken by m_Load().
+
+    \param[in] NONE
+    \return TRUE or FALSE
+*/
+gboolean CMenuSnapshot::m_Commit(void)
+{
+  MENU_SNAPSHOT_HEADER header;
+  GArray *dirs = NULL;
+  gchar *buffer = NULL;
+  gboolean bRet = FALSE;
+
+  if( !m_pszFileName || !m_NewCategories || !m_CurrentDirs )
+    return false;
+
+  /* The directory paths and the icon theme name go into the string table as well. */
+  dirs = g_array_sized_new(FALSE, FALSE, sizeof(MENU_SNAPSHOT_DIR), m_CurrentDirs->len);
+
+  for(guint i = 0; i < m_CurrentDirs->len; i++)
+  {
+     MENU_SNAPSHOT_DIR_STATE *state = &g_array_index(m_CurrentDirs, MENU_SNAPSHOT_DIR_STATE, i);
+     MENU_SNAPSHOT_DIR dir;
+
+     dir.mtime = state->mtime;
+     dir.newest = state->newest;
+     dir.path = m_AddString(state->path);
+     dir.n_files = state->n_files;
+     g_array_append_val(dirs, dir);
+  }
+
+  memset(&header, 0, sizeof(MENU_SNAPSHOT_HEADER));
+  header.magic = MENU_SNAPSHOT_MAGIC;
+  header.version = MENU_SNAPSHOT_VERSION;
+  header.icon_size = m_nIconSize;
+  header.show_icon_size = m_nShowIconSize;
+  header.icon_context = m_AddString(m_pszIconContext);
+  header.n_dirs = dirs->len;
+  /* The directories have 64-bit fields, the other tables only 32-bit ones. */
+  header.dirs_offset = align_offset(sizeof(MENU_SNAPSHOT_HEADER), sizeof(gint64));
+  header.n_categories = m_NewCategories->len;
+  header.categories_offset = header.dirs_offset + header.n_dirs * sizeof(MENU_SNAPSHOT_DIR);
+  header.n_entries = m_NewEntries->len;
+  header.entries_offset = header.categories_offset + header.n_categories * sizeof(MENU_SNAPSHOT_CATEGORY);
+  header.n_items = m_NewItems->len;
+  header.items_offset = header.entries_offset + header.n_entries * sizeof(MENU_SNAPSHOT_ENTRY);
+  header.strings_offset = header.items_offset + header.n_items * sizeof(guint32);
+  header.strings_length = m_NewStrings->len;
+  header.length = header.strings_offset + header.strings_length;
+
+  /* The padding is written as zeros. */
+  buffer = (gchar*)g_malloc0(header.length);
+
+  memcpy(buffer, &header, sizeof(MENU_SNAPSHOT_HEADER));
+  memcpy(buffer + header.dirs_offset, dirs->data, header.n_dirs * sizeof(MENU_SNAPSHOT_DIR));
+  memcpy(buffer + header.categories_offset, m_NewCategories->data, header.n_categories * sizeof(MENU_SNAPSHOT_CATEGORY));
+  memcpy(buffer + header.entries_offset, m_NewEntries->data, header.n_entries * sizeof(MENU_SNAPSHOT_ENTRY));
+  memcpy(buffer + header.items_offset, m_NewItems->data, header.n_items * sizeof(guint32));
+  memcpy(buffer + header.strings_offset, m_NewStrings->str, header.strings_length);
+
+  /* g_file_set_contents() writes a temporary file and renames it, so a reader never maps a partial snapshot. */
+  bRet = g_file_set_contents(m_pszFileName, buffer, header.length, NULL);
+
+  g_free(buffer);
+  g_array_free(dirs, TRUE);
+
+  /* The states are only valid for the menu parsed after they were taken. */
+  free_menu_dir_states(m_CurrentDirs);
+  m_CurrentDirs = NULL;
+  m_BeginWrite();
+
+  return bRet;
+}
@@ -0,0 +1,161 @@
+/*! \file    CMenuSnapshot.h
+    \brief   Persistent binary snapshot of the parsed applications menu.
+
+    \date    2026-10-17
+    \version 1.0
+
+    \b Change_History:
+    \n 1) 2026-10-17 initialized.
+*/
+
+#ifndef __CMENUSNAPSHOT_H
+#define __CMENUSNAPSHOT_H
+
+#include <glib.h>
+
+/*! \def MENU_SNAPSHOT_DIR_NAME
+    \brief The sub-directory under $XDG_CACHE_HOME holding the menu snapshots. The version is part of the name, so
+           a format change simply starts a new, empty directory.
+*/
+#define MENU_SNAPSHOT_DIR_NAME  "DesktopAppChooser/menu-v5"
+
+/*! \def MENU_SNAPSHOT_MAGIC
+    \brief The magic number("DACM") at the beginning of a menu snapshot file.
+*/
+#define MENU_SNAPSHOT_MAGIC    0x4D434144
+#define MENU_SNAPSHOT_VERSION  5
+
+/*! \struct MENU_SNAPSHOT_HEADER
+    \brief The header of a menu snapshot file. The tables follow it in this order: directories, categories,
+           entries, items and the string table. Every string is an offset into the string table, 0 stands for NULL.
+*/
+typedef struct {
+  guint32 magic;
+  guint32 version;
+  guint32 length;             /*!< The length of the whole file. */
+  guint32 icon_size;          /*!< The size the icon files were looked up for. */
+  guint32 show_icon_size;     /*!< The size the shown icon files were looked up for. */
+  guint32 icon_context;       /*!< The icon theme name the icon files were looked up in. */
+  guint32 n_dirs;
+  guint32 dirs_offset;
+  guint32 n_categories;
+  guint32 categories_offset;
+  guint32 n_entries;
+  guint32 entries_offset;
+  guint32 n_items;
+  guint32 items_offset;
+  guint32 strings_offset;
+  guint32 strings_length;
+} MENU_SNAPSHOT_HEADER;
+
+/*! \struct MENU_SNAPSHOT_DIR
+    \brief The state of a menu, desktop entry or directory entry directory when the menu was parsed.
+*/
+typedef struct {
+  gint64  mtime;    /*!< The modification time in nanoseconds, -1 if the directory did not exist. */
+  gint64  newest;   /*!< The latest modification time of the names in it in nanoseconds, -1 if it has none. */
+  guint32 path;
+  guint32 n_files;  /*!< The number of names in the directory. */
+} MENU_SNAPSHOT_DIR;
+
+/*! \def MENU_SNAPSHOT_NO_PARENT
+    \brief The parent of a top-level directory.
+*/
+#define MENU_SNAPSHOT_NO_PARENT  G_MAXUINT32
+
+/*! \def MENU_SNAPSHOT_ITEM_DIRECTORY
+    \brief The flag of an item(a guint32 of the item table) which is a directory index, otherwise it is an entry index.
+*/
+#define MENU_SNAPSHOT_ITEM_DIRECTORY  0x80000000
+
+/*! \struct MENU_SNAPSHOT_CATEGORY
+    \brief A directory of the menu. The directories are stored in pre-order, so the sub-directories of
+           directory i, at any depth, are the directories (i, end). Its own applications are the entries
+           [first_entry, first_entry + n_entries). Its applications and direct sub-directories in menu order
+           are the items [first_item, first_item + n_items).
+*/
+typedef struct {
+  guint32 name;
+  guint32 icon;
+  guint32 icon_file;  /*!< The image file of the icon in the icon theme, 0 if it was not found there. */
+  guint32 show_file;  /*!< The full name of the icon file at the shown size, 0 if it was not resolved. */
+  guint32 first_entry;
+  guint32 n_entries;
+  guint32 first_item;
+  guint32 n_items;
+  guint32 parent;     /*!< The index of the parent directory, MENU_SNAPSHOT_NO_PARENT for a top-level one. */
+  guint32 end;        /*!< The index after the last sub-directory. */
+} MENU_SNAPSHOT_CATEGORY;
+
+/*! \struct MENU_SNAPSHOT_ENTRY
+    \brief A shown application of the menu.
+*/
+typedef struct {
+  guint32 name;
+  guint32 icon;
+  guint32 icon_file;  /*!< The image file of the icon in the icon theme, 0 if it was not found there. */
+  guint32 show_file;  /*!< The full name of the icon file at the shown size, 0 if it was not resolved. */
+  guint32 exec;
+  guint32 comment;
+  guint32 desktopfile;
+} MENU_SNAPSHOT_ENTRY;
+
+/*! \class CMenuSnapshot
+    \brief Store the parsed applications menu in $XDG_CACHE_HOME and map it back without parsing any file.
+
+    A snapshot is fresh while every menu, desktop entry and directory entry directory has the modification
+    time, the number of names and the latest modification time of the names it had when the menu was parsed,
+    so a desktop entry rewritten in place makes it stale as well. Its strings are used in place, they stay
+    valid until m_Release().
+*/
+class CMenuSnapshot
+{
+  private:
+    gchar *m_pszFileName;     /*!< The full name of the snapshot file. NULL if snapshots are disabled. */
+    gchar *m_pszIconContext;  /*!< The icon theme name the icon files are looked up in. */
+    guint32 m_nIconSize;
+    guint32 m_nShowIconSize;
+    GMappedFile *m_Mapped;    /*!< The mapped fresh snapshot, NULL if none is loaded. */
+    const MENU_SNAPSHOT_HEADER *m_pHeader;
+    gboolean m_bIconFilesValid;  /*!< To indicate if the icon files were looked up in the current icon theme. */
+    GArray *m_CurrentDirs;    /*!< The states(MENU_SNAPSHOT_DIR_STATE) of the directories before the menu is parsed. */
+
+    /* The snapshot being written. */
+    GArray *m_NewCategories;
+    GArray *m_NewEntries;
+    GArray *m_NewItems;
+    GString *m_NewStrings;
+    GHashTable *m_NewStringOffsets;
+
+    gboolean m_Validate(const gchar *contents, gsize length);
+    gboolean m_MatchDirStates(const gchar *contents, GArray *states);
+    guint32 m_AddString(const gchar *str);
+
+  public:
+    CMenuSnapshot();
+    ~CMenuSnapshot();
+
+    gboolean m_Init(const gchar *menu_name, const gchar *icon_context, gint icon_size, gint show_icon_size);
+    gboolean m_Load(void);
+    void m_Release(void);
+    gboolean m_IsLoaded(void) { return (m_pHeader != NULL); }  /*!< To check if a fresh snapshot is mapped. */
+    gboolean m_IsStale(void);
+    gsize m_GetMappedSize(void) { return m_Mapped ? g_mapped_file_get_length(m_Mapped) : 0; }  /*!< To get the bytes of the mapped snapshot. */
+
+    guint m_GetCategoryCount(void) { return m_pHeader ? m_pHeader->n_categories : 0; }  /*!< To get the number of directories. */
+    const MENU_SNAPSHOT_CATEGORY* m_GetCategory(guint index);
+    guint m_GetCategoryIndex(const MENU_SNAPSHOT_CATEGORY *category);
+    const MENU_SNAPSHOT_ENTRY* m_GetEntry(guint index);
+    guint32 m_GetItem(guint index);
+    const gchar* m_GetString(guint32 offset);
+    gboolean m_HasIconFiles(void) { return m_bIconFilesValid; }  /*!< To check if the icon files were looked up in the current icon theme and sizes. */
+
+    void m_BeginWrite(void);
+    guint32 m_AddCategory(const gchar *name, const gchar *icon, const gchar *icon_file, const gchar *show_file,
+                          guint32 parent = MENU_SNAPSHOT_NO_PARENT);
+    guint32 m_AddEntry(const gchar *name, const gchar *icon, const gchar *icon_file, const gchar *show_file,
+                       const gchar *exec, const gchar *comment, const gchar *desktopfile);
+    void m_SetCategoryItems(guint32 index, const GArray *items);
+    gboolean m_Commit(void);
+};
+#endif /* __CMENUSNAPSHOT_H */
@@ -0,0 +1,228 @@
+/*! \file CStartupProfiler.cpp
+    \brief Monotonic clock spans and counters of the startup phases.
+
+    \date 2026-10-17
+    \version 1.0
+
+    \b Change_History:
+    \n (1) 2026-10-17 initial version.
+*/
+
+#include <string.h>
+#include <unistd.h>
+
+#include "CStartupProfiler.h"
+
+/*! \var static const gchar *counterNames[]
+    \brief The names of the counters, in PROFILE_COUNTER order.
+*/
+static const gchar *counterNames[N_PROFILE_COUNTERS] =
+{
+  "icon decodes",
+  "icon failed opens",
+  "icon cache hits",
+  "icon lookup misses",
+  "rows inserted"
+};
+
+/*! \struct PROFILE_PHASE
+    \brief The summary of all spans of one name.
+*/
+typedef struct {
+  const gchar *name;
+  guint count;
+  gint64 total;
+  gint64 max;
+} PROFILE_PHASE;
+
+//--------------- Class Methos Implementation.
+/*! \fn CStartupProfiler::CStartupProfiler()
+    \brief CStartupProfiler constructor
+*/
+CStartupProfiler::CStartupProfiler()
+{
+  const gchar *value = g_getenv(PROFILE_ENV_NAME);
+
+  m_bEnabled = (value && *value && strcmp(value, "0") != 0);
+  m_pszTraceFile = NULL;
+  m_nOrigin = g_get_monotonic_time();
+  m_Spans = NULL;
+  m_Threads = NULL;
+
+  for(int i = 0; i < N_PROFILE_COUNTERS; i++)
+     m_nCounters[i] = 0;
+
+  g_mutex_init(&m_Mutex);
+
+  if(m_bEnabled)
+  {
+     m_pszTraceFile = g_strdup( strcmp(value, "1") == 0 ? PROFILE_DEFAULT_TRACE_FILE : value );
+     m_Spans = g_array_new(FALSE, FALSE, sizeof(PROFILE_SPAN));
+     m_Threads = g_hash_table_new(g_direct_hash, g_direct_equal);
+  }
+}
+
+/*! \fn CStartupProfiler::~CStartupProfiler()
+    \brief CStartupProfiler destructor
+*/
+CStartupProfiler::~CStartupProfiler()
+{
+  if(m_Spans)
+    g_array_free(m_Spans, TRUE);
+
+  if(m_Threads)
+    g_hash_table_destroy(m_Threads);
+
+  g_free(m_pszTraceFile);
+  g_mutex_clear(&m_Mutex);
+}
+
+/*! \fn void CStartupProfiler::m_End(const gchar *name, gint64 start)
+    \brief To record a span ending now.
+
+    \param[in] name. The phase name. It must be a string literal, it is kept until m_Report().
+    \param[in] start. The value returned by m_Begin().
+*/
+void CStartupProfiler::m_End(const gchar *name, gint64 start)
+{
+  PROFILE_SPAN span;
+  GThread *self = NULL;
+  gint64 now = 0;
+
+  if(!m_bEnabled)
+    return;
+
+  now = g_get_monotonic_time();
+  self = g_thread_self();
+
+  span.name = name;
+  span.start = start - m_nOrigin;
+  span.duration = now - start;
+
+  g_mutex_lock(&m_Mutex);
+
+  span.thread = GPOINTER_TO_UINT( g_hash_table_lookup(m_Threads, self) );
+
+  if(span.thread == 0)
+  {
+     span.thread = g_hash_table_size(m_Threads) + 1;
+     g_hash_table_insert(m_Threads, self, GUINT_TO_POINTER(span.thread));
+  }
+
+  g_array_append_val(m_Spans, span);
+
+  g_mutex_unlock(&m_Mutex);
+}
+
+/*! \fn void CStartupProfiler::m_WriteSummary(FILE *stream)
+    \brief To print the count, total, mean and maximum time of each phase and the counters.
+           The spans of a phase called inside another phase are included in the outer total too.
+
+    \param[in] stream.
+*/
+void CStartupProfiler::m_WriteSummary(FILE *stream)
+{
+  GArray *phases = g_array_new(FALSE, TRUE, sizeof(PROFILE_PHASE));
+  GHashTable *phaseIndex = g_hash_table_new(g_str_hash, g_str_equal);
+
+  /* Phases are listed in the order their first span ended. */
+  for(guint n = 0; n < m_Spans->len; n++)
+  {
+     PROFILE_SPAN *span = &g_array_index(m_Spans, PROFILE_SPAN, n);
+     guint idx = GPOINTER_TO_UINT( g_hash_table_lookup(phaseIndex, span->name) );
+     PROFILE_PHASE *phase = NULL;
+
+     if(idx == 0)
+     {
+        g_array_set_size(phases, phases->len + 1);
+        idx = phases->len;
+        g_hash_table_insert(phaseIndex, (gpointer)span->name, GUINT_TO_POINTER(idx));
+        g_array_index(phases, PROFILE_PHASE, idx - 1).name = span->name;
+     }
+
+     phase = &g_array_index(phases, PROFILE_PHASE, idx - 1);
+     phase->count++;
+     phase->total += span->duration;
+     phase->max = MAX(phase->max, span->duration);
+  }
+
+  fprintf(stream, "\n%-32s %8s %12s %12s %12s\n", "Phase", "Count", "Total(ms)", "Mean(ms)", "Max(ms)");
+
+  for(guint n = 0; n < phases->len; n++)
+  {
+     PROFILE_PHASE *phase = &g_array_index(phases, PROFILE_PHASE, n);
+
+     fprintf(stream, "%-32s %8u %12.3f %12.3f %12.3f\n", phase->name, phase->count,
+             phase->total / 1000.0, phase->total / 1000.0 / phase->count, phase->max / 1000.0);
+  }
+
+  fprintf(stream, "\n%-32s %8s\n", "Counter", "Value");
+
+  for(int i = 0; i < N_PROFILE_COUNTERS; i++)
+     fprintf(stream, "%-32s %8d\n", counterNames[i], g_atomic_int_get(&m_nCounters[i]));
+
+  fprintf(stream, "\n");
+
+  g_hash_table_destroy(phaseIndex);
+  g_array_free(phases, TRUE);
+}
+
+/*! \fn gboolean CStartupProfiler::m_WriteTrace(const gchar *file_name)
+    \brief To write the spans as complete("X") events and the counters as counter("C") events
+           of the Chrome trace-event format.
+
+    \param[in] file_name.
+    \return TRUE or FALSE
+*/
+gboolean CStartupProfiler::m_WriteTrace(const gchar *file_name)
+{
+  FILE *stream = fopen(file_name, "w");
+  gint64 end = g_get_monotonic_time() - m_nOrigin;
+  int pid = (int)getpid();
+
+  if(!stream)
+    return false;
+
+  fprintf(stream, "{\"traceEvents\":[\n");
+
+  for(guint n = 0; n < m_Spans->len; n++)
+  {
+     PROFILE_SPAN *span = &g_array_index(m_Spans, PROFILE_SPAN, n);
+
+     fprintf(stream, "{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%" G_GINT64_FORMAT ",\"dur\":%" G_GINT64_FORMAT ",\"pid\":%d,\"tid\":%u},\n",
+             span->name, span->start, span->duration, pid, span->thread);
+  }
+
+  for(int i = 0; i < N_PROFILE_COUNTERS; i++)
+  {
+     fprintf(stream, "{\"name\":\"%s\",\"ph\":\"C\",\"ts\":%" G_GINT64_FORMAT ",\"pid\":%d,\"args\":{\"value\":%d}}%s\n",
+             counterNames[i], end, pid, g_atomic_int_get(&m_nCounters[i]), (i + 1 < N_PROFILE_COUNTERS)? "," : "");
+  }
+
+  fprintf(stream, "],\"displayTimeUnit\":\"ms\"}\n");
+
+  return (fclose(stream) == 0);
+}
+
+/*! \fn void CStartupProfiler::m_Report(void)
+    \brief To print the summary table to stderr and write the trace-event file.
+
+    \param[in] NONE
+    \return NONE
+*/
+void CStartupProfiler::m_Report(void)
+{
+  if(!m_bEnabled)
+    return;
+
+  g_mutex_lock(&m_Mutex);
+
+  m_WriteSummary(stderr);
+
+  if( m_WriteTrace(m_pszTraceFile) )
+    fprintf(stderr, "Trace written to %s\n", m_pszTraceFile);
+  else
+    fprintf(stderr, "Can not write the trace to %s\n", m_pszTraceFile);
+
+  g_mutex_unlock(&m_Mutex);
+}
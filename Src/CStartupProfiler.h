@@ -0,0 +1,77 @@
+/*! \file    CStartupProfiler.h
+    \brief   Monotonic clock spans and counters of the startup phases.
+
+    \date    2026-10-17
+    \version 1.0
+
+    \b Change_History:
+    \n 1) 2026-10-17 initialized.
+*/
+
+#ifndef __CSTARTUPPROFILER_H
+#define __CSTARTUPPROFILER_H
+
+#include <stdio.h>
+#include <glib.h>
+
+/*! \def PROFILE_ENV_NAME
+    \brief The environment variable enabling the profiler. "1" writes the trace to PROFILE_DEFAULT_TRACE_FILE,
+           any other non-empty value except "0" is the trace file name.
+*/
+#define PROFILE_ENV_NAME            "APPCHOOSER_PROFILE"
+#define PROFILE_DEFAULT_TRACE_FILE  "appchooser-trace.json"
+
+/*! \enum  PROFILE_COUNTER
+    \brief The counted events.
+*/
+enum PROFILE_COUNTER {
+  PROFILE_ICON_DECODES = 0,   /*!< Icons decoded from an image file. */
+  PROFILE_ICON_FAILED_OPENS,  /*!< Image files which could not be loaded. */
+  PROFILE_ICON_CACHE_HITS,    /*!< Icons mapped from the on-disk icon cache. */
+  PROFILE_ICON_LOOKUP_MISSES, /*!< Icon names without any file in the alternative searching paths. */
+  PROFILE_ROWS_INSERTED,      /*!< Rows inserted into the tree store. */
+  N_PROFILE_COUNTERS
+};
+
+/*! \struct PROFILE_SPAN
+    \brief A measured span of a phase.
+*/
+typedef struct {
+  const gchar *name;  /*!< A string literal. */
+  gint64 start;       /*!< In microseconds since the profiler was created. */
+  gint64 duration;    /*!< In microseconds. */
+  guint thread;       /*!< A small number identifying the thread. */
+} PROFILE_SPAN;
+
+/*! \class CStartupProfiler
+    \brief Record where the startup time goes.
+
+    When PROFILE_ENV_NAME is not set, every method returns at once. Otherwise the spans are kept in memory
+    and m_Report() prints a summary table to stderr and writes them as a Chrome trace-event JSON file,
+    which chrome://tracing or Perfetto loads. Spans and counters may be recorded by any thread.
+*/
+class CStartupProfiler
+{
+  private:
+    gboolean m_bEnabled;
+    gchar *m_pszTraceFile;     /*!< The trace-event JSON file name. */
+    gint64 m_nOrigin;          /*!< The monotonic time the profiler was created. */
+    GMutex m_Mutex;            /*!< Protects the tables below. */
+    GArray *m_Spans;           /*!< PROFILE_SPAN objects in the order they ended. */
+    GHashTable *m_Threads;     /*!< GThread -> thread number plus one. */
+    volatile gint m_nCounters[N_PROFILE_COUNTERS];
+
+    void m_WriteSummary(FILE *stream);
+    gboolean m_WriteTrace(const gchar *file_name);
+
+  public:
+    CStartupProfiler();
+    ~CStartupProfiler();
+
+    gboolean m_IsEnabled(void) { return m_bEnabled; }  /*!< To check if the profiler records anything. */
+    gint64 m_Begin(void) { return m_bEnabled ? g_get_monotonic_time() : 0; }  /*!< To get the start time of a span. */
+    void m_End(const gchar *name, gint64 start);
+    void m_Count(PROFILE_COUNTER counter, gint n = 1) { if(m_bEnabled) g_atomic_int_add(&m_nCounters[counter], n); }  /*!< To count events. */
+    void m_Report(void);
+};
+#endif /* __CSTARTUPPROFILER_H */
@@ -0,0 +1,386 @@
+/*! \file CUsageLog.cpp
+    \brief Ring-bounded binary log of the chosen applications and their frecency scores.
+
+    \date 2026-10-17
+    \version 1.0
+
+    \b Change_History:
+    \n (1) 2026-10-17 initial version.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/file.h>
+
+#include "CUsageLog.h"
+
+/*! \def USAGE_LOG_MIN_SCORE
+    \brief The lowest score of an application returned by m_GetTopEntries(), about ten half-lives ago.
+*/
+#define USAGE_LOG_MIN_SCORE  0.001
+
+/*! \struct USAGE_LOG_RANK
+    \brief An application ranked by m_GetTopEntries().
+*/
+typedef struct {
+  const gchar *path;
+  gdouble score;   /*!< The score at the time of the ranking. */
+} USAGE_LOG_RANK;
+
+//------------------------ Callback Functions
+/*! \fn static gboolean cb_sync_usage_log(gpointer data)
+    \brief The timeout callback which flushes the choices made in the last USAGE_LOG_SYNC_DELAY seconds.
+
+    \param[in] data. The CUsageLog.
+    \return FALSE, the timeout is removed.
+*/
+static gboolean cb_sync_usage_log(gpointer data)
+{
+  return ((CUsageLog*)data)->m_SyncDelayed();
+}
+
+/*! \fn static gint cb_compare_ranks(gconstpointer a, gconstpointer b)
+    \brief The sort function of m_GetTopEntries(): the highest score first, then by path.
+
+    \param[in] a. A USAGE_LOG_RANK.
+    \param[in] b. Another USAGE_LOG_RANK.
+    \return Less than, equal to or greater than zero as a sorts before, with or after b.
+*/
+static gint cb_compare_ranks(gconstpointer a, gconstpointer b)
+{
+  const USAGE_LOG_RANK *rankA = (const USAGE_LOG_RANK*)a, *rankB = (const USAGE_LOG_RANK*)b;
+
+  if(rankA->score != rankB->score)
+    return (rankA->score > rankB->score) ? -1 : 1;
+
+  return strcmp(rankA->path, rankB->path);
+}
+
+/*! \fn static gdouble decay_score(const USAGE_LOG_SCORE *score, gint64 nTime)
+    \brief To get a score at another time. A time before its reference time(a clock set back) does not raise it.
+
+    \param[in] score.
+    \param[in] nTime. In seconds since the Epoch.
+    \return The score at the time.
+*/
+static gdouble decay_score(const USAGE_LOG_SCORE *score, gint64 nTime)
+{
+  return score->score * pow( 2.0, -(gdouble)MAX(nTime - score->time, 0) / USAGE_LOG_HALF_LIFE );
+}
+
+/*! \fn static gboolean is_valid_header(const USAGE_LOG_HEADER *header)
+    \brief To check if a header was written by this version.
+*/
+static gboolean is_valid_header(const USAGE_LOG_HEADER *header)
+{
+  return ( header->magic == USAGE_LOG_MAGIC && header->version == USAGE_LOG_VERSION && header->slots == USAGE_LOG_SLOTS &&
+           header->next < USAGE_LOG_SLOTS && header->count <= USAGE_LOG_SLOTS );
+}
+
+/*! \fn static off_t get_record_offset(guint32 slot)
+    \brief To get the offset of a record slot in the log file.
+*/
+static off_t get_record_offset(guint32 slot)
+{
+  return (off_t)sizeof(USAGE_LOG_HEADER) + (off_t)slot * sizeof(USAGE_LOG_RECORD);
+}
+
+//--------------- Class Methos Implementation.
+/*! \fn CUsageLog::CUsageLog()
+    \brief CUsageLog constructor
+*/
+CUsageLog::CUsageLog()
+{
+  m_nFd = -1;
+  m_nUnsynced = 0;
+  m_nSyncId = 0;
+  m_bWarnedLongPath = false;
+  m_Scores = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+}
+
+/*! \fn CUsageLog::~CUsageLog()
+    \brief CUsageLog destructor
+*/
+CUsageLog::~CUsageLog()
+{
+  m_Close();
+  g_hash_table_destroy(m_Scores);
+}
+
+/*! \fn gboolean CUsageLog::m_ReadHeader(USAGE_LOG_HEADER *header)
+    \brief To read the header of the log file. The file must be locked.
+
+    \param[out] header. An empty header if the file is empty or was written by another version.
+    \return TRUE if the file has a valid header.
+*/
+gboolean CUsageLog::m_ReadHeader(USAGE_LOG_HEADER *header)
+{
+  if( pread(m_nFd, header, sizeof(USAGE_LOG_HEADER), 0) == (ssize_t)sizeof(USAGE_LOG_HEADER) && is_valid_header(header) )
+    return true;
+
+  memset(header, 0, sizeof(USAGE_LOG_HEADER));
+  header->magic = USAGE_LOG_MAGIC;
+  header->version = USAGE_LOG_VERSION;
+  header->slots = USAGE_LOG_SLOTS;
+
+  return false;
+}
+
+/*! \fn gboolean CUsageLog::m_Open(void)
+    \brief To open the log file, creating it if it does not exist yet, and compute the scores of its records.
+
+    \param[in] NONE
+    \return TRUE or FALSE. On FALSE nothing is logged and every score is 0.
+*/
+gboolean CUsageLog::m_Open(void)
+{
+  USAGE_LOG_HEADER header;
+  USAGE_LOG_RECORD *records = NULL;
+  gchar *file_name = NULL, *dir = NULL;
+  gint64 now = (gint64)time(NULL);
+
+  if(m_nFd >= 0)
+    return true;
+
+  /* g_get_user_data_dir() honours $XDG_DATA_HOME. */
+  file_name = g_build_filename( g_get_user_data_dir(), USAGE_LOG_FILE_NAME, NULL );
+  dir = g_path_get_dirname(file_name);
+
+  if( g_mkdir_with_parents(dir, 0700) == 0 )
+    m_nFd = open(file_name, O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+
+  g_free(dir);
+  g_free(file_name);
+
+  if(m_nFd < 0)
+    return false;
+
+  /* A chooser appending meanwhile finishes first. */
+  flock(m_nFd, LOCK_SH);
+
+  if( m_ReadHeader(&header) && header.count > 0 )
+  {
+     records = g_new(USAGE_LOG_RECORD, header.count);
+
+     if( pread(m_nFd, records, header.count * sizeof(USAGE_LOG_RECORD), get_record_offset(0)) != (ssize_t)(header.count * sizeof(USAGE_LOG_RECORD)) )
+       header.count = 0;
+  }
+
+  flock(m_nFd, LOCK_UN);
+
+  for(guint32 n = 0; n < header.count; n++)
+  {
+     USAGE_LOG_RECORD *record = &records[n];
+
+     if( record->path_len == 0 || record->path_len > USAGE_LOG_MAX_PATH || record->path[record->path_len] != '\0' )
+       continue;
+
+     /* A clock set back makes no choice count more than a new one. */
+     m_AddChoice( record->path, MIN((gint64)record->time, now) );
+  }
+
+  g_free(records);
+
+  return true;
+}
+
+/*! \fn void CUsageLog::m_AddChoice(const gchar *desktopfile, gint64 nTime)
+    \brief To add a choice to the score of an application.
+
+    The score is decayed to the later of the choice time and its reference time, so the choices may come in any order.
+
+    \param[in] desktopfile. The desktop file path.
+    \param[in] nTime. The time of the choice in seconds since the Epoch.
+*/
+void CUsageLog::m_AddChoice(const gchar *desktopfile, gint64 nTime)
+{
+  USAGE_LOG_SCORE *score = (USAGE_LOG_SCORE*)g_hash_table_lookup(m_Scores, desktopfile);
+
+  if(!score)
+  {
+     score = g_new0(USAGE_LOG_SCORE, 1);
+     score->time = nTime;
+     g_hash_table_insert(m_Scores, g_strdup(desktopfile), score);
+  }
+
+  if(nTime >= score->time)
+  {
+     score->score = decay_score(score, nTime) + 1.0;
+     score->time = nTime;
+  }
+  else
+    score->score += pow( 2.0, -(gdouble)(score->time - nTime) / USAGE_LOG_HALF_LIFE );
+}
+
+/*! \fn void CUsageLog::m_Close(void)
+    \brief To flush the records not flushed yet and close the log file. The scores are forgotten.
+
+    \param[in] NONE
+    \return NONE
+*/
+void CUsageLog::m_Close(void)
+{
+  if(m_nFd < 0)
+    return;
+
+  m_Sync();
+  close(m_nFd);
+  m_nFd = -1;
+
+  g_hash_table_remove_all(m_Scores);
+}
+
+/*! \fn gboolean CUsageLog::m_Append(const gchar *desktopfile)
+    \brief To log a choice of an application over the oldest record once the log is full, and add it to its score.
+
+    The record and the header are written at once. They are flushed to the disk USAGE_LOG_SYNC_DELAY seconds later
+    together with the choices made meanwhile, so a crash loses only those and a choice is not worth a flush of its own.
+
+    \param[in] desktopfile. The desktop file path of the chosen application.
+    \return TRUE or FALSE
+*/
+gboolean CUsageLog::m_Append(const gchar *desktopfile)
+{
+  USAGE_LOG_HEADER header;
+  USAGE_LOG_RECORD record;
+  gsize length = desktopfile ? strlen(desktopfile) : 0;
+  gboolean bRet = false;
+
+  if( m_nFd < 0 || length == 0 )
+    return false;
+
+  if( G_UNLIKELY(length > USAGE_LOG_MAX_PATH) )
+  {
+     if(!m_bWarnedLongPath)
+       g_warning("The choices of %s are not logged, its path is longer than %d bytes.", desktopfile, USAGE_LOG_MAX_PATH);
+
+     m_bWarnedLongPath = true;
+     return false;
+  }
+
+  memset(&record, 0, sizeof(record));
+  record.time = (guint32)time(NULL);
+  record.path_len = (guint16)length;
+  memcpy(record.path, desktopfile, length);
+
+  /* Another chooser could have appended since m_Open(), its header is read again. */
+  flock(m_nFd, LOCK_EX);
+
+  m_ReadHeader(&header);
+
+  if( pwrite(m_nFd, &record, sizeof(record), get_record_offset(header.next)) == (ssize_t)sizeof(record) )
+  {
+     header.next = (header.next + 1) % USAGE_LOG_SLOTS;
+     header.count = MIN(header.count + 1, (guint32)USAGE_LOG_SLOTS);
+
+     bRet = ( pwrite(m_nFd, &header, sizeof(header), 0) == (ssize_t)sizeof(header) );
+  }
+
+  flock(m_nFd, LOCK_UN);
+
+  if(!bRet)
+    return false;
+
+  m_nUnsynced++;
+  m_AddChoice(desktopfile, (gint64)record.time);
+
+  if(!m_nSyncId)
+    m_nSyncId = g_timeout_add_seconds(USAGE_LOG_SYNC_DELAY, cb_sync_usage_log, this);
+
+  return true;
+}
+
+/*! \fn void CUsageLog::m_Sync(void)
+    \brief To flush the records written since the last flush to the disk.
+
+    \param[in] NONE
+    \return NONE
+*/
+void CUsageLog::m_Sync(void)
+{
+  if(m_nSyncId)
+    g_source_remove(m_nSyncId);
+
+  m_nSyncId = 0;
+
+  if(m_nFd < 0 || m_nUnsynced == 0)
+    return;
+
+  fdatasync(m_nFd);
+  m_nUnsynced = 0;
+}
+
+/*! \fn gboolean CUsageLog::m_SyncDelayed(void)
+    \brief To flush the records of the last USAGE_LOG_SYNC_DELAY seconds. It is called by the timeout of m_Append().
+
+    \param[in] NONE
+    \return FALSE, the timeout is removed.
+*/
+gboolean CUsageLog::m_SyncDelayed(void)
+{
+  /* The source is removed by returning FALSE. */
+  m_nSyncId = 0;
+  m_Sync();
+
+  return false;
+}
+
+/*! \fn gdouble CUsageLog::m_GetScore(const gchar *desktopfile)
+    \brief To get the frecency score of an application now.
+
+    \param[in] desktopfile. The desktop file path. It could be NULL.
+    \return The score, 0 if the application was never chosen.
+*/
+gdouble CUsageLog::m_GetScore(const gchar *desktopfile)
+{
+  USAGE_LOG_SCORE *score = desktopfile ? (USAGE_LOG_SCORE*)g_hash_table_lookup(m_Scores, desktopfile) : NULL;
+
+  return score ? decay_score(score, (gint64)time(NULL)) : 0.0;
+}
+
+/*! \fn GPtrArray* CUsageLog::m_GetTopEntries(guint max)
+    \brief To get the applications with the highest scores.
+
+    \param[in] max. The most applications returned.
+    \return The desktop file paths, the highest score first. The strings are owned by the log and valid until
+            m_Close(), the array is freed by the caller with g_ptr_array_free(array, TRUE).
+*/
+GPtrArray* CUsageLog::m_GetTopEntries(guint max)
+{
+  GArray *ranks = g_array_sized_new( FALSE, FALSE, sizeof(USAGE_LOG_RANK), g_hash_table_size(m_Scores) );
+  GPtrArray *entries = NULL;
+  GHashTableIter hashIter;
+  gpointer key = NULL, value = NULL;
+  gint64 now = (gint64)time(NULL);
+
+  g_hash_table_iter_init(&hashIter, m_Scores);
+
+  /* All scores are decayed to the same time before they are compared. */
+  while( g_hash_table_iter_next(&hashIter, &key, &value) )
+  {
+     USAGE_LOG_RANK rank;
+
+     rank.path = (const gchar*)key;
+     rank.score = decay_score( (USAGE_LOG_SCORE*)value, now );
+
+     if(rank.score >= USAGE_LOG_MIN_SCORE)
+       g_array_append_val(ranks, rank);
+  }
+
+  g_array_sort(ranks, cb_compare_ranks);
+
+  entries = g_ptr_array_sized_new( MIN(ranks->len, max) );
+
+  for(guint n = 0; n < ranks->len && n < max; n++)
+     g_ptr_array_add( entries, (gpointer)g_array_index(ranks, USAGE_LOG_RANK, n).path );
+
+  g_array_free(ranks, TRUE);
+
+  return entries;
+}
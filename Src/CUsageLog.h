@@ -0,0 +1,113 @@
+/*! \file    CUsageLog.h
+    \brief   Ring-bounded binary log of the chosen applications and their frecency scores.
+
+    \date    2026-10-17
+    \version 1.0
+
+    \b Change_History:
+    \n 1) 2026-10-17 initialized.
+*/
+
+#ifndef __CUSAGELOG_H
+#define __CUSAGELOG_H
+
+#include <glib.h>
+
+/*! \def USAGE_LOG_FILE_NAME
+    \brief The log file under $XDG_DATA_HOME. It is user data, not a cache, so it is not under $XDG_CACHE_HOME.
+*/
+#define USAGE_LOG_FILE_NAME  "DesktopAppChooser/usage-v1"
+
+/*! \def USAGE_LOG_MAGIC
+    \brief The magic number("DACU") at the beginning of the log file.
+*/
+#define USAGE_LOG_MAGIC    0x55434144
+#define USAGE_LOG_VERSION  1
+
+/*! \def USAGE_LOG_SLOTS
+    \brief The number of records kept, the oldest one is overwritten by the next choice.
+*/
+#define USAGE_LOG_SLOTS  256
+
+/*! \def USAGE_LOG_MAX_PATH
+    \brief The longest desktop file path logged, excluding the terminating NUL. A longer one is not logged, with a
+           warning the first time.
+*/
+#define USAGE_LOG_MAX_PATH  119
+
+/*! \def USAGE_LOG_SYNC_DELAY
+    \brief The seconds after a choice until it is flushed to the disk. The choices made meanwhile are flushed with it.
+*/
+#define USAGE_LOG_SYNC_DELAY  5
+
+/*! \def USAGE_LOG_HALF_LIFE
+    \brief The age in seconds at which a choice counts half in the frecency score.
+*/
+#define USAGE_LOG_HALF_LIFE  (7 * 24 * 3600)
+
+/*! \struct USAGE_LOG_HEADER
+    \brief The header of the log file, followed by USAGE_LOG_SLOTS records. Everything is in host byte order.
+*/
+typedef struct {
+  guint32 magic;
+  guint32 version;
+  guint32 slots;     /*!< The number of record slots, USAGE_LOG_SLOTS. */
+  guint32 next;      /*!< The slot written by the next choice. */
+  guint32 count;     /*!< The number of slots holding a record. */
+  guint32 reserved[3];
+} USAGE_LOG_HEADER;
+
+/*! \struct USAGE_LOG_RECORD
+    \brief A choice of an application.
+*/
+typedef struct {
+  guint32 time;      /*!< The wall-clock time of the choice in seconds since the Epoch. */
+  guint16 path_len;  /*!< The length of "path" without the terminating NUL. */
+  guint16 reserved;
+  gchar path[USAGE_LOG_MAX_PATH + 1];  /*!< The desktop file path, NUL terminated. */
+} USAGE_LOG_RECORD;
+
+/*! \struct USAGE_LOG_SCORE
+    \brief The frecency score of an application at a reference time. It is decayed to the current time when read.
+*/
+typedef struct {
+  gdouble score;
+  gint64 time;   /*!< The reference time of "score" in seconds since the Epoch. */
+} USAGE_LOG_SCORE;
+
+/*! \class CUsageLog
+    \brief Append the chosen applications to a fixed-size log file and rank them by frecency.
+
+    Every choice adds a score of 1 which halves every USAGE_LOG_HALF_LIFE seconds, so an application chosen
+    often and lately ranks first. A score is kept with the time it was computed for, m_Open() computes them from
+    the records, m_Append() decays one to the time of the choice before adding 1, and reading decays them to the
+    current time. The file is locked while it is read or written, so several choosers can share it.
+    The records are flushed to the disk USAGE_LOG_SYNC_DELAY seconds after a choice, or by m_Close() or m_Sync().
+    Everything runs in the GTK main thread.
+*/
+class CUsageLog
+{
+  private:
+    gint m_nFd;             /*!< -1 if the log is not open. */
+    guint m_nUnsynced;      /*!< The records written since the last flush. */
+    guint m_nSyncId;        /*!< The timeout source which flushes them, 0 if none. */
+    gboolean m_bWarnedLongPath;  /*!< To indicate if a desktop file path too long to log was reported. */
+    GHashTable *m_Scores;   /*!< Desktop file path -> USAGE_LOG_SCORE*. */
+
+    gboolean m_ReadHeader(USAGE_LOG_HEADER *header);
+    void m_AddChoice(const gchar *desktopfile, gint64 nTime);
+
+  public:
+    CUsageLog();
+    ~CUsageLog();
+
+    gboolean m_Open(void);
+    void m_Close(void);
+    gboolean m_Append(const gchar *desktopfile);
+    void m_Sync(void);
+    gboolean m_SyncDelayed(void);
+    gdouble m_GetScore(const gchar *desktopfile);
+    GPtrArray* m_GetTopEntries(guint max);
+    guint m_GetEntryCount(void) { return g_hash_table_size(m_Scores); }  /*!< To get the number of applications with a score. */
+};
+#endif /* __CUSAGELOG_H */
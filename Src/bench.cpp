@@ -0,0 +1,624 @@
+/*! \file bench.cpp
+    \brief To measure one load of the applications menu, run by run_bench.sh.
+
+    It creates the tree store like DesktopAppChooser does, waits until every row shows its own icon,
+    tears everything down and prints one tab separated line:
+    "init(ms)  icons(ms)  teardown(ms)  peak RSS(KB)  rows waiting at exit  reopen(ms)  leak(KB)".
+    With --shared the dialogs use the shared catalog, the teardown only detaches the first one and
+    "reopen" is the m_CreateInitValue() of a second dialog, otherwise it is 0.
+    With --leak-check=N the whole load, a reload and a rebuild of the rows and an update of the "Frequently used"
+    category are repeated N more times after the measured one, "leak" is the growth
+    of the heap per repetition and the exit status is 2 if it is over LEAK_CHECK_LIMIT_KB or if a chooser
+    still holds rows, records, icons or caches after its teardown, otherwise "leak" is 0.
+    With --scaler it checks the icon scaling kernels instead, see run_scaler_check().
+    With --signals=SIZES it times filling tree stores of synthetic rows instead, see run_signal_check().
+
+    \date 2026-10-17
+    \version 1.0
+
+    \b Change_History: 
+    \n 1) 2026-10-17 initial version. 
+*/
+
+#include <stdio.h>
+#include <malloc.h>
+#include <string.h>
+#include <math.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+#include "CDesktopAppChooser.h"
+
+/* Command-line options. */
+static gboolean bLazyLoad = FALSE;
+static gboolean bSyncIconLoad = FALSE;
+static gboolean bNoSvgDefer = FALSE;
+static gboolean bFlatList = FALSE;
+static gboolean bNoSnapshot = FALSE;
+static gboolean bSyncMenuLoad = FALSE;
+static gboolean bSharedCatalog = FALSE;
+static gboolean bScaler = FALSE;
+static gboolean bMemoryDump = FALSE;
+static gint nLeakCycles = 0;
+static gchar *pszSignalSizes = NULL;
+
+static GOptionEntry optionEntries[] =
+{
+  { "lazy", 0, 0, G_OPTION_ARG_NONE, &bLazyLoad, "Create a category's applications when it is expanded the first time", NULL },
+  { "flat", 0, 0, G_OPTION_ARG_NONE, &bFlatList, "Build the flat list model, which loads no icon until it is drawn", NULL },
+  { "no-snapshot", 0, 0, G_OPTION_ARG_NONE, &bNoSnapshot, "Parse the menu in every run instead of reading the menu snapshot", NULL },
+  { "sync", 0, 0, G_OPTION_ARG_NONE, &bSyncIconLoad, "Decode icons in m_CreateInitValue() instead of the worker threads", NULL },
+  { "no-svg-defer", 0, 0, G_OPTION_ARG_NONE, &bNoSvgDefer, "Rasterize scalable icons with the others instead of showing a preview first", NULL },
+  { "sync-menu", 0, 0, G_OPTION_ARG_NONE, &bSyncMenuLoad, "Parse the menu in m_CreateInitValue() instead of the menu loading thread", NULL },
+  { "shared", 0, 0, G_OPTION_ARG_NONE, &bSharedCatalog, "Use the shared catalog and time the opening of a second dialog", NULL },
+  { "memory", 0, 0, G_OPTION_ARG_NONE, &bMemoryDump, "Write the memory stats of the loaded chooser to stderr", NULL },
+  { "leak-check", 0, 0, G_OPTION_ARG_INT, &nLeakCycles, "Repeat the load N more times and check the heap does not grow", "N" },
+  { "scaler", 0, 0, G_OPTION_ARG_NONE, &bScaler, "Check and time the icon scaling kernels against GdkPixbuf instead", NULL },
+  { "signals", 0, 0, G_OPTION_ARG_STRING, &pszSignalSizes, "Count the row signals of filling tree stores of these sizes instead", "SIZES" },
+  { NULL, 0, 0, G_OPTION_ARG_NONE, NULL, NULL, NULL }
+};
+
+/*! \def LEAK_CHECK_LIMIT_KB
+    \brief The heap growth per load and teardown accepted by --leak-check.
+*/
+#define LEAK_CHECK_LIMIT_KB  16.0
+
+/*! \fn static gsize get_heap_in_use(void)
+    \brief To get the bytes of the heap in use, the allocator's free memory not included.
+
+    \return The bytes, 0 if the C library can not tell.
+*/
+static gsize get_heap_in_use(void)
+{
+#if defined(__GLIBC__) && ( __GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33) )
+  return mallinfo2().uordblks;
+#elif defined(__GLIBC__)
+  return (guint)mallinfo().uordblks;
+#else
+  return 0;
+#endif
+}
+
+/*! \fn static CDesktopAppChooser* new_chooser(gboolean shared)
+    \brief To create a chooser with the options of the command line.
+
+    \param[in] shared. To show the shared catalog.
+    \return The chooser, m_CreateInitValue() is not called yet.
+*/
+static CDesktopAppChooser* new_chooser(gboolean shared)
+{
+  CDesktopAppChooser *appChooser = new CDesktopAppChooser;
+
+  appChooser->m_SetSharedCatalog(shared);
+  appChooser->m_SetLazyLoad(bLazyLoad);
+  appChooser->m_SetAsyncIconLoad(!bSyncIconLoad);
+  appChooser->m_SetDeferScalableIcons(!bNoSvgDefer);
+  appChooser->m_SetFlatList(bFlatList);
+  appChooser->m_SetMenuSnapshot(!bNoSnapshot);
+  appChooser->m_SetAsyncMenuLoad(!bSyncMenuLoad);
+
+  return appChooser;
+}
+
+/*! \fn static void wait_for_menu(CDesktopAppChooser *appChooser)
+    \brief The menu is parsed by a thread and its categories are added by idle handlers.
+*/
+static void wait_for_menu(CDesktopAppChooser *appChooser)
+{
+  while( appChooser->m_IsMenuLoading() )
+    gtk_main_iteration();
+}
+
+/*! \fn static void wait_for_icons(CDesktopAppChooser *appChooser)
+    \brief The decoded icons are applied by idle handlers of the main loop.
+*/
+static void wait_for_icons(CDesktopAppChooser *appChooser)
+{
+  while( appChooser->m_GetPendingIconCount() > 0 )
+    gtk_main_iteration();
+}
+
+/*! \fn static gboolean is_released(CDesktopAppChooser *appChooser)
+    \brief To check that a chooser holds nothing of its load after m_DeinitValue() and m_ReleaseAppsMenuTree(). The icon resolver's
+           indexes are kept on purpose, they describe the installed files, not the menu.
+
+    \param[in] appChooser.
+    \return TRUE or FALSE. FALSE after writing its memory stats to stderr.
+*/
+static gboolean is_released(CDesktopAppChooser *appChooser)
+{
+  APPCHOOSER_MEMORY_STATS stats;
+
+  appChooser->m_GetMemoryStats(&stats);
+
+  if( stats.nRows == 0 && stats.arena.nBlocks == 0 && stats.arena.nStrings == 0 && stats.nIcons == 0 &&
+      stats.nIconFailures == 0 && stats.nPendingIcons == 0 && stats.nListIcons == 0 && stats.nIconFiles == 0 &&
+      stats.nSearchDocuments == 0 && stats.nExecTemplates == 0 && stats.nSnapshotBytes == 0 && stats.nMenuDirectories == 0 )
+    return TRUE;
+
+  fprintf(stderr, "The chooser still holds memory after its teardown:\n");
+  appChooser->m_DumpMemoryStats(stderr);
+
+  return FALSE;
+}
+
+/*! \fn static gchar* find_desktop_file(void)
+    \brief To find an installed desktop entry file to record in the usage log.
+
+    \return Newly allocated full path, or NULL.
+*/
+static gchar* find_desktop_file(void)
+{
+  const gchar * const *dataDirs = g_get_system_data_dirs();
+  gchar *desktopfile = NULL;
+
+  for(; *dataDirs && !desktopfile; dataDirs++)
+  {
+     gchar *path = g_build_filename(*dataDirs, "applications", NULL);
+     GDir *dir = g_dir_open(path, 0, NULL);
+     const gchar *name = NULL;
+
+     while( dir && !desktopfile && (name = g_dir_read_name(dir)) )
+     {
+        if( g_str_has_suffix(name, ".desktop") )
+          desktopfile = g_build_filename(path, name, NULL);
+     }
+
+     if(dir)
+       g_dir_close(dir);
+
+     g_free(path);
+  }
+
+  return desktopfile;
+}
+
+/*! \fn static void run_reload_cycle(CDesktopAppChooser *appChooser)
+    \brief To change the rows of a loaded chooser like a running one does: an in-place reload of the menu, a rebuild
+           of the tree store and a choice updating the "Frequently used" category.
+
+    \param[in] appChooser.
+*/
+static void run_reload_cycle(CDesktopAppChooser *appChooser)
+{
+  CAppCatalog *catalog = appChooser->m_GetCatalog();
+  GMenuTree *menuTree = NULL;
+  APP_ITEM_INFO appInfo;
+
+  memset(&appInfo, 0, sizeof(APP_ITEM_INFO));
+
+  /* Behind the rows of the snapshot the menu is still parsed to follow its changes. */
+  while( catalog->m_IsMenuParsing() )
+    gtk_main_iteration();
+
+  /* The first reload of rows built from the snapshot builds them from the parsed menu. */
+  menuTree = catalog->m_GetMenuTree();
+  catalog->m_ReloadAppsMenuTree();
+
+  if(!bFlatList)
+    catalog->m_RebuildAppsMenuTree( menuTree ? gmenu_tree_get_root_directory(menuTree) : NULL );
+
+  wait_for_icons(appChooser);
+
+  appInfo.desktopfile = find_desktop_file();
+
+  if(appInfo.desktopfile)
+  {
+     appChooser->m_RecordUsage(&appInfo);
+     catalog->m_UpdateFrequentCategory();
+     g_free(appInfo.desktopfile);
+  }
+
+  wait_for_icons(appChooser);
+}
+
+/*! \fn static gboolean run_leak_check(gdouble *leaked)
+    \brief To load, reload(see run_reload_cycle()) and tear down a chooser nLeakCycles times after a first warm-up
+           one, which fills the process-wide caches(icon theme, menu files), and compare the heap after the first
+           and the last.
+
+    \param[out] leaked. The heap growth per load in KB.
+    \return TRUE or FALSE. FALSE if the growth is over LEAK_CHECK_LIMIT_KB or a chooser was not released.
+*/
+static gboolean run_leak_check(gdouble *leaked)
+{
+  gsize heapStart = 0;
+  gboolean bRet = TRUE;
+
+  for(gint cycle = 0; cycle <= nLeakCycles; cycle++)
+  {
+     CDesktopAppChooser *appChooser = new_chooser(FALSE);
+
+     appChooser->m_CreateInitValue();
+     wait_for_menu(appChooser);
+     wait_for_icons(appChooser);
+
+     run_reload_cycle(appChooser);
+
+     appChooser->m_DeinitValue();
+     appChooser->m_ReleaseAppsMenuTree();
+     bRet = is_released(appChooser) && bRet;
+     delete appChooser;
+
+     while( gtk_events_pending() )
+       gtk_main_iteration();
+
+     if(cycle == 0)
+       heapStart = get_heap_in_use();
+  }
+
+  *leaked = ((gdouble)get_heap_in_use() - (gdouble)heapStart) / nLeakCycles / 1024.0;
+
+  return bRet && *leaked <= LEAK_CHECK_LIMIT_KB;
+}
+
+/*! \def SCALER_MIN_PSNR
+    \brief The lowest PSNR(dB) to GDK_INTERP_BILINEAR accepted by run_scaler_check().
+*/
+#define SCALER_MIN_PSNR  35.0
+#define SCALER_RUNS      200
+
+/*! \fn static GdkPixbuf* make_test_icon(int size)
+    \brief To draw an icon-like test image: color gradients and stripes in a disc with a soft transparent edge.
+
+    \param[in] size.
+    \return PixelBuffer object.
+*/
+static GdkPixbuf* make_test_icon(int size)
+{
+  GdkPixbuf *icon = gdk_pixbuf_new(GDK_COLORSPACE_RGB, TRUE, 8, size, size);
+  guchar *pixels = gdk_pixbuf_get_pixels(icon);
+  int rowstride = gdk_pixbuf_get_rowstride(icon);
+
+  for(int y = 0; y < size; y++)
+  {
+     for(int x = 0; x < size; x++)
+     {
+        guchar *p = pixels + y * rowstride + x * 4;
+        double dx = x - size / 2.0, dy = y - size / 2.0, r = sqrt(dx * dx + dy * dy) / (size / 2.0);
+
+        p[0] = (guchar)(127.5 + 127.5 * sin(x * 0.4));
+        p[1] = (guchar)(255 * y / size);
+        p[2] = (guchar)(((x / 3 + y / 3) % 2) ? 230 : 20);
+        p[3] = (r < 0.8) ? 255 : (r < 1.0) ? (guchar)(255 * (1.0 - r) / 0.2) : 0;
+     }
+  }
+
+  return icon;
+}
+
+/*! \fn static gboolean same_pixels(GdkPixbuf *a, GdkPixbuf *b)
+    \brief To check if two pixel buffers of the same size have bit-identical pixels.
+*/
+static gboolean same_pixels(GdkPixbuf *a, GdkPixbuf *b)
+{
+  int rowBytes = gdk_pixbuf_get_width(a) * gdk_pixbuf_get_n_channels(a);
+
+  for(int y = 0; y < gdk_pixbuf_get_height(a); y++)
+  {
+     if( memcmp( gdk_pixbuf_get_pixels(a) + y * gdk_pixbuf_get_rowstride(a),
+                 gdk_pixbuf_get_pixels(b) + y * gdk_pixbuf_get_rowstride(b), rowBytes ) != 0 )
+       return FALSE;
+  }
+
+  return TRUE;
+}
+
+/*! \fn static int run_scaler_check(void)
+    \brief To scale test icons by the ratios of the theme icons with every supported kernel and with
+           gdk_pixbuf_scale_simple(). Prints "ratio  kernel  time per icon(us)  PSNR(dB)  exact" per kernel,
+           "exact" telling if it matches the scalar kernel bit for bit.
+
+    \return 0, or 1 if a kernel is not bit-exact or too far from GDK_INTERP_BILINEAR.
+*/
+static int run_scaler_check(void)
+{
+  static const int ratios[][2] = { { 256, 48 }, { 128, 48 }, { 64, 48 }, { 48, 32 } };
+  int nRet = 0;
+
+  printf("%-10s %-8s %-12s %-10s %s\n", "Ratio", "Kernel", "Time(us)", "PSNR(dB)", "Exact");
+
+  for(guint i = 0; i < G_N_ELEMENTS(ratios); i++)
+  {
+     GdkPixbuf *src = make_test_icon(ratios[i][0]);
+     int size = ratios[i][1];
+     GdkPixbuf *reference = gdk_pixbuf_scale_simple(src, size, size, GDK_INTERP_BILINEAR);
+     GdkPixbuf *scalar = CIconScaler::m_ScaleDown(src, size, size, ICON_SCALER_SCALAR);
+     gchar *ratio = g_strdup_printf("%d->%d", ratios[i][0], size);
+     gint64 start = g_get_monotonic_time();
+
+     for(int n = 0; n < SCALER_RUNS; n++)
+       g_object_unref( gdk_pixbuf_scale_simple(src, size, size, GDK_INTERP_BILINEAR) );
+
+     printf("%-10s %-8s %-12.1f %-10s %s\n", ratio, "gdk", (g_get_monotonic_time() - start) / (double)SCALER_RUNS, "-", "-");
+
+     for(int kernel = ICON_SCALER_SCALAR; kernel <= ICON_SCALER_AVX2; kernel++)
+     {
+        GdkPixbuf *scaled = NULL;
+        gdouble psnr = 0.0;
+        gboolean bExact = FALSE;
+
+        if( !CIconScaler::m_IsKernelSupported((ICON_SCALER_KERNEL)kernel) )
+          continue;
+
+        start = g_get_monotonic_time();
+
+        for(int n = 0; n < SCALER_RUNS; n++)
+          g_object_unref( CIconScaler::m_ScaleDown(src, size, size, (ICON_SCALER_KERNEL)kernel) );
+
+        scaled = CIconScaler::m_ScaleDown(src, size, size, (ICON_SCALER_KERNEL)kernel);
+        psnr = CIconScaler::m_ComputePSNR(scaled, reference);
+        bExact = same_pixels(scaled, scalar);
+
+        printf("%-10s %-8s %-12.1f %-10.2f %s\n", ratio, CIconScaler::m_GetKernelName((ICON_SCALER_KERNEL)kernel),
+               (g_get_monotonic_time() - start) / (double)SCALER_RUNS, psnr, bExact ? "yes" : "NO");
+
+        if( !bExact || psnr < SCALER_MIN_PSNR )
+          nRet = 1;
+
+        g_object_unref(scaled);
+     }
+
+     g_free(ratio);
+     g_object_unref(scalar);
+     g_object_unref(reference);
+     g_object_unref(src);
+  }
+
+  return nRet;
+}
+
+/*! \def SIGNAL_APPS_PER_CATEGORY
+    \brief The applications under every category row of the synthetic stores of run_signal_check().
+*/
+#define SIGNAL_APPS_PER_CATEGORY  20
+
+/*! \enum SIGNAL_BUILD_MODE
+    \brief The ways run_signal_check() fills a tree store shown by a tree view.
+*/
+typedef enum
+{
+  SIGNAL_BUILD_APPEND_SET = 0,  /*!< gtk_tree_store_append() then gtk_tree_store_set(), the store shown. */
+  SIGNAL_BUILD_INSERT,          /*!< gtk_tree_store_insert_with_values(), the store shown. */
+  SIGNAL_BUILD_SORTED,          /*!< gtk_tree_store_insert_with_values() into a sorted store, the store shown. */
+  SIGNAL_BUILD_DETACHED,        /*!< gtk_tree_store_insert_with_values(), sorted once, then shown. */
+  N_SIGNAL_BUILD_MODES
+} SIGNAL_BUILD_MODE;
+
+static const gchar *signalBuildModeNames[N_SIGNAL_BUILD_MODES] = { "append+set", "insert", "sorted", "detached" };
+
+/*! \fn static void cb_count_signal(guint *count)
+    \brief Connected swapped to the row signals, whatever their parameters are.
+*/
+static void cb_count_signal(guint *count)
+{
+  (*count)++;
+}
+
+/*! \fn static void connect_row_signals(GtkTreeModel *model, guint *count)
+    \brief To count the row signals a model emits.
+*/
+static void connect_row_signals(GtkTreeModel *model, guint *count)
+{
+  static const gchar *signals[] = { "row-inserted", "row-changed", "row-has-child-toggled", "rows-reordered" };
+
+  for(guint i = 0; i < G_N_ELEMENTS(signals); i++)
+    g_signal_connect_swapped(model, signals[i], G_CALLBACK(cb_count_signal), count);
+}
+
+/*! \fn static void show_store(GtkWidget *view, GtkTreeStore *store, guint *seen)
+    \brief To show a store in a tree view through a filter model, like CDesktopAppChooser::m_CreateAndFillModel().
+
+    \param[in] view.
+    \param[in] store.
+    \param[out] seen. Counts the row signals of the filter model, which the tree view handles.
+*/
+static void show_store(GtkWidget *view, GtkTreeStore *store, guint *seen)
+{
+  GtkTreeModel *filter = gtk_tree_model_filter_new(GTK_TREE_MODEL(store), NULL);
+
+  connect_row_signals(filter, seen);
+  gtk_tree_view_set_model(GTK_TREE_VIEW(view), filter);
+  g_object_unref(filter);
+}
+
+/*! \fn static void fill_store(GtkTreeStore *store, GPtrArray *names, gboolean append_set)
+    \brief To add the synthetic rows: a category row before every SIGNAL_APPS_PER_CATEGORY application rows.
+
+    \param[in] store.
+    \param[in] names. The names of the rows, categories included.
+    \param[in] append_set. To add a row with gtk_tree_store_append() and gtk_tree_store_set() instead of
+                gtk_tree_store_insert_with_values().
+*/
+static void fill_store(GtkTreeStore *store, GPtrArray *names, gboolean append_set)
+{
+  GtkTreeIter category, iter;
+
+  for(guint i = 0; i < names->len; i++)
+  {
+     gboolean bCategory = (i % (SIGNAL_APPS_PER_CATEGORY + 1) == 0);
+     /* Any non-NULL node-data marks an application row. */
+     gpointer nodeData = bCategory ? NULL : names;
+
+     if(append_set)
+     {
+        gtk_tree_store_append(store, &iter, bCategory ? NULL : &category);
+        gtk_tree_store_set(store, &iter, APP_LIST_COLUMN_TEXT, g_ptr_array_index(names, i),
+                           APP_LIST_COLUMN_NODEDATA, nodeData, -1);
+     }
+     else
+     {
+        gtk_tree_store_insert_with_values(store, &iter, bCategory ? NULL : &category, -1,
+                                          APP_LIST_COLUMN_TEXT, g_ptr_array_index(names, i),
+                                          APP_LIST_COLUMN_NODEDATA, nodeData, -1);
+     }
+
+     if(bCategory)
+       category = iter;
+  }
+}
+
+/*! \fn static int run_signal_check(const gchar *sizes)
+    \brief To fill tree stores of synthetic rows shown by a tree view in every SIGNAL_BUILD_MODE.
+           Prints "rows  mode  signals emitted by the store  signals seen by the view  time(ms)" per mode,
+           the time including the main loop iterations the tree view needs afterwards.
+
+    \param[in] sizes. The numbers of rows separated by spaces or commas.
+    \return 0, or 1 if no size is given.
+*/
+static int run_signal_check(const gchar *sizes)
+{
+  gchar **sizeList = g_strsplit_set(sizes, " ,", -1);
+  GtkWidget *window = gtk_window_new(GTK_WINDOW_TOPLEVEL);
+  GtkWidget *scrolled = gtk_scrolled_window_new(NULL, NULL);
+  int nRet = 1;
+
+  gtk_window_set_default_size(GTK_WINDOW(window), 300, 400);
+  gtk_container_add(GTK_CONTAINER(window), scrolled);
+  gtk_widget_show_all(window);
+
+  printf("%-8s %-12s %-10s %-10s %s\n", "Rows", "Mode", "Emitted", "Seen", "Time(ms)");
+
+  for(gchar **size = sizeList; *size; size++)
+  {
+     guint nRows = (guint)g_ascii_strtoull(*size, NULL, 10);
+     GPtrArray *names = NULL;
+
+     if(nRows == 0)
+       continue;
+
+     /* The names are made before the timing, in an order the sorting has to change. */
+     names = g_ptr_array_new_with_free_func(g_free);
+
+     for(guint i = 0; i < nRows; i++)
+     {
+        guint n = (guint)(((guint64)i * 7919) % nRows);
+
+        if(i % (SIGNAL_APPS_PER_CATEGORY + 1) == 0)
+          g_ptr_array_add( names, g_strdup_printf("Category %u", n) );
+        else
+          g_ptr_array_add( names, g_strdup_printf("Application %u", n) );
+     }
+
+     for(int mode = 0; mode < N_SIGNAL_BUILD_MODES; mode++)
+     {
+        GtkTreeStore *store = gtk_tree_store_new(APP_LIST_N_COLUMNS, GDK_TYPE_PIXBUF, G_TYPE_STRING, G_TYPE_POINTER, G_TYPE_POINTER);
+        GtkWidget *view = gtk_tree_view_new();
+        guint nEmitted = 0, nSeen = 0;
+        gint64 start = 0;
+
+        gtk_tree_view_insert_column_with_attributes(GTK_TREE_VIEW(view), -1, NULL, gtk_cell_renderer_text_new(),
+                                                    "text", APP_LIST_COLUMN_TEXT, NULL);
+        gtk_container_add(GTK_CONTAINER(scrolled), view);
+        gtk_widget_show(view);
+        connect_row_signals(GTK_TREE_MODEL(store), &nEmitted);
+
+        start = g_get_monotonic_time();
+
+        if(mode == SIGNAL_BUILD_SORTED)
+          gtk_tree_sortable_set_sort_column_id(GTK_TREE_SORTABLE(store), APP_LIST_COLUMN_TEXT, GTK_SORT_ASCENDING);
+
+        if(mode != SIGNAL_BUILD_DETACHED)
+          show_store(view, store, &nSeen);
+
+        fill_store(store, names, mode == SIGNAL_BUILD_APPEND_SET);
+
+        if(mode == SIGNAL_BUILD_DETACHED)
+        {
+           gtk_tree_sortable_set_sort_column_id(GTK_TREE_SORTABLE(store), APP_LIST_COLUMN_TEXT, GTK_SORT_ASCENDING);
+           show_store(view, store, &nSeen);
+        }
+
+        while( gtk_events_pending() )
+          gtk_main_iteration();
+
+        printf("%-8u %-12s %-10u %-10u %.3f\n", nRows, signalBuildModeNames[mode], nEmitted, nSeen,
+               (g_get_monotonic_time() - start) / 1000.0);
+
+        gtk_widget_destroy(view);
+        g_object_unref(store);
+        nRet = 0;
+     }
+
+     g_ptr_array_free(names, TRUE);
+  }
+
+  gtk_widget_destroy(window);
+  g_strfreev(sizeList);
+
+  return nRet;
+}
+
+int main(int argc, char* argv[])
+{
+  CDesktopAppChooser *appChooser = NULL;
+  GError *error = NULL;
+  struct rusage usage;
+  gint64 start = 0, initDone = 0, iconsDone = 0, teardownDone = 0, reopenStart = 0, reopenDone = 0;
+  guint nWaiting = 0;
+  gdouble leaked = 0.0;
+  gboolean bReleased = TRUE;
+
+  /* The icon theme needs a display, run it under xvfb-run on a headless machine. */
+  if( !gtk_init_with_args(&argc, &argv, NULL, optionEntries, NULL, &error) )
+  {
+     fprintf(stderr, "%s\n", error ? error->message : "Can not open the display.");
+     g_clear_error(&error);
+     return 1;
+  }
+
+  if(bScaler)
+    return run_scaler_check();
+
+  if(pszSignalSizes)
+    return run_signal_check(pszSignalSizes);
+
+  /* Like a host application keeping the catalog for its whole session. */
+  if(bSharedCatalog)
+    CDesktopAppChooser::m_RefSharedCatalog();
+
+  appChooser = new_chooser(bSharedCatalog);
+
+  start = g_get_monotonic_time();
+  appChooser->m_CreateInitValue();
+  wait_for_menu(appChooser);
+  initDone = g_get_monotonic_time();
+  wait_for_icons(appChooser);
+  iconsDone = g_get_monotonic_time();
+
+  if(bMemoryDump)
+    appChooser->m_DumpMemoryStats(stderr);
+
+  appChooser->m_DeinitValue();
+  appChooser->m_ReleaseAppsMenuTree();
+  nWaiting = appChooser->m_GetPendingIconCount();
+  delete appChooser;
+  teardownDone = g_get_monotonic_time();
+
+  /* The second dialog shows the rows and icons the first one has loaded. */
+  if(bSharedCatalog)
+  {
+     reopenStart = g_get_monotonic_time();
+     appChooser = new CDesktopAppChooser;
+     appChooser->m_SetSharedCatalog(TRUE);
+     appChooser->m_CreateInitValue();
+     wait_for_menu(appChooser);
+     reopenDone = g_get_monotonic_time();
+
+     appChooser->m_DeinitValue();
+     delete appChooser;
+     CDesktopAppChooser::m_UnrefSharedCatalog();
+  }
+
+  /* ru_maxrss is in kilobytes on Linux, taken before the repeated loads. */
+  getrusage(RUSAGE_SELF, &usage);
+
+  if(nLeakCycles > 0)
+    bReleased = run_leak_check(&leaked) && bReleased;
+
+  printf("%.3f\t%.3f\t%.3f\t%ld\t%u\t%.3f\t%.1f\n",
+         (initDone - start) / 1000.0, (iconsDone - initDone) / 1000.0, (teardownDone - iconsDone) / 1000.0,
+         usage.ru_maxrss, nWaiting, (reopenDone - reopenStart) / 1000.0, leaked);
+
+  return bReleased ? 0 : 2;
+}
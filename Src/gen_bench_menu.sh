@@ -0,0 +1,108 @@
+#!/bin/sh
+# Generate a synthetic XDG menu tree for the benchmark.
+#
+# Usage: gen_bench_menu.sh <directory> <number of applications>
+#
+# <directory>/config/menus/applications.menu has 10 categories, each with a nested sub-menu.
+# <directory>/data holds the .desktop, .directory and icon files. The icons are a mix of
+# hicolor PNG, hicolor scalable SVG, pixmaps XPM named with the extension, absolute PNG paths
+# and names which have no icon at all.
+
+DIR=$1
+COUNT=$2
+PNG=`dirname $0`/img/none.png
+CATEGORIES=10
+
+if [ -z "$DIR" ] || [ -z "$COUNT" ]; then
+  echo "Usage: $0 <directory> <number of applications>"
+  exit 1
+fi
+
+rm -rf "$DIR"
+mkdir -p "$DIR/config/menus" "$DIR/data/applications" "$DIR/data/desktop-directories" \
+         "$DIR/data/icons/hicolor/48x48/apps" "$DIR/data/icons/hicolor/scalable/apps" \
+         "$DIR/data/pixmaps" "$DIR/data/absolute" "$DIR/home-config" "$DIR/home-data" "$DIR/cache"
+
+cat > "$DIR/data/icons/hicolor/index.theme" <<THEME
+[Icon Theme]
+Name=Hicolor
+Comment=Fallback icon theme
+Directories=48x48/apps,scalable/apps
+
+[48x48/apps]
+Size=48
+Type=Fixed
+
+[scalable/apps]
+Size=48
+MinSize=1
+MaxSize=256
+Type=Scalable
+THEME
+
+#------------- The menu file and the categories.
+{
+  echo '<!DOCTYPE Menu PUBLIC "-//freedesktop//DTD Menu 1.0//EN" "http://www.freedesktop.org/standards/menu-spec/1.0/menu.dtd">'
+  echo '<Menu>'
+  echo '  <Name>Applications</Name>'
+  echo '  <Directory>bench.directory</Directory>'
+  echo '  <DefaultAppDirs/>'
+  echo '  <DefaultDirectoryDirs/>'
+
+  c=0
+  while [ $c -lt $CATEGORIES ]; do
+    echo "  <Menu>"
+    echo "    <Name>Bench$c</Name>"
+    echo "    <Directory>bench$c.directory</Directory>"
+    echo "    <Include><And><Category>Bench$c</Category><Not><Category>BenchSub</Category></Not></And></Include>"
+    echo "    <Menu>"
+    echo "      <Name>Bench$c Sub</Name>"
+    echo "      <Directory>bench$c-sub.directory</Directory>"
+    echo "      <Include><And><Category>Bench$c</Category><Category>BenchSub</Category></And></Include>"
+    echo "    </Menu>"
+    echo "  </Menu>"
+    c=`expr $c + 1`
+  done
+
+  echo '</Menu>'
+} > "$DIR/config/menus/applications.menu"
+
+printf '[Desktop Entry]\nType=Directory\nName=Bench\n' > "$DIR/data/desktop-directories/bench.directory"
+
+c=0
+while [ $c -lt $CATEGORIES ]; do
+  printf '[Desktop Entry]\nType=Directory\nName=Category %s\nIcon=bench-category-%s\n' $c $c > "$DIR/data/desktop-directories/bench$c.directory"
+  printf '[Desktop Entry]\nType=Directory\nName=Category %s Sub\nIcon=bench-category-%s\n' $c $c > "$DIR/data/desktop-directories/bench$c-sub.directory"
+  cp "$PNG" "$DIR/data/icons/hicolor/48x48/apps/bench-category-$c.png"
+  c=`expr $c + 1`
+done
+
+#------------- The applications and their icons.
+i=0
+while [ $i -lt $COUNT ]; do
+  CATEGORY="Bench`expr $i % $CATEGORIES`;"
+
+  # Every fourth application is in the nested sub-menu.
+  if [ `expr $i % 4` -eq 3 ]; then
+    CATEGORY="${CATEGORY}BenchSub;"
+  fi
+
+  case `expr $i % 5` in
+    0) ICON=bench-app-$i
+       cp "$PNG" "$DIR/data/icons/hicolor/48x48/apps/$ICON.png" ;;
+    1) ICON=bench-app-$i
+       printf '<svg xmlns="http://www.w3.org/2000/svg" width="48" height="48"><rect width="48" height="48" fill="#%06x"/></svg>\n' $i \
+         > "$DIR/data/icons/hicolor/scalable/apps/$ICON.svg" ;;
+    2) ICON=bench-app-$i.xpm
+       printf '/* XPM */\nstatic char *bench_xpm[] = {\n"2 2 1 1",\n"  c #336699",\n"  ",\n"  "};\n' \
+         > "$DIR/data/pixmaps/$ICON" ;;
+    3) ICON=bench-missing-$i ;;
+    4) ICON=`cd "$DIR/data/absolute" && pwd`/bench-app-$i.png
+       cp "$PNG" "$ICON" ;;
+  esac
+
+  printf '[Desktop Entry]\nType=Application\nName=Bench Application %s\nComment=Synthetic application number %s\nExec=bench-app-%s %%U\nIcon=%s\nCategories=%s\n' \
+    $i $i $i "$ICON" "$CATEGORY" > "$DIR/data/applications/bench-app-$i.desktop"
+
+  i=`expr $i + 1`
+done
@@ -12,7 +12,10 @@
 #include <stdio.h>
 #include <glib/gi18n.h>   // For GNU gettext i18n, multi-language
 #include <locale.h>  // For setlocale() function.
+#include <signal.h>
+#include <glib-unix.h>
 
+#include "CCatalogDaemon.h"
 #include "CDesktopAppChooser.h"
 
 //#define TEST
@@ -22,15 +25,84 @@
 #define PACKAGE   "DesktopAppChooser"
 #define LOCALEDIR "./locale"
 
+/* Command-line options. */
+static gboolean bLazyLoad = FALSE;
+static gboolean bFlatList = FALSE;
+static gboolean bSortByName = FALSE;
+static gboolean bNoUsageLog = FALSE;
+static gboolean bNoSnapshot = FALSE;
+static gboolean bDaemon = FALSE;
+static gboolean bUseDaemon = FALSE;
+static gboolean bLaunch = FALSE;
+static gchar *pszBatchFormat = NULL;
+
+static GOptionEntry optionEntries[] =
+{
+  { "lazy", 0, 0, G_OPTION_ARG_NONE, &bLazyLoad, "Create a category's applications when it is expanded the first time", NULL },
+  { "flat", 0, 0, G_OPTION_ARG_NONE, &bFlatList, "Show the applications as one list, loading only the icons on screen", NULL },
+  { "sort", 0, 0, G_OPTION_ARG_NONE, &bSortByName, "Sort the categories and applications by name instead of the menu order", NULL },
+  { "no-usage-log", 0, 0, G_OPTION_ARG_NONE, &bNoUsageLog, "Neither log the chosen application nor show the frequently used ones", NULL },
+  { "no-snapshot", 0, 0, G_OPTION_ARG_NONE, &bNoSnapshot, "Parse the applications menu even if the snapshot of the last parse is fresh", NULL },
+  { "daemon", 0, 0, G_OPTION_ARG_NONE, &bDaemon, "Keep the applications and their icons loaded for the other choosers until SIGTERM", NULL },
+  { "use-daemon", 0, 0, G_OPTION_ARG_NONE, &bUseDaemon, "Show the applications of the running daemon, if there is one", NULL },
+  { "launch", 0, 0, G_OPTION_ARG_NONE, &bLaunch, "Run the chosen application with the files given on the command line", NULL },
+  { "batch", 0, 0, G_OPTION_ARG_STRING, &pszBatchFormat, "Write the applications to stdout without opening a display", "json|tsv" },
+  { NULL, 0, 0, G_OPTION_ARG_NONE, NULL, NULL, NULL }
+};
+
+/*! \fn static gboolean cb_dump_memory_stats(gpointer data)
+    \brief The callback function of SIGUSR1: "kill -USR1 <pid>" writes what the chooser holds to stderr.
+
+    \param[in] data. The instance of class CDesktopAppChooser.
+    \return TRUE to keep the signal source.
+*/
+static gboolean cb_dump_memory_stats(gpointer data)
+{
+  ((CDesktopAppChooser*)data)->m_DumpMemoryStats(stderr);
+
+  return TRUE;
+}
+
 int main(int argc, char* argv[])
 {
   CDesktopAppChooser appChooser;
+  GOptionContext *optionContext = NULL;
 
   /* For GNU gettext i18n, multi-language */
   setlocale(LC_ALL, "");    // Clear out LC_ALL environment variable.
   bindtextdomain(PACKAGE, LOCALEDIR);
   textdomain(PACKAGE);
 
+  /* The options are parsed before gtk_init(), so the batch mode never opens a display.
+     Unknown options are left for gtk_init(). */
+  optionContext = g_option_context_new(NULL);
+  g_option_context_add_main_entries(optionContext, optionEntries, NULL);
+  g_option_context_set_ignore_unknown_options(optionContext, TRUE);
+
+  if( !g_option_context_parse(optionContext, &argc, &argv, NULL) )
+  {
+     g_option_context_free(optionContext);
+     return 1;
+  }
+
+  g_option_context_free(optionContext);
+
+  /* Batch mode: only the menu data is wanted, no widget and no icon. */
+  if(pszBatchFormat)
+  {
+     APPCHOOSER_DUMP_FORMAT format = APPCHOOSER_DUMP_JSONL;
+
+     if( g_ascii_strcasecmp(pszBatchFormat, "tsv") == 0 )
+       format = APPCHOOSER_DUMP_TSV;
+     else if( g_ascii_strcasecmp(pszBatchFormat, "json") != 0 )
+     {
+        fprintf(stderr, "Unknown batch format \"%s\", use \"json\" or \"tsv\".\n", pszBatchFormat);
+        return 1;
+     }
+
+     return (appChooser.m_GetCatalog()->m_DumpAppsMenu(stdout, format) < 0)? 1 : 0;
+  }
+
   /* First of all, call gtk_init() to initialize GTK type system.
 
      If you do not call this first of all GTK codes,
@@ -39,15 +111,38 @@ int main(int argc, char* argv[])
   */
   gtk_init (&argc, &argv);
 
+  if(bDaemon)
+  {
+     CCatalogDaemon catalogDaemon;
+
+     return catalogDaemon.m_Run();
+  }
+
+  appChooser.m_SetLazyLoad(bLazyLoad);
+  appChooser.m_SetFlatList(bFlatList);
+  appChooser.m_SetSortByName(bSortByName);
+  appChooser.m_SetUsageLog(!bNoUsageLog);
+  appChooser.m_SetMenuSnapshot(!bNoSnapshot);
+  appChooser.m_SetCatalogDaemon(bUseDaemon);
+
   printf("Initialize data model \n");
   appChooser.m_CreateInitValue();  
 
   printf("Prepare UI layout \n");
   appChooser.m_InitLayoutUI(NULL, 700, 400);  // No top level parent window, so the first parameter is set to NULL.
 
+  g_unix_signal_add(SIGUSR1, cb_dump_memory_stats, &appChooser);
+
   printf("Start to show dialog \n");
   if( appChooser.m_DoModal() )
     printf("X Desktop App Chooser dialog terminated!\n\n");
+
+  {
+     guint nDecodes = 0, nSaved = 0;
+
+     appChooser.m_GetIconInternStats(nDecodes, nSaved);
+     printf("Icons loaded : %u, loads saved by sharing : %u\n\n", nDecodes, nSaved);
+  }
 		
   /* To set Name, Exec and Comment fields of the dialog. */
   if(appChooser.m_GetIsChosen())
@@ -60,6 +155,25 @@ int main(int argc, char* argv[])
      printf("APP Comment : %s\n", (char*)appChooser.m_GetSelectedAppItem_Comment() );
 
      printf("\n");
+
+     /* The arguments left by the option parsers are the files to open. */
+     if(bLaunch)
+     {
+        GError *error = NULL;
+        gint64 nClickToExec = 0, nSpawn = 0;
+
+        if( appChooser.m_LaunchSelectedApp((const gchar* const*)&argv[1], &error) )
+        {
+           appChooser.m_GetLaunchLatency(nClickToExec, nSpawn);
+           printf("Launched : %.3f ms from the click to exec, %.3f ms to spawn\n\n", nClickToExec / 1000.0, nSpawn / 1000.0);
+        }
+        else
+        {
+           fprintf(stderr, "Failed to launch the application : %s\n", error->message);
+           g_error_free(error);
+           return 1;
+        }
+     }
   }
 
   return 0;
@@ -0,0 +1,52 @@
+#!/bin/sh
+# Run DesktopAppChooserBench over synthetic menu trees, see "make bench".
+#
+# Usage: run_bench.sh "<sizes>" <runs> [bench options, e.g. --lazy, --sync, --shared or --leak-check=5]
+#
+# Every run is a new process, so the peak RSS is the one of a single load. "cold" runs start with
+# an empty icon cache and no menu snapshot, "warm" runs reuse the ones of the previous run.
+# Each column shows the minimum / median / maximum of the runs.
+
+SIZES=${1:-"100 1000 10000"}
+RUNS=${2:-5}
+shift 2 2>/dev/null
+BENCH=./DesktopAppChooserBench
+WORKDIR=${BENCH_DIR:-/tmp/DesktopAppChooserBench}
+
+# Print "min / median / max" of the numbers on stdin.
+summarize()
+{
+  sort -n | awk '{ v[NR] = $1 } END { printf "%.1f / %.1f / %.1f", v[1], v[int((NR + 1) / 2)], v[NR] }'
+}
+
+printf '%-8s %-5s %-30s %-30s %-30s %-30s %-30s %-30s\n' "Entries" "Cache" "Init(ms)" "Icons(ms)" "Teardown(ms)" "Peak RSS(KB)" "Reopen(ms)" "Leak(KB)"
+
+for SIZE in $SIZES; do
+  DIR=$WORKDIR/$SIZE
+  sh `dirname $0`/gen_bench_menu.sh "$DIR" $SIZE || exit 1
+
+  for CACHE in cold warm; do
+    RESULTS=$DIR/results-$CACHE
+    : > "$RESULTS"
+
+    run=0
+    while [ $run -lt $RUNS ]; do
+      if [ $CACHE = cold ]; then
+        rm -rf "$DIR/cache"
+        mkdir -p "$DIR/cache"
+      fi
+
+      env -u XDG_MENU_PREFIX \
+          XDG_CONFIG_DIRS="$DIR/config" XDG_DATA_DIRS="$DIR/data" \
+          XDG_CONFIG_HOME="$DIR/home-config" XDG_DATA_HOME="$DIR/home-data" XDG_CACHE_HOME="$DIR/cache" \
+          $BENCH "$@" >> "$RESULTS" || exit 1
+
+      run=`expr $run + 1`
+    done
+
+    printf '%-8s %-5s %-30s %-30s %-30s %-30s %-30s %-30s\n' $SIZE $CACHE \
+      "`cut -f1 "$RESULTS" | summarize`" "`cut -f2 "$RESULTS" | summarize`" \
+      "`cut -f3 "$RESULTS" | summarize`" "`cut -f4 "$RESULTS" | summarize`" \
+      "`cut -f6 "$RESULTS" | summarize`" "`cut -f7 "$RESULTS" | summarize`"
+  done
+done